@@ -2241,13 +2241,26 @@ void MacroAssembler::fast_unlock(Register objReg, Register boxReg, Register tmpR
 
       // box is really RAX -- the following CMPXCHG depends on that binding
       // cmpxchg R,[M] is equivalent to rax = CAS(M,rax,R)
+      Label LReacquire;
+      bind  (LReacquire);
       if (os::is_MP()) { lock(); }
       cmpxchgptr(r15_thread, Address(tmpReg, OM_OFFSET_NO_MONITOR_VALUE_TAG(owner)));
       // There's no successor so we tried to regrab the lock.
-      // If that didn't work, then another thread grabbed the
-      // lock so we're done (and exit was a success).
-      jccb  (Assembler::notEqual, LSuccess);
-      // Intentional fall-through into slow-path
+      // If that worked, pass control into the slow path.
+      jccb  (Assembler::equal, LGoSlowPath);
+      if (AsyncDeflateIdleMonitors) {
+        // The monitor deflation thread holds the lock only transiently and
+        // backs out because threads are queued; it does not take over
+        // succession, so wait for it and retry.
+        cmpptr(boxReg, (int32_t)(intptr_t)DEFLATER_MARKER);
+        jccb  (Assembler::notEqual, LSuccess);
+        pause();
+        xorptr(boxReg, boxReg);
+        jmpb  (LReacquire);
+      } else {
+        // Another thread grabbed the lock so we're done (and exit was a success).
+        jmpb  (LSuccess);
+      }
 
       bind  (LGoSlowPath);
       orl   (boxReg, 1);                      // set ICC.ZF=0 to indicate failure
@@ -37,6 +37,7 @@
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/compiledICHolder.hpp"
+#include "runtime/nativeCallStatistics.hpp"
 #include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/vframeArray.hpp"
@@ -1886,6 +1887,13 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
   }
   assert(native_func != NULL, "must have function");
 
+  // A leaf native is called without leaving _thread_in_Java
+  bool is_leaf_native = !is_critical_native && SharedRuntime::is_leaf_native(method);
+  NativeCallCounters* call_counters = NULL;
+  if (JNICallStatistics) {
+    call_counters = NativeCallStatistics::counters_for(method, is_leaf_native);
+  }
+
   // An OopMap for lock (and class if static)
   OopMapSet *oop_maps = new OopMapSet();
   intptr_t start = (intptr_t)__ pc();
@@ -2456,8 +2464,14 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     __ lea(c_rarg0, Address(r15_thread, in_bytes(JavaThread::jni_environment_offset())));
   }
 
+  if (call_counters != NULL) {
+    __ incrementq(ExternalAddress(call_counters->calls_addr()));
+  }
+
   // Now set thread in native
-  __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  if (!is_leaf_native) {
+    __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  }
 
   __ call(RuntimeAddress(native_func));
 
@@ -2499,6 +2513,23 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     }
   }
 #endif
+
+  Label after_transition;
+  if (is_leaf_native) {
+    // The thread never left _thread_in_Java, unless the native called back
+    // through its JNIEnv. Fail fast then rather than run Java code in
+    // _thread_in_native.
+    __ cmpl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_Java);
+    __ jcc(Assembler::equal, after_transition);
+    __ vzeroupper();
+    __ mov(c_rarg0, r15_thread);
+    __ mov_metadata(c_rarg1, method());
+    __ subptr(rsp, frame::arg_reg_save_area_bytes); // windows
+    __ andptr(rsp, -16); // align stack as required by ABI
+    __ call(RuntimeAddress(CAST_FROM_FN_PTR(address, SharedRuntime::leaf_native_state_error)));
+    __ hlt();
+  }
+
   // Switch thread to "native transition" state before reading the synchronization state.
   // This additional state is necessary because reading and testing the synchronization
   // state is not atomic w.r.t. GC, as this scenario demonstrates:
@@ -2523,8 +2554,6 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     }
   }
 
-  Label after_transition;
-
   // check for safepoint operation in progress and/or pending suspend requests
   {
     Label Continue;
@@ -2548,7 +2577,10 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     __ mov(r12, rsp); // remember sp
     __ subptr(rsp, frame::arg_reg_save_area_bytes); // windows
     __ andptr(rsp, -16); // align stack as required by ABI
-    if (!is_critical_native) {
+    if (!is_critical_native && call_counters != NULL) {
+      __ mov64(c_rarg1, (int64_t)call_counters);
+      __ call(RuntimeAddress(CAST_FROM_FN_PTR(address, NativeCallStatistics::check_special_condition_for_native_trans)));
+    } else if (!is_critical_native) {
       __ call(RuntimeAddress(CAST_FROM_FN_PTR(address, JavaThread::check_special_condition_for_native_trans)));
     } else {
       __ call(RuntimeAddress(CAST_FROM_FN_PTR(address, JavaThread::check_special_condition_for_native_trans_and_transition)));
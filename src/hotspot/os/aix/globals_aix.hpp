@@ -36,6 +36,7 @@
                          product_pd, \
                          diagnostic, \
                          diagnostic_pd, \
+                         experimental, \
                          notproduct, \
                          range, \
                          constraint, \
@@ -2574,6 +2574,17 @@ bool os::can_execute_large_page_memory() {
   return false;
 }
 
+void os::register_large_page_region(char* addr, size_t bytes, MEMFLAGS flag) {
+  // There are no transparent huge pages, so no per type policy.
+}
+
+bool os::uses_transparent_huge_pages(MEMFLAGS flag) {
+  return false;
+}
+
+void os::print_large_page_coverage(outputStream* st) {
+}
+
 char* os::pd_attempt_reserve_memory_at(size_t bytes, char* requested_addr, int file_desc) {
   assert(file_desc >= 0, "file_desc is not valid");
   char* result = NULL;
@@ -4036,6 +4047,10 @@ int os::loadavg(double values[], int nelem) {
   }
 }
 
+size_t os::current_rss() {
+  return 0;
+}
+
 void os::pause() {
   char filename[MAX_PATH];
   if (PauseAtStartupFile && PauseAtStartupFile[0]) {
@@ -34,6 +34,7 @@
                          product_pd, \
                          diagnostic, \
                          diagnostic_pd, \
+                         experimental, \
                          notproduct, \
                          range, \
                          constraint, \
@@ -53,6 +54,20 @@
   product(bool, UseTransparentHugePages, false,                         \
           "Use MADV_HUGEPAGE for large pages")                          \
                                                                         \
+  experimental(uintx, JavaThreadCarrierPoolSize, 0,                     \
+          "Maximum number of idle native threads kept after their Java "\
+          "thread terminates, to run new Java threads without creating " \
+          "a native thread. 0 disables the pool. Native state kept in " \
+          "thread-local storage (__thread variables or pthread_key_t "  \
+          "values) carries over to the next Java thread on the carrier, "\
+          "and pthread_key_t destructors only run when it exits")       \
+          range(0, max_jint)                                            \
+                                                                        \
+  experimental(uintx, JavaThreadCarrierIdleTimeout, 60000,              \
+          "Milliseconds an idle native thread stays in the carrier pool " \
+          "before it exits")                                            \
+          range(1, max_jint)                                            \
+                                                                        \
   product(bool, LoadExecStackDllInVMThread, true,                       \
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
@@ -108,6 +108,7 @@
 # include <stdint.h>
 # include <inttypes.h>
 # include <sys/ioctl.h>
+# include <sys/prctl.h>
 #ifdef __GLIBC__
 # include <malloc.h>
 #endif
@@ -733,19 +734,123 @@ bool os::Linux::manually_expand_stack(JavaThread * t, address addr) {
 //////////////////////////////////////////////////////////////////////////////
 // create new thread
 
-// Thread start routine for all newly created threads
-static void *thread_native_entry(Thread *thread) {
+// Pool of idle native threads ("carriers") whose JavaThread has terminated.
+// A carrier parks on its own stack and can run the next JavaThread created
+// with the same stack size, which saves the pthread_create, the stack mmap
+// and the munmap at exit. Carriers are handed out LIFO so that the most
+// recently used stacks, which are the most likely to still be resident,
+// are reused first. Parked carriers have no current Thread, so the pool is
+// synchronized with plain pthread primitives. A reused carrier takes the
+// signal mask and name of the thread that created the new JavaThread, as a
+// new native thread would.
+static const size_t carrier_name_len = 16;   // TASK_COMM_LEN
+
+struct PooledCarrier {
+  PooledCarrier* _next;
+  pthread_t      _tid;
+  size_t         _stack_size;
+  Thread*        _thread;
+  pthread_cond_t _cond;
+  sigset_t       _sigmask;
+  char           _name[carrier_name_len];
+};
 
-  thread->record_stack_base_and_size();
+static pthread_mutex_t _carrier_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static PooledCarrier*  _idle_carriers = NULL;
+static uintx           _idle_carrier_count = 0;
 
-  // Try to randomize the cache line index of hot stack frames.
-  // This helps when threads of the same stack traces evict each other's
-  // cache lines. The threads can be either from the same JVM instance, or
-  // from different JVM instances. The benefit is especially true for
-  // processors with hyperthreading technology.
-  static int counter = 0;
-  int pid = os::current_process_id();
-  alloca(((pid ^ counter++) & 7) * 128);
+// Parks the current native thread until a new JavaThread with a matching
+// stack size is handed to it. Returns NULL if the pool is full or the
+// carrier timed out, in which case the native thread should exit.
+static Thread* park_carrier(size_t stack_size) {
+  if (JavaThreadCarrierPoolSize == 0) {
+    return NULL;
+  }
+
+  PooledCarrier carrier;
+  carrier._next = NULL;
+  carrier._tid = ::pthread_self();
+  carrier._stack_size = stack_size;
+  carrier._thread = NULL;
+  int status = pthread_cond_init(&carrier._cond, NULL);
+  assert_status(status == 0, status, "cond_init");
+
+  struct timespec deadline;
+  ::clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += JavaThreadCarrierIdleTimeout / MILLIUNITS;
+  deadline.tv_nsec += (JavaThreadCarrierIdleTimeout % MILLIUNITS) * NANOSECS_PER_MILLISEC;
+  if (deadline.tv_nsec >= NANOSECS_PER_SEC) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= NANOSECS_PER_SEC;
+  }
+
+  pthread_mutex_lock(&_carrier_pool_lock);
+  if (_idle_carrier_count < JavaThreadCarrierPoolSize) {
+    carrier._next = _idle_carriers;
+    _idle_carriers = &carrier;
+    _idle_carrier_count++;
+    log_debug(os, thread)("Thread parked in carrier pool (tid: " UINTX_FORMAT ", idle: " UINTX_FORMAT ").",
+      os::current_thread_id(), _idle_carrier_count);
+
+    while (carrier._thread == NULL) {
+      status = pthread_cond_timedwait(&carrier._cond, &_carrier_pool_lock, &deadline);
+      if (status == ETIMEDOUT && carrier._thread == NULL) {
+        // Nobody claimed us; unlink and let the native thread exit.
+        PooledCarrier** p = &_idle_carriers;
+        while (*p != &carrier) {
+          p = &(*p)->_next;
+        }
+        *p = carrier._next;
+        _idle_carrier_count--;
+        break;
+      }
+    }
+  }
+  pthread_mutex_unlock(&_carrier_pool_lock);
+
+  pthread_cond_destroy(&carrier._cond);
+  if (carrier._thread != NULL) {
+    pthread_sigmask(SIG_SETMASK, &carrier._sigmask, NULL);
+    ::prctl(PR_SET_NAME, carrier._name);
+  }
+  return carrier._thread;
+}
+
+// Hands 'thread' to an idle carrier with the given stack size, if any.
+static bool unpark_carrier(Thread* thread, size_t stack_size, pthread_t* tid) {
+  if (JavaThreadCarrierPoolSize == 0) {
+    return false;
+  }
+
+  sigset_t sigmask;
+  pthread_sigmask(SIG_BLOCK, NULL, &sigmask);
+  char name[carrier_name_len] = "";
+  ::prctl(PR_GET_NAME, name);
+
+  bool found = false;
+  pthread_mutex_lock(&_carrier_pool_lock);
+  for (PooledCarrier** p = &_idle_carriers; *p != NULL; p = &(*p)->_next) {
+    PooledCarrier* carrier = *p;
+    if (carrier->_stack_size == stack_size) {
+      *p = carrier->_next;
+      _idle_carrier_count--;
+      carrier->_sigmask = sigmask;
+      memcpy(carrier->_name, name, sizeof(name));
+      carrier->_thread = thread;
+      *tid = carrier->_tid;
+      pthread_cond_signal(&carrier->_cond);
+      found = true;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_carrier_pool_lock);
+  return found;
+}
+
+// Runs 'thread' on the current native thread. Returns the next Thread to
+// run if the native thread was parked in the carrier pool and reused.
+static Thread* thread_native_run(Thread* thread) {
+  thread->record_stack_base_and_size();
 
   thread->initialize_thread_current();
 
@@ -783,6 +888,11 @@ static void *thread_native_entry(Thread *thread) {
     }
   }
 
+  // Only plain Java threads are pooled, and only with their stack size
+  // as seen from inside the thread, which is what create_thread asks for.
+  bool poolable = osthread->thread_type() == os::java_thread;
+  size_t stack_size = thread->stack_size();
+
   // call one more level start routine
   thread->call_run();
 
@@ -793,6 +903,25 @@ static void *thread_native_entry(Thread *thread) {
   log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
     os::current_thread_id(), (uintx) pthread_self());
 
+  return poolable ? park_carrier(stack_size) : NULL;
+}
+
+// Thread start routine for all newly created threads
+static void *thread_native_entry(Thread *thread) {
+
+  // Try to randomize the cache line index of hot stack frames.
+  // This helps when threads of the same stack traces evict each other's
+  // cache lines. The threads can be either from the same JVM instance, or
+  // from different JVM instances. The benefit is especially true for
+  // processors with hyperthreading technology.
+  static int counter = 0;
+  int pid = os::current_process_id();
+  alloca(((pid ^ counter++) & 7) * 128);
+
+  do {
+    thread = thread_native_run(thread);
+  } while (thread != NULL);
+
   return 0;
 }
 
@@ -821,6 +950,7 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
 
   // Calculate stack size if it's not specified by caller.
   size_t stack_size = os::Posix::get_initial_stack_size(thr_type, req_stack_size);
+  size_t usable_stack_size = stack_size;
   // In the Linux NPTL pthread implementation the guard size mechanism
   // is not implemented properly. The posix standard requires adding
   // the size of the guard pages to the stack size, instead Linux
@@ -844,6 +974,21 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
 
   {
     pthread_t tid;
+    if (thr_type == os::java_thread &&
+        unpark_carrier(thread, usable_stack_size, &tid)) {
+      log_info(os, thread)("Thread started on pooled carrier (pthread id: " UINTX_FORMAT ").", (uintx) tid);
+      pthread_attr_destroy(&attr);
+      osthread->set_pthread_id(tid);
+
+      Monitor* sync_with_child = osthread->startThread_lock();
+      MutexLockerEx ml(sync_with_child, Mutex::_no_safepoint_check_flag);
+      while ((state = osthread->get_state()) == ALLOCATED) {
+        sync_with_child->wait(Mutex::_no_safepoint_check_flag);
+      }
+      assert(state == INITIALIZED, "race condition");
+      return true;
+    }
+
     int ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
 
     char buf[64];
@@ -3037,10 +3182,127 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
   }
 }
 
+// Reserved memory with a transparent huge page policy of its own, see
+// os::register_large_page_region(). Only written during initialization.
+struct LargePageRegion {
+  MEMFLAGS    flag;
+  const char* name;
+  char*       start;
+  char*       end;
+};
+
+static LargePageRegion large_page_regions[] = {
+  { mtJavaHeap,    "Java Heap",   NULL, NULL },
+  { mtCode,        "Code Cache",  NULL, NULL },
+  { mtClass,       "Class Space", NULL, NULL },
+  { mtClassShared, "CDS Archive", NULL, NULL }
+};
+
+static LargePageRegion* large_page_region_containing(char* addr) {
+  for (size_t i = 0; i < ARRAY_SIZE(large_page_regions); i++) {
+    LargePageRegion* region = &large_page_regions[i];
+    if (region->start <= addr && addr < region->end) {
+      return region;
+    }
+  }
+  return NULL;
+}
+
+void os::register_large_page_region(char* addr, size_t bytes, MEMFLAGS flag) {
+  for (size_t i = 0; i < ARRAY_SIZE(large_page_regions); i++) {
+    LargePageRegion* region = &large_page_regions[i];
+    if (region->flag == flag) {
+      region->start = addr;
+      region->end = addr + bytes;
+      if (UseTransparentHugePages) {
+        log_info(pagesize)("%s: " PTR_FORMAT "-" PTR_FORMAT ", transparent huge pages %s",
+                           region->name, p2i(region->start), p2i(region->end),
+                           uses_transparent_huge_pages(flag) ? "enabled" : "disabled");
+      }
+      return;
+    }
+  }
+  ShouldNotReachHere();
+}
+
+bool os::uses_transparent_huge_pages(MEMFLAGS flag) {
+  if (!UseTransparentHugePages) {
+    return false;
+  }
+  switch (flag) {
+    case mtJavaHeap:    return UseTransparentHugePagesForHeap;
+    case mtCode:        return UseTransparentHugePagesForCodeCache;
+    case mtClass:       return UseTransparentHugePagesForClassSpace;
+    case mtClassShared: return UseTransparentHugePagesForCDSArchive;
+    default:            ShouldNotReachHere(); return false;
+  }
+}
+
+void os::print_large_page_coverage(outputStream* st) {
+  size_t rss[ARRAY_SIZE(large_page_regions)] = { 0 };
+  size_t huge[ARRAY_SIZE(large_page_regions)] = { 0 };
+
+  FILE* f = ::fopen("/proc/self/smaps", "r");
+  if (f == NULL) {
+    st->print_cr("Could not open /proc/self/smaps to get large page coverage");
+    return;
+  }
+  // Mappings are attributed to the region containing their start; mappings
+  // do not span regions unless adjacent reservations were merged.
+  int current = -1;
+  char buf[256];
+  bool line_start = true;
+  while (::fgets(buf, sizeof(buf), f) != NULL) {
+    const bool at_line_start = line_start;
+    line_start = strchr(buf, '\n') != NULL;
+    if (!at_line_start) {
+      // The rest of a long line, e.g. a mapping of a file with a long path.
+      continue;
+    }
+    unsigned long start, end;
+    size_t kb;
+    if (sscanf(buf, "%lx-%lx", &start, &end) == 2) {
+      LargePageRegion* region = large_page_region_containing((char*)start);
+      current = region != NULL ? (int)(region - large_page_regions) : -1;
+    } else if (current < 0) {
+      continue;
+    } else if (sscanf(buf, "Rss: " SIZE_FORMAT " kB", &kb) == 1) {
+      rss[current] += kb;
+    } else if (sscanf(buf, "AnonHugePages: " SIZE_FORMAT " kB", &kb) == 1 ||
+               sscanf(buf, "ShmemPmdMapped: " SIZE_FORMAT " kB", &kb) == 1 ||
+               sscanf(buf, "FilePmdMapped: " SIZE_FORMAT " kB", &kb) == 1) {
+      huge[current] += kb;
+    }
+  }
+  fclose(f);
+
+  st->print_cr("Transparent huge page coverage (from /proc/self/smaps):");
+  for (size_t i = 0; i < ARRAY_SIZE(large_page_regions); i++) {
+    LargePageRegion* region = &large_page_regions[i];
+    if (region->start == NULL) {
+      continue;
+    }
+    const char* policy = !UseTransparentHugePages ? "kernel default" :
+                         uses_transparent_huge_pages(region->flag) ? "madvise" : "disabled";
+    st->print_cr("  %-12s " PTR_FORMAT "-" PTR_FORMAT " (%s): resident " SIZE_FORMAT "K, huge pages " SIZE_FORMAT "K (%.1f%%)",
+                 region->name, p2i(region->start), p2i(region->end), policy,
+                 rss[i], huge[i], rss[i] > 0 ? huge[i] * 100.0 / rss[i] : 0.0);
+  }
+}
+
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
-  if (UseTransparentHugePages && alignment_hint > (size_t)vm_page_size()) {
-    // We don't check the return value: madvise(MADV_HUGEPAGE) may not
-    // be supported or the memory may already be backed by huge pages.
+  if (!UseTransparentHugePages) {
+    return;
+  }
+  // We don't check the return value: madvise(MADV_HUGEPAGE) may not
+  // be supported or the memory may already be backed by huge pages.
+  LargePageRegion* region = large_page_region_containing(addr);
+  if (region != NULL) {
+    // Memory types with the policy off are left to the kernel default.
+    if (uses_transparent_huge_pages(region->flag)) {
+      ::madvise(addr, bytes, MADV_HUGEPAGE);
+    }
+  } else if (alignment_hint > (size_t)vm_page_size()) {
     ::madvise(addr, bytes, MADV_HUGEPAGE);
   }
 }
@@ -5960,6 +6222,18 @@ int os::loadavg(double loadavg[], int nelem) {
   return ::getloadavg(loadavg, nelem);
 }
 
+size_t os::current_rss() {
+  FILE* f = fopen("/proc/self/statm", "r");
+  if (f == NULL) {
+    return 0;
+  }
+  size_t size_pages;
+  size_t resident_pages;
+  int n = fscanf(f, SIZE_FORMAT " " SIZE_FORMAT, &size_pages, &resident_pages);
+  fclose(f);
+  return (n == 2) ? resident_pages * os::vm_page_size() : 0;
+}
+
 void os::pause() {
   char filename[MAX_PATH];
   if (PauseAtStartupFile && PauseAtStartupFile[0]) {
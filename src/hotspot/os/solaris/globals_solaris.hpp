@@ -34,6 +34,7 @@
                          product_pd, \
                          diagnostic, \
                          diagnostic_pd, \
+                         experimental, \
                          notproduct, \
                          range, \
                          constraint, \
@@ -2903,6 +2903,17 @@ bool os::can_execute_large_page_memory() {
   return true;
 }
 
+void os::register_large_page_region(char* addr, size_t bytes, MEMFLAGS flag) {
+  // There are no transparent huge pages, so no per type policy.
+}
+
+bool os::uses_transparent_huge_pages(MEMFLAGS flag) {
+  return false;
+}
+
+void os::print_large_page_coverage(outputStream* st) {
+}
+
 // Read calls from inside the vm need to perform state transitions
 size_t os::read(int fd, void *buf, unsigned int nBytes) {
   size_t res;
@@ -4826,6 +4837,10 @@ int os::loadavg(double loadavg[], int nelem) {
   }
 }
 
+size_t os::current_rss() {
+  return 0;
+}
+
 //---------------------------------------------------------------------------------
 
 bool os::find(address addr, outputStream* st) {
@@ -3170,6 +3170,17 @@ bool os::can_execute_large_page_memory() {
   return true;
 }
 
+void os::register_large_page_region(char* addr, size_t bytes, MEMFLAGS flag) {
+  // There are no transparent huge pages, so no per type policy.
+}
+
+bool os::uses_transparent_huge_pages(MEMFLAGS flag) {
+  return false;
+}
+
+void os::print_large_page_coverage(outputStream* st) {
+}
+
 char* os::reserve_memory_special(size_t bytes, size_t alignment, char* addr,
                                  bool exec) {
   assert(UseLargePages, "only for large pages");
@@ -4528,6 +4539,10 @@ int os::loadavg(double loadavg[], int nelem) {
   return -1;
 }
 
+size_t os::current_rss() {
+  return 0;
+}
+
 
 // DontYieldALot=false by default: dutifully perform all yields as requested by JVM_Yield()
 bool os::dont_yield() {
@@ -36,6 +36,7 @@
 #include "oops/method.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/macros.hpp"
 
@@ -84,6 +85,21 @@ typedef struct _ciInlineRecord {
   int _inline_bci;
 } ciInlineRecord;
 
+// Compile time and memory of the replayed compilations of one compiler.
+// The arena and malloc bytes come from the global AllocStats counters,
+// which only reflect the replayed compilation because the replay does
+// not run an application and compiles in the foreground. The arena peak
+// is the largest arena footprint of a single compilation as accounted by
+// its compiler thread.
+typedef struct _ciReplayStatistics {
+  int          _count;
+  int          _failed;
+  elapsedTimer _time;
+  julong       _arena_bytes;
+  julong       _max_arena_peak;
+  julong       _malloc_bytes;
+} ciReplayStatistics;
+
 class  CompileReplay;
 static CompileReplay* replay_state;
 
@@ -114,6 +130,12 @@ class CompileReplay : public StackObj {
   int      _entry_bci;
   int      _comp_level;
 
+  // Replay corpus data, see ReplayCorpus
+  bool     _skip_entry;        // Skip the rest of an entry that cannot be replayed
+  int      _skipped_entries;
+  size_t   _arena_peak;        // Arena peak of the last replayed compilation
+  ciReplayStatistics _statistics[2]; // C1 and C2
+
  public:
   CompileReplay(const char* filename, TRAPS) {
     _thread = THREAD;
@@ -138,6 +160,17 @@ class CompileReplay : public StackObj {
     _entry_bci  = 0;
     _comp_level = 0;
 
+    _skip_entry = false;
+    _skipped_entries = 0;
+    _arena_peak = 0;
+    for (int i = 0; i < 2; i++) {
+      _statistics[i]._count = 0;
+      _statistics[i]._failed = 0;
+      _statistics[i]._arena_bytes = 0;
+      _statistics[i]._max_arena_peak = 0;
+      _statistics[i]._malloc_bytes = 0;
+    }
+
     test();
   }
 
@@ -395,7 +428,18 @@ class CompileReplay : public StackObj {
       process_command(THREAD);
       if (had_error()) {
         tty->print_cr("Error while parsing line %d: %s\n", line_no, _error_message);
-        if (ReplayIgnoreInitErrors) {
+        if (ReplayCorpus) {
+          // Continue with the next entry of the corpus. Each entry ends with
+          // its "compile" command.
+          CLEAR_PENDING_EXCEPTION;
+          _error_message = NULL;
+          _skipped_entries++;
+          if (is_compile_line()) {
+            reset();
+          } else {
+            _skip_entry = true;
+          }
+        } else if (ReplayIgnoreInitErrors) {
           CLEAR_PENDING_EXCEPTION;
           _error_message = NULL;
         } else {
@@ -411,6 +455,13 @@ class CompileReplay : public StackObj {
     if (cmd == NULL) {
       return;
     }
+    if (_skip_entry) {
+      if (strcmp("compile", cmd) == 0) {
+        _skip_entry = false;
+        reset();
+      }
+      return;
+    }
     if (strcmp("#", cmd) == 0) {
       // ignore
     } else if (strcmp("compile", cmd) == 0) {
@@ -562,12 +613,53 @@ class CompileReplay : public StackObj {
       nm->make_not_entrant();
     }
     replay_state = this;
+    _arena_peak = 0;
+    AllocStats alloc_stats;
+    elapsedTimer time;
+    time.start();
     CompileBroker::compile_method(method, entry_bci, comp_level,
                                   methodHandle(), 0, CompileTask::Reason_Replay, THREAD);
+    time.stop();
     replay_state = NULL;
+    if (ReplayCorpus) {
+      nm = (entry_bci != InvocationEntryBci) ? method->lookup_osr_nmethod_for(entry_bci, comp_level, true) : method->code();
+      ciReplayStatistics* stats = &_statistics[is_c1_compile(comp_level) ? 0 : 1];
+      stats->_count++;
+      if (nm == NULL || nm->comp_level() != comp_level) {
+        stats->_failed++;
+      }
+      stats->_time.add(time);
+      stats->_arena_bytes += alloc_stats.resource_bytes();
+      stats->_max_arena_peak = MAX2(stats->_max_arena_peak, (julong)_arena_peak);
+      stats->_malloc_bytes += alloc_stats.alloc_bytes();
+    }
     reset();
   }
 
+  void set_arena_peak(size_t bytes) {
+    _arena_peak = bytes;
+  }
+
+  bool is_compile_line() {
+    return strncmp(_buffer, "compile", 7) == 0 && (_buffer[7] == ' ' || _buffer[7] == '\0');
+  }
+
+  void print_corpus_statistics(outputStream* st) {
+    st->print_cr("Replay corpus: %d compilations replayed, %d entries skipped",
+                 _statistics[0]._count + _statistics[1]._count, _skipped_entries);
+    for (int i = 0; i < 2; i++) {
+      ciReplayStatistics* stats = &_statistics[i];
+      if (stats->_count == 0) {
+        continue;
+      }
+      st->print_cr("  %s: %d compilations (%d failed), %7.3f s, average %6.3f ms, "
+                   "arena " JULONG_FORMAT "K (largest peak " JULONG_FORMAT "K), malloc " JULONG_FORMAT "K",
+                   i == 0 ? "C1" : "C2", stats->_count, stats->_failed, stats->_time.seconds(),
+                   stats->_time.seconds() * MILLIUNITS / stats->_count,
+                   stats->_arena_bytes / K, stats->_max_arena_peak / K, stats->_malloc_bytes / K);
+    }
+  }
+
   // ciMethod <klass> <name> <signature> <invocation_counter> <backedge_counter> <interpreter_invocation_count> <interpreter_throwout_count> <instructions_size>
   //
   //
@@ -1109,9 +1201,19 @@ int ciReplay::replay_impl(TRAPS) {
     tty->print_cr("Failed on %s", rp.error_message());
     exit_code = 1;
   }
+
+  if (ReplayCorpus) {
+    rp.print_corpus_statistics(tty);
+  }
   return exit_code;
 }
 
+void ciReplay::record_arena_peak(size_t bytes) {
+  if (replay_state != NULL) {
+    replay_state->set_arena_peak(bytes);
+  }
+}
+
 void ciReplay::initialize(ciMethodData* m) {
   if (replay_state == NULL) {
     return;
@@ -79,6 +79,27 @@
 // a program to execute. VM exits when the compilation is finished.
 //
 //
+// Replay corpus.
+// --------------
+//
+// The replay data of every successful compilation of a warmup can be
+// recorded in one file during normal execution:
+//
+// -XX:ReplayCorpusFile=corpus_pid%p.log -XX:ReplayCorpusWindow=60000
+//
+// The window limits recording to the compilations that finish within the
+// first 60 seconds after VM start. Each compilation is stored as an entry
+// that ends with its "compile" command. The corpus is replayed offline with
+//
+// -XX:+ReplayCompiles -XX:+ReplayCorpus -XX:ReplayDataFile=corpus_pid2133.log
+//
+// All entries are compiled one after the other without an application
+// running. Entries that cannot be replayed are skipped. At the end the
+// compile time, the arena and malloc memory, and the largest arena peak
+// of a single compilation are reported for C1 and C2, and CITime reports
+// the time of the compiler phases.
+//
+//
 // Replay inlining.
 // ----------------
 //
@@ -122,6 +143,9 @@ class ciReplay {
   static bool should_inline(void* data, ciMethod* method, int bci, int inline_depth);
   static bool should_not_inline(void* data, ciMethod* method, int bci, int inline_depth);
 
+  // Records the arena peak of the compilation being replayed.
+  static void record_arena_peak(size_t bytes);
+
 #endif
 };
 
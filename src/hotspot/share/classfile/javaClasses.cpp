@@ -2048,7 +2048,15 @@ class BacktraceBuilder: public StackObj {
 
   // constructor for new backtrace
   BacktraceBuilder(TRAPS): _methods(NULL), _bcis(NULL), _head(NULL), _mirrors(NULL), _names(NULL) {
-    expand(CHECK);
+    expand(trace_chunk_size, CHECK);
+    _backtrace = Handle(THREAD, _head);
+    _index = 0;
+  }
+
+  // constructor for a new backtrace whose depth is known up front; all
+  // frames go into a single chunk of exactly that size
+  BacktraceBuilder(int depth, TRAPS): _methods(NULL), _bcis(NULL), _head(NULL), _mirrors(NULL), _names(NULL) {
+    expand(MAX2(depth, 1), CHECK);
     _backtrace = Handle(THREAD, _head);
     _index = 0;
   }
@@ -2069,23 +2077,23 @@ class BacktraceBuilder: public StackObj {
     _index = 0;
   }
 
-  void expand(TRAPS) {
+  void expand(int chunk_size, TRAPS) {
     objArrayHandle old_head(THREAD, _head);
     PauseNoSafepointVerifier pnsv(&_nsv);
 
     objArrayOop head = oopFactory::new_objectArray(trace_size, CHECK);
     objArrayHandle new_head(THREAD, head);
 
-    typeArrayOop methods = oopFactory::new_shortArray(trace_chunk_size, CHECK);
+    typeArrayOop methods = oopFactory::new_shortArray(chunk_size, CHECK);
     typeArrayHandle new_methods(THREAD, methods);
 
-    typeArrayOop bcis = oopFactory::new_intArray(trace_chunk_size, CHECK);
+    typeArrayOop bcis = oopFactory::new_intArray(chunk_size, CHECK);
     typeArrayHandle new_bcis(THREAD, bcis);
 
-    objArrayOop mirrors = oopFactory::new_objectArray(trace_chunk_size, CHECK);
+    objArrayOop mirrors = oopFactory::new_objectArray(chunk_size, CHECK);
     objArrayHandle new_mirrors(THREAD, mirrors);
 
-    typeArrayOop names = oopFactory::new_symbolArray(trace_chunk_size, CHECK);
+    typeArrayOop names = oopFactory::new_symbolArray(chunk_size, CHECK);
     typeArrayHandle new_names(THREAD, names);
 
     if (!old_head.is_null()) {
@@ -2114,9 +2122,9 @@ class BacktraceBuilder: public StackObj {
     // to a 0 even if it could be recorded.
     if (bci == SynchronizationEntryBCI) bci = 0;
 
-    if (_index >= trace_chunk_size) {
+    if (_index >= _methods->length()) {
       methodHandle mhandle(THREAD, method);
-      expand(CHECK);
+      expand(trace_chunk_size, CHECK);
       method = mhandle();
     }
 
@@ -2137,6 +2145,14 @@ class BacktraceBuilder: public StackObj {
 
 };
 
+// A frame recorded by fill_in_stack_trace before the backtrace is allocated
+struct BacktraceFrame {
+  Method* _method;
+  int     _bci;
+  BacktraceFrame() : _method(NULL), _bci(0) {}
+  BacktraceFrame(Method* method, int bci) : _method(method), _bci(bci) {}
+};
+
 struct BacktraceElement : public StackObj {
   int _method_id;
   int _bci;
@@ -2169,7 +2185,6 @@ class BacktraceIterator : public StackObj {
  public:
   BacktraceIterator(objArrayHandle result, Thread* thread) {
     init(result, thread);
-    assert(_methods.is_null() || _methods->length() == java_lang_Throwable::trace_chunk_size, "lengths don't match");
   }
 
   BacktraceElement next(Thread* thread) {
@@ -2180,7 +2195,9 @@ class BacktraceIterator : public StackObj {
                         _names->symbol_at(_index));
     _index++;
 
-    if (_index >= java_lang_Throwable::trace_chunk_size) {
+    // Chunks are trace_chunk_size long, except for a backtrace filled in
+    // with a known depth, which is a single chunk of that depth
+    if (_index >= _methods->length()) {
       int next_offset = java_lang_Throwable::trace_next_offset;
       // Get next chunk
       objArrayHandle result (thread, objArrayOop(_result->obj_at(next_offset)));
@@ -2190,7 +2207,7 @@ class BacktraceIterator : public StackObj {
   }
 
   bool repeat() {
-    return _result.not_null() && _mirrors->obj_at(_index) != NULL;
+    return _result.not_null() && _index < _mirrors->length() && _mirrors->obj_at(_index) != NULL;
   }
 };
 
@@ -2354,12 +2371,11 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
   int max_depth = MaxJavaStackTraceDepth;
   JavaThread* thread = (JavaThread*)THREAD;
 
-  BacktraceBuilder bt(CHECK);
-
   // If there is no Java frame just return the method that was being called
   // with bci 0
   if (!thread->has_last_Java_frame()) {
     if (max_depth >= 1 && method() != NULL) {
+      BacktraceBuilder bt(1, CHECK);
       bt.push(method(), 0, CHECK);
       log_info(stacktrace)("%s, %d", throwable->klass()->external_name(), 1);
       set_depth(throwable(), 1);
@@ -2378,6 +2394,12 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
   vframeStream st(thread);
   methodHandle st_method(THREAD, st.method());
 #endif
+  // The walk only records (method, bci) pairs in the resource area; the
+  // backtrace is allocated afterwards as a single chunk of the exact
+  // depth, instead of a new chunk of trace_chunk_size frames every 32
+  // frames. The methods stay alive across that allocation since they
+  // are all on this thread's stack.
+  GrowableArray<BacktraceFrame>* frames = new GrowableArray<BacktraceFrame>(max_depth == 0 ? trace_chunk_size : MIN2(max_depth, 256));
   int total_count = 0;
   RegisterMap map(thread, false);
   int decode_offset = 0;
@@ -2466,10 +2488,16 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, const methodHand
     if (method->is_hidden()) {
       if (skip_hidden)  continue;
     }
-    bt.push(method, bci, CHECK);
+    frames->append(BacktraceFrame(method, bci));
     total_count++;
   }
 
+  BacktraceBuilder bt(total_count, CHECK);
+  for (int i = 0; i < total_count; i++) {
+    BacktraceFrame f = frames->at(i);
+    bt.push(f._method, f._bci, CHECK);
+  }
+
   log_info(stacktrace)("%s, %d", throwable->klass()->external_name(), total_count);
 
   // Put completed stack trace into throwable object
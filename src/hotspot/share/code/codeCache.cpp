@@ -292,9 +292,21 @@ void CodeCache::initialize_heaps() {
   non_nmethod_size = align_up(non_nmethod_size, alignment);
   profiled_size    = align_down(profiled_size, alignment);
 
+  // The hot code heap is carved out of the top of the non-profiled code heap.
+  // It is aligned like the other code heaps so that it is backed by its own
+  // large pages if they are available.
+  size_t hot_size = 0;
+  if (heap_available(CodeBlobType::MethodHot)) {
+    hot_size = MIN2(align_up((size_t)HotCodeHeapSize, alignment),
+                    align_down(non_profiled_size / 2, alignment));
+    FLAG_SET_ERGO(uintx, HotCodeHeapSize, hot_size);
+    FLAG_SET_ERGO(uintx, NonProfiledCodeHeapSize, non_profiled_size - hot_size);
+  }
+
   // Reserve one continuous chunk of memory for CodeHeaps and split it into
   // parts for the individual heaps. The memory layout looks like this:
   // ---------- high -----------
+  //        Hot nmethods
   //    Non-profiled nmethods
   //      Profiled nmethods
   //         Non-nmethods
@@ -304,6 +316,12 @@ void CodeCache::initialize_heaps() {
   ReservedSpace rest                = rs.last_part(non_nmethod_size);
   ReservedSpace profiled_space      = rest.first_part(profiled_size);
   ReservedSpace non_profiled_space  = rest.last_part(profiled_size);
+  ReservedSpace hot_space;
+  if (hot_size > 0) {
+    size_t non_profiled_part = non_profiled_space.size() - hot_size;
+    hot_space          = non_profiled_space.last_part(non_profiled_part);
+    non_profiled_space = non_profiled_space.first_part(non_profiled_part);
+  }
 
   // Non-nmethods (stubs, adapters, ...)
   add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
@@ -311,6 +329,10 @@ void CodeCache::initialize_heaps() {
   add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
   // Tier 1 and tier 4 (non-profiled) methods and native methods
   add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
+  // Hot tier 4 methods recompiled by the sweeper (see NMethodSweeper::possibly_cluster_hot_code())
+  if (hot_size > 0) {
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+  }
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
@@ -345,7 +367,12 @@ ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
 
 // Heaps available for allocation
 bool CodeCache::heap_available(int code_blob_type) {
-  if (!SegmentedCodeCache) {
+  if (code_blob_type == CodeBlobType::MethodHot) {
+    // Hot code is recompiled at tier 4 and replaces the old tier 4 code,
+    // which requires tiered compilation with C2.
+    return SegmentedCodeCache && HotCodeHeapSize > 0 && TieredCompilation &&
+           TieredStopAtLevel == CompLevel_full_optimization && !Arguments::is_interpreter_only();
+  } else if (!SegmentedCodeCache) {
     // No segmentation: use a single code heap
     return (code_blob_type == CodeBlobType::All);
   } else if (Arguments::is_interpreter_only()) {
@@ -372,6 +399,9 @@ const char* CodeCache::get_code_heap_flag_name(int code_blob_type) {
   case CodeBlobType::MethodProfiled:
     return "ProfiledCodeHeapSize";
     break;
+  case CodeBlobType::MethodHot:
+    return "HotCodeHeapSize";
+    break;
   }
   ShouldNotReachHere();
   return NULL;
@@ -505,11 +535,12 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, int orig_code_blob_t
       // Expansion failed
       if (SegmentedCodeCache) {
         // Fallback solution: Try to store code in another code heap.
-        // NonNMethod -> MethodNonProfiled -> MethodProfiled (-> MethodNonProfiled)
+        // MethodHot -> MethodNonProfiled, NonNMethod -> MethodNonProfiled -> MethodProfiled (-> MethodNonProfiled)
         // Note that in the sweeper, we check the reverse_free_ratio of the code heap
         // and force stack scanning if less than 10% of the code heap are free.
         int type = code_blob_type;
         switch (type) {
+        case CodeBlobType::MethodHot:
         case CodeBlobType::NonNMethod:
           type = CodeBlobType::MethodNonProfiled;
           break;
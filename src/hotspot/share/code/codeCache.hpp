@@ -81,6 +81,7 @@ class CodeCache : AllStatic {
   template <class T, class Filter> friend class CodeBlobIterator;
   friend class WhiteBox;
   friend class CodeCacheLoader;
+  friend class NMethodSweeper;
 #if INCLUDE_SHENANDOAHGC
   friend class ShenandoahParallelCodeHeapIterator;
 #endif
@@ -242,17 +243,17 @@ class CodeCache : AllStatic {
   }
 
   static bool code_blob_type_accepts_compiled(int type) {
-    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled || type == CodeBlobType::MethodHot;
     AOT_ONLY( result = result || type == CodeBlobType::AOT; )
     return result;
   }
 
   static bool code_blob_type_accepts_nmethod(int type) {
-    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled || type == CodeBlobType::MethodHot;
   }
 
   static bool code_blob_type_accepts_allocable(int type) {
-    return type <= CodeBlobType::All;
+    return type <= CodeBlobType::All || type == CodeBlobType::MethodHot;
   }
 
 
@@ -638,7 +638,18 @@ nmethod::nmethod(
 }
 
 void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw () {
-  return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
+  int code_blob_type = CodeCache::get_code_blob_type(comp_level);
+  if (CodeCache::heap_available(CodeBlobType::MethodHot) && comp_level == CompLevel_full_optimization) {
+    // Recompilations requested by the sweeper go to the hot code heap
+    Thread* thread = Thread::current();
+    if (thread->is_Compiler_thread()) {
+      CompileTask* task = ((CompilerThread*)thread)->task();
+      if (task != NULL && task->compile_reason() == CompileTask::Reason_HotCode) {
+        code_blob_type = CodeBlobType::MethodHot;
+      }
+    }
+  }
+  return CodeCache::allocate(nmethod_size, code_blob_type);
 }
 
 nmethod::nmethod(
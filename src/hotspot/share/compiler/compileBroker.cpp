@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "ci/ciReplay.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
@@ -230,11 +231,48 @@ class CompilationLog : public StringEventLog {
 
 static CompilationLog* _compilation_log = NULL;
 
+// Replay corpus, see ReplayCorpusFile
+static fileStream* _replay_corpus = NULL;
+// Serializes the writes of the compiler threads to the replay corpus
+static Mutex* _replay_corpus_lock = NULL;
+
+static void open_replay_corpus() {
+  char file_name[JVM_MAXPATHLEN];
+  if (!Arguments::copy_expand_pid(ReplayCorpusFile, strlen(ReplayCorpusFile),
+                                  file_name, JVM_MAXPATHLEN)) {
+    warning("Invalid replay corpus file name %s, compilations are not recorded", ReplayCorpusFile);
+    return;
+  }
+  fileStream* corpus = new (ResourceObj::C_HEAP, mtCompiler) fileStream(file_name, "w");
+  if (!corpus->is_open()) {
+    warning("Cannot open replay corpus file %s, compilations are not recorded", file_name);
+    delete corpus;
+    return;
+  }
+  _replay_corpus_lock = new Mutex(Mutex::leaf, "ReplayCorpus_lock", true, Monitor::_safepoint_check_never);
+  _replay_corpus = corpus;
+}
+
+// Appends the replay data of a compilation to the replay corpus. The data
+// is collected under Compile_lock but written after releasing it, so that
+// the file I/O does not block class loading and deoptimization.
+static void record_replay_corpus_entry(ciEnv* env) {
+  stringStream entry(4 * K);
+  env->dump_replay_data(&entry);
+  MutexLockerEx ml(_replay_corpus_lock, Mutex::_no_safepoint_check_flag);
+  _replay_corpus->write(entry.base(), entry.size());
+  _replay_corpus->flush();
+}
+
 bool compileBroker_init() {
   if (LogEvents) {
     _compilation_log = new CompilationLog();
   }
 
+  if (ReplayCorpusFile != NULL) {
+    open_replay_corpus();
+  }
+
   // init directives stack, adding default directive
   DirectivesStack::init();
 
@@ -315,8 +353,12 @@ bool CompileBroker::can_remove(CompilerThread *ct, bool do_it) {
   // Keep at least 1 compiler thread of each type.
   if (compiler_count < 2) return false;
 
-  // Keep thread alive for at least some time.
-  if (ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+  // Keep thread alive for at least some time, unless the CPU quota has
+  // shrunk below the number of compiler threads we are currently running.
+  int total_count = (_compilers[0] != NULL ? _compilers[0]->num_compiler_threads() : 0) +
+                    (_compilers[1] != NULL ? _compilers[1]->num_compiler_threads() : 0);
+  if (total_count <= compiler_thread_budget() &&
+      ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
 
 #if INCLUDE_JVMCI
   if (compiler->is_jvmci()) {
@@ -448,6 +490,11 @@ CompileTask* CompileQueue::get() {
     // is not critical and we do not want idle compiler threads to wake up too often.
     MethodCompileQueue_lock->wait(!Mutex::_no_safepoint_check_flag, 5*1000);
 
+    if (_first == NULL) {
+      // Do not hold on to the arena chunks of an idle compiler thread.
+      CompilerThread::current()->release_cached_chunks();
+    }
+
     if (UseDynamicNumberOfCompilerThreads && _first == NULL) {
       // Still nothing to compile. Give caller a chance to stop this thread.
       if (CompileBroker::can_remove(CompilerThread::current(), false)) return NULL;
@@ -917,13 +964,35 @@ void CompileBroker::init_compiler_sweeper_threads() {
   }
 
   if (MethodFlushing) {
-    // Initialize the sweeper thread
-    Handle thread_oop = create_thread_oop("Sweeper thread", CHECK);
-    jobject thread_handle = JNIHandles::make_local(THREAD, thread_oop());
-    make_thread(thread_handle, NULL, NULL, CHECK);
+    if (UsePerfData) {
+      NMethodSweeper::create_perf_counters(CHECK);
+    }
+    // Initialize the sweeper threads, the first one is the primary sweeper
+    // thread and the others help it to sweep large code caches
+    for (uintx i = 0; i < CodeCacheSweeperThreads; i++) {
+      if (i == 0) {
+        sprintf(name_buffer, "Sweeper thread");
+      } else {
+        sprintf(name_buffer, "Sweeper thread%d", (int)i);
+      }
+      Handle thread_oop = create_thread_oop(name_buffer, CHECK);
+      jobject thread_handle = JNIHandles::make_local(THREAD, thread_oop());
+      make_thread(thread_handle, NULL, NULL, CHECK);
+    }
   }
 }
 
+/**
+ * Maximum number of C1 and C2 compiler threads together. The budget follows
+ * the number of active processors, which reflects the container CPU quota,
+ * so that a warmup burst does not take the CPUs away from the application.
+ */
+int CompileBroker::compiler_thread_budget() {
+  int budget = (int)(os::active_processor_count() * CompilerThreadCPUShare / 100);
+  int min_count = (_c1_compile_queue != NULL ? 1 : 0) + (_c2_compile_queue != NULL ? 1 : 0);
+  return MAX2(budget, min_count);
+}
+
 void CompileBroker::possibly_add_compiler_threads() {
   EXCEPTION_MARK;
 
@@ -935,13 +1004,45 @@ void CompileBroker::possibly_add_compiler_threads() {
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
+  int old_c1_count = 0, new_c1_count = 0;
+  int old_c2_count = 0, new_c2_count = 0;
   if (_c2_compile_queue != NULL) {
-    int old_c2_count = _compilers[1]->num_compiler_threads();
-    int new_c2_count = MIN4(_c2_count,
+    old_c2_count = _compilers[1]->num_compiler_threads();
+    new_c2_count = MIN4(_c2_count,
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
+  }
+  if (_c1_compile_queue != NULL) {
+    old_c1_count = _compilers[0]->num_compiler_threads();
+    new_c1_count = MIN4(_c1_count,
+        _c1_compile_queue->size() / 4,
+        (int)(available_memory / (100*M)),
+        (int)(available_cc_p / (128*K)));
+  }
 
+  // Both compilers draw from a shared thread budget. If the budget does not
+  // cover all requests, the compiler with the larger backlog per running
+  // thread gets the free slots first. Idle threads of the other compiler
+  // are retired by can_remove() and their slots become available again.
+  int c1_wanted = MAX2(new_c1_count - old_c1_count, 0);
+  int c2_wanted = MAX2(new_c2_count - old_c2_count, 0);
+  int free_slots = MAX2(compiler_thread_budget() - old_c1_count - old_c2_count, 0);
+  if (c1_wanted + c2_wanted > free_slots) {
+    int c1_backlog = (_c1_compile_queue != NULL) ? _c1_compile_queue->size() / (4 * MAX2(old_c1_count, 1)) : 0;
+    int c2_backlog = (_c2_compile_queue != NULL) ? _c2_compile_queue->size() / (2 * MAX2(old_c2_count, 1)) : 0;
+    if (c2_backlog >= c1_backlog) {
+      c2_wanted = MIN2(c2_wanted, free_slots);
+      c1_wanted = free_slots - c2_wanted;
+    } else {
+      c1_wanted = MIN2(c1_wanted, free_slots);
+      c2_wanted = free_slots - c1_wanted;
+    }
+    new_c1_count = old_c1_count + c1_wanted;
+    new_c2_count = old_c2_count + c2_wanted;
+  }
+
+  if (_c2_compile_queue != NULL) {
     for (int i = old_c2_count; i < new_c2_count; i++) {
 #if INCLUDE_JVMCI
       if (UseJVMCICompiler) {
@@ -989,12 +1090,6 @@ void CompileBroker::possibly_add_compiler_threads() {
   }
 
   if (_c1_compile_queue != NULL) {
-    int old_c1_count = _compilers[0]->num_compiler_threads();
-    int new_c1_count = MIN4(_c1_count,
-        _c1_compile_queue->size() / 4,
-        (int)(available_memory / (100*M)),
-        (int)(available_cc_p / (128*K)));
-
     for (int i = old_c1_count; i < new_c1_count; i++) {
       JavaThread *ct = make_thread(compiler1_object(i), _c1_compile_queue, _compilers[0], CHECK);
       if (ct == NULL) break;
@@ -1068,7 +1163,7 @@ void CompileBroker::compile_method_base(const methodHandle& method,
   // A request has been made for compilation.  Before we do any
   // real work, check to see if the method has been compiled
   // in the meantime with a definitive result.
-  if (compilation_is_complete(method, osr_bci, comp_level)) {
+  if (compilation_is_complete(method, osr_bci, comp_level, compile_reason)) {
     return;
   }
 
@@ -1119,7 +1214,7 @@ void CompileBroker::compile_method_base(const methodHandle& method,
     // We need to check again to see if the compilation has
     // completed.  A previous compilation may have registered
     // some result.
-    if (compilation_is_complete(method, osr_bci, comp_level)) {
+    if (compilation_is_complete(method, osr_bci, comp_level, compile_reason)) {
       return;
     }
 
@@ -1217,6 +1312,22 @@ void CompileBroker::compile_method_base(const methodHandle& method,
   }
 }
 
+/**
+ * Request a tier 4 recompilation of a method whose tier 4 code lives outside
+ * of the hot code heap. The new nmethod is allocated in the hot code heap and
+ * replaces the current one when it is installed (see ciEnv::register_method).
+ * The C2 prerequisites of compile_method() were already met when the current
+ * code was compiled, so the request goes to the queue directly.
+ */
+void CompileBroker::compile_hot_method(const methodHandle& method, Thread* thread) {
+  assert(CodeCache::heap_available(CodeBlobType::MethodHot), "hot code heap must be in use");
+  if (!_initialized || !should_compile_new_jobs() || method->is_old()) {
+    return;
+  }
+  compile_method_base(method, InvocationEntryBci, CompLevel_full_optimization, methodHandle(), 0,
+                      CompileTask::Reason_HotCode, false, thread);
+}
+
 nmethod* CompileBroker::compile_method(const methodHandle& method, int osr_bci,
                                        int comp_level,
                                        const methodHandle& hot_method, int hot_count,
@@ -1415,6 +1526,24 @@ bool CompileBroker::compilation_is_complete(const methodHandle& method,
   }
 }
 
+// A recompilation into the hot code heap is complete once the current
+// tier 4 code of the method does not need to move there any more.
+bool CompileBroker::compilation_is_complete(const methodHandle& method,
+                                            int                 osr_bci,
+                                            int                 comp_level,
+                                            CompileTask::CompileReason compile_reason) {
+  if (compile_reason != CompileTask::Reason_HotCode) {
+    return compilation_is_complete(method, osr_bci, comp_level);
+  }
+  assert(osr_bci == standard_entry_bci && comp_level == CompLevel_full_optimization, "only tier 4 code is clustered");
+  if (method->is_not_compilable(comp_level)) {
+    return true;
+  }
+  CompiledMethod* code = method->code();
+  return code == NULL || !code->is_in_use() || code->comp_level() != comp_level ||
+         CodeCache::get_code_blob_type(code) == CodeBlobType::MethodHot;
+}
+
 
 /**
  * See if this compilation is already requested.
@@ -2053,6 +2182,7 @@ static void post_compilation_event(EventCompilation* event, CompileTask* task) {
   event->set_isOsr(task->osr_bci() != CompileBroker::standard_entry_bci);
   event->set_codeSize((task->code() == NULL) ? 0 : task->code()->total_size());
   event->set_inlinedBytes(task->num_inlined_bytecodes());
+  event->set_arenaPeak(task->arena_peak());
   event->commit();
 }
 
@@ -2159,6 +2289,7 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     NoHandleMark  nhm;
     ThreadToNativeFromVM ttn(thread);
 
+    thread->start_arena_accounting(CompilerArenaLimit);
     ciEnv ci_env(task, system_dictionary_modification_counter);
     if (should_break) {
       ci_env.set_break_at_compile(true);
@@ -2191,6 +2322,13 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
       }
       comp->compile_method(&ci_env, target, osr_bci, directive);
     }
+    task->set_arena_peak(thread->arena_peak());
+    NOT_PRODUCT(ciReplay::record_arena_peak(thread->arena_peak());)
+
+    if (thread->arena_limit_hit()) {
+      // Do not run into the limit again at this tier
+      ci_env.record_method_not_compilable("hit arena memory limit", !TieredCompilation);
+    }
 
     if (!ci_env.failing() && task->code() == NULL) {
       //assert(false, "compiler should always document failure");
@@ -2199,6 +2337,13 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
       ci_env.record_method_not_compilable("compile failed", !TieredCompilation);
     }
 
+    if (_replay_corpus != NULL && !ci_env.failing() &&
+        (ReplayCorpusWindow == 0 || tty->time_stamp().milliseconds() <= (jlong)ReplayCorpusWindow)) {
+      // Record the ci state of this compilation so that it can be replayed
+      // together with the rest of the warmup (see ciReplay.hpp).
+      record_replay_corpus_entry(&ci_env);
+    }
+
     // Copy this bit to the enclosing block:
     compilable = ci_env.compilable();
 
@@ -2249,7 +2394,8 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     if (task->code() != NULL) {
       tty->print("size: %d(%d) ", task->code()->total_size(), task->code()->insts_size());
     }
-    tty->print_cr("time: %d inlined: %d bytes", (int)time.milliseconds(), task->num_inlined_bytecodes());
+    tty->print_cr("time: %d inlined: %d bytes arena: " SIZE_FORMAT "K", (int)time.milliseconds(),
+                  task->num_inlined_bytecodes(), task->arena_peak() / K);
   }
 
   Log(compilation, codecache) log;
@@ -233,6 +233,7 @@ class CompileBroker: AllStatic {
   static JavaThread* make_thread(jobject thread_oop, CompileQueue* queue, AbstractCompiler* comp, TRAPS);
   static void init_compiler_sweeper_threads();
   static void possibly_add_compiler_threads();
+  static int  compiler_thread_budget();
   static bool compilation_is_prohibited(const methodHandle& method, int osr_bci, int comp_level, bool excluded);
   static void preload_classes          (const methodHandle& method, TRAPS);
 
@@ -288,6 +289,8 @@ public:
   }
 
   static bool compilation_is_complete(const methodHandle& method, int osr_bci, int comp_level);
+  static bool compilation_is_complete(const methodHandle& method, int osr_bci, int comp_level,
+                                      CompileTask::CompileReason compile_reason);
   static bool compilation_is_in_queue(const methodHandle& method);
   static void print_compile_queues(outputStream* st);
   static void print_directives(outputStream* st);
@@ -315,6 +318,9 @@ public:
                                    DirectiveSet* directive,
                                    Thread* thread);
 
+  // Recompile tier 4 code into the hot code heap
+  static void compile_hot_method(const methodHandle& method, Thread* thread);
+
   // Acquire any needed locks and assign a compile id
   static uint assign_compile_id_unlocked(Thread* thread, const methodHandle& method, int osr_bci);
 
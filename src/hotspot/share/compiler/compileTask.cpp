@@ -98,6 +98,7 @@ void CompileTask::initialize(int compile_id,
   JVMCI_ONLY(_jvmci_compiler_thread = NULL;)
   _comp_level = comp_level;
   _num_inlined_bytecodes = 0;
+  _arena_peak = 0;
 
   _is_complete = false;
   _is_success = false;
@@ -403,6 +404,9 @@ void CompileTask::log_task_done(CompileLog* log) {
   if (_num_inlined_bytecodes != 0) {
     log->print(" inlined_bytes='%d'", _num_inlined_bytecodes);
   }
+  if (_arena_peak != 0) {
+    log->print(" arena_peak='" SIZE_FORMAT "'", _arena_peak);
+  }
   log->stamp();
   log->end_elem();
   log->clear_identities();   // next task will have different CI
@@ -55,6 +55,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
       Reason_Whitebox,         // Whitebox API
       Reason_MustBeCompiled,   // Java callHelper, LinkResolver
       Reason_Bootstrap,        // JVMCI bootstrap
+      Reason_HotCode,          // Hot code clustering by the sweeper
       Reason_Count
   };
 
@@ -68,7 +69,8 @@ class CompileTask : public CHeapObj<mtCompiler> {
       "replay",
       "whitebox",
       "must_be_compiled",
-      "bootstrap"
+      "bootstrap",
+      "hot_code"
     };
     return reason_names[compile_reason];
   }
@@ -90,6 +92,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
 #endif
   int          _comp_level;
   int          _num_inlined_bytecodes;
+  size_t       _arena_peak;   // peak arena memory of the compilation
   nmethodLocker* _code_handle;  // holder of eventual result
   CompileTask* _next, *_prev;
   bool         _is_free;
@@ -121,6 +124,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
   bool         is_complete() const               { return _is_complete; }
   bool         is_blocking() const               { return _is_blocking; }
   bool         is_success() const                { return _is_success; }
+  CompileReason compile_reason() const           { return _compile_reason; }
   bool         can_become_stale() const          {
     switch (_compile_reason) {
       case Reason_BackedgeCount:
@@ -175,6 +179,8 @@ class CompileTask : public CHeapObj<mtCompiler> {
 
   int          num_inlined_bytecodes() const     { return _num_inlined_bytecodes; }
   void         set_num_inlined_bytecodes(int n)  { _num_inlined_bytecodes = n; }
+  size_t       arena_peak() const                { return _arena_peak; }
+  void         set_arena_peak(size_t bytes)      { _arena_peak = bytes; }
 
   CompileTask* next() const                      { return _next; }
   void         set_next(CompileTask* next)       { _next = next; }
@@ -321,6 +321,11 @@ bool CompilerConfig::check_args_consistency(bool status) {
     FLAG_SET_CMDLINE(bool, BackgroundCompilation, false);
   }
 
+  if (ReplayCompiles && ReplayCorpus && FLAG_IS_DEFAULT(CITime)) {
+    // Report the time of the individual compiler phases for the corpus
+    FLAG_SET_ERGO(bool, CITime, true);
+  }
+
 #ifdef COMPILER2
   if (PostLoopMultiversioning && !RangeCheckElimination) {
     if (!FLAG_IS_DEFAULT(PostLoopMultiversioning)) {
@@ -447,5 +452,9 @@ void CompilerConfig::ergo_initialize() {
     // blind guess
     LoopStripMiningIterShortLoop = LoopStripMiningIter / 10;
   }
+  if (DelayCompilerStubsGeneration && (UseAOT JVMCI_ONLY(|| EnableJVMCI))) {
+    // AOT code and JVMCI compilers look up the intrinsic stubs during startup.
+    FLAG_SET_DEFAULT(DelayCompilerStubsGeneration, false);
+  }
 #endif // COMPILER2
 }
@@ -82,6 +82,7 @@ enum OracleCommand {
   DontInlineCommand,
   CompileOnlyCommand,
   LogCommand,
+  LeafNativeCommand,
   OptionCommand,
   QuietCommand,
   HelpCommand,
@@ -97,6 +98,7 @@ static const char * command_names[] = {
   "dontinline",
   "compileonly",
   "log",
+  "leafnative",
   "option",
   "quiet",
   "help"
@@ -302,7 +304,8 @@ static void add_predicate(OracleCommand command, BasicMatcher* bm) {
   }
   bm->set_next(lists[command]);
   lists[command] = bm;
-  if ((command != DontInlineCommand) && (command != InlineCommand)) {
+  if ((command != DontInlineCommand) && (command != InlineCommand) &&
+      (command != LeafNativeCommand)) {
     any_set = true;
   }
   return;
@@ -373,6 +376,10 @@ bool CompilerOracle::should_break_at(const methodHandle& method) {
   return check_predicate(BreakCommand, method);
 }
 
+bool CompilerOracle::should_use_leaf_transition(const methodHandle& method) {
+  return check_predicate(LeafNativeCommand, method);
+}
+
 static OracleCommand parse_command_name(const char * line, int* bytes_read) {
   assert(ARRAY_SIZE(command_names) == OracleCommandCount,
          "command_names size mismatch");
@@ -404,6 +411,9 @@ static void usage() {
   tty->print_cr("  dontinline,<pattern>  - don't inline");
   tty->print_cr("  compileonly,<pattern> - compile only");
   tty->print_cr("  log,<pattern>         - log compilation");
+  tty->print_cr("  leafnative,<pattern>  - call native without a thread state transition;");
+  tty->print_cr("                          it must be short, must not block and must not");
+  tty->print_cr("                          use its JNIEnv, or the VM stops with an error");
   tty->print_cr("  option,<pattern>,<option type>,<option name>,<value>");
   tty->print_cr("                        - set value of custom option");
   tty->print_cr("  option,<pattern>,<bool option name>");
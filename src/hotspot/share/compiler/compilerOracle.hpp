@@ -64,6 +64,11 @@ class CompilerOracle : AllStatic {
   // Tells whether to break when compiling method
   static bool should_break_at(const methodHandle& method);
 
+  // Tells whether the native wrapper of method should call it without a
+  // thread state transition (see SharedRuntime::is_leaf_native). Such a
+  // native must not block or call back through its JNIEnv.
+  static bool should_use_leaf_transition(const methodHandle& method);
+
   // Check to see if this method has option set for it
   static bool has_option_string(const methodHandle& method, const char * option);
 
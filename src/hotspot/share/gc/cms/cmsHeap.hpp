@@ -65,6 +65,10 @@ public:
 
   WorkGang* workers() const { return _workers; }
 
+  // Runtime tasks that can be done in parallel at safepoints use the
+  // young gen workers.
+  virtual WorkGang* get_safepoint_workers() { return _workers; }
+
   virtual void print_gc_threads_on(outputStream* st) const;
   virtual void gc_threads_do(ThreadClosure* tc) const;
   virtual void print_on_error(outputStream* st) const;
@@ -76,6 +76,7 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _concurrent_mark_cleanup_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
     _alloc_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _prev_collection_pause_end_ms(0.0),
+    _dirtied_buffers_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_card_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_scan_hcc_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -100,6 +101,7 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
 
   int index = MIN2(ParallelGCThreads - 1, 7u);
 
+  _dirtied_buffers_rate_ms_seq->add(0.0);
   _rs_length_diff_seq->add(rs_length_diff_defaults[index]);
   _cost_per_card_ms_seq->add(cost_per_card_ms_defaults[index]);
   _cost_scan_hcc_seq->add(0.0);
@@ -127,6 +129,10 @@ int G1Analytics::num_alloc_rate_ms() const {
   return _alloc_rate_ms_seq->num();
 }
 
+int G1Analytics::num_cost_per_card_ms() const {
+  return _cost_per_card_ms_seq->num() - 1;
+}
+
 void G1Analytics::report_concurrent_mark_remark_times_ms(double ms) {
   _concurrent_mark_remark_times_ms->add(ms);
 }
@@ -158,6 +164,10 @@ void G1Analytics::compute_pause_time_ratio(double interval_ms, double pause_time
     (pause_time_ms * _recent_prev_end_times_for_all_gcs_sec->num()) / interval_ms;
 }
 
+void G1Analytics::report_dirtied_buffers_rate_ms(double dirtied_buffers_rate) {
+  _dirtied_buffers_rate_ms_seq->add(dirtied_buffers_rate);
+}
+
 void G1Analytics::report_cost_per_card_ms(double cost_per_card_ms) {
   _cost_per_card_ms_seq->add(cost_per_card_ms);
 }
@@ -222,6 +232,10 @@ double G1Analytics::predict_alloc_rate_ms() const {
   return get_new_prediction(_alloc_rate_ms_seq);
 }
 
+double G1Analytics::predict_dirtied_buffers_rate_ms() const {
+  return get_new_prediction(_dirtied_buffers_rate_ms_seq);
+}
+
 double G1Analytics::predict_cost_per_card_ms() const {
   return get_new_prediction(_cost_per_card_ms_seq);
 }
@@ -45,6 +45,9 @@ class G1Analytics: public CHeapObj<mtGC> {
   TruncatedSeq* _alloc_rate_ms_seq;
   double        _prev_collection_pause_end_ms;
 
+  // Rate at which mutators fill dirty card buffers between pauses.
+  TruncatedSeq* _dirtied_buffers_rate_ms_seq;
+
   TruncatedSeq* _rs_length_diff_seq;
   TruncatedSeq* _cost_per_card_ms_seq;
   TruncatedSeq* _cost_scan_hcc_seq;
@@ -99,6 +102,7 @@ public:
   void report_concurrent_mark_remark_times_ms(double ms);
   void report_concurrent_mark_cleanup_times_ms(double ms);
   void report_alloc_rate_ms(double alloc_rate);
+  void report_dirtied_buffers_rate_ms(double dirtied_buffers_rate);
   void report_cost_per_card_ms(double cost_per_card_ms);
   void report_cost_scan_hcc(double cost_scan_hcc);
   void report_cost_per_entry_ms(double cost_per_entry_ms, bool for_young_gc);
@@ -116,7 +120,11 @@ public:
   double predict_alloc_rate_ms() const;
   int num_alloc_rate_ms() const;
 
+  double predict_dirtied_buffers_rate_ms() const;
+
   double predict_cost_per_card_ms() const;
+  // The number of measured costs per card, excluding the default seed.
+  int num_cost_per_card_ms() const;
 
   double predict_scan_hcc_ms() const;
 
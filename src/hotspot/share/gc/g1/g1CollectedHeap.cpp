@@ -67,6 +67,7 @@
 #include "gc/shared/gcTimer.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/heapPretoucher.hpp"
 #include "gc/shared/generationSpec.hpp"
 #include "gc/shared/isGCActiveMark.hpp"
 #include "gc/shared/oopStorageParState.hpp"
@@ -159,12 +160,20 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 
 // Private methods.
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size,
+                                        bool is_old,
+                                        bool do_expand,
+                                        uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
 
-  HeapRegion* res = _hrm.allocate_free_region(is_old);
+  HeapRegion* res = _hrm.allocate_free_region(is_old, node_index);
+
+  if (res != NULL && _pretoucher != NULL) {
+    // Do not wait for background pre-touching to reach this region.
+    _pretoucher->touch(res->bottom(), res->end());
+  }
 
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -181,7 +190,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm.allocate_free_region(is_old);
+      res = _hrm.allocate_free_region(is_old, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -371,6 +380,9 @@ HeapWord* G1CollectedHeap::humongous_obj_allocate(size_t word_size) {
 
   HeapWord* result = NULL;
   if (first != G1_NO_HRM_INDEX) {
+    if (_pretoucher != NULL) {
+      _pretoucher->touch(region_at(first)->bottom(), region_at(first + obj_regions - 1)->end());
+    }
     result = humongous_obj_allocate_initialize_regions(first, obj_regions, word_size);
     assert(result != NULL, "it should always return a valid result");
 
@@ -1046,7 +1058,7 @@ void G1CollectedHeap::prepare_heap_for_mutators() {
   assert(num_free_regions() == 0, "we should not have added any free regions");
   rebuild_region_sets(false /* free_list_only */);
   abort_refinement();
-  resize_if_necessary_after_full_collection();
+  resize_heap_if_necessary();
 
   // Rebuild the strong code root lists for each region
   rebuild_strong_code_roots();
@@ -1151,7 +1163,7 @@ void G1CollectedHeap::do_full_collection(bool clear_all_soft_refs) {
                                   clear_all_soft_refs);
 }
 
-void G1CollectedHeap::resize_if_necessary_after_full_collection() {
+void G1CollectedHeap::resize_heap_if_necessary() {
   // Capacity, free and used after the GC counted as full regions to
   // include the waste in the following calculations.
   const size_t capacity_after_gc = capacity();
@@ -1208,7 +1220,7 @@ void G1CollectedHeap::resize_if_necessary_after_full_collection() {
     // Don't expand unless it's significant
     size_t expand_bytes = minimum_desired_capacity - capacity_after_gc;
 
-    log_debug(gc, ergo, heap)("Attempt heap expansion (capacity lower than min desired capacity after Full GC). "
+    log_debug(gc, ergo, heap)("Attempt heap expansion (capacity lower than min desired capacity). "
                               "Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B live: " SIZE_FORMAT "B "
                               "min_desired_capacity: " SIZE_FORMAT "B (" UINTX_FORMAT " %%)",
                               capacity_after_gc, used_after_gc, used(), minimum_desired_capacity, MinHeapFreeRatio);
@@ -1220,7 +1232,7 @@ void G1CollectedHeap::resize_if_necessary_after_full_collection() {
     // Capacity too large, compute shrinking size
     size_t shrink_bytes = capacity_after_gc - maximum_desired_capacity;
 
-    log_debug(gc, ergo, heap)("Attempt heap shrinking (capacity higher than max desired capacity after Full GC). "
+    log_debug(gc, ergo, heap)("Attempt heap shrinking (capacity higher than max desired capacity). "
                               "Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B live: " SIZE_FORMAT "B "
                               "maximum_desired_capacity: " SIZE_FORMAT "B (" UINTX_FORMAT " %%)",
                               capacity_after_gc, used_after_gc, used(), maximum_desired_capacity, MaxHeapFreeRatio);
@@ -1380,9 +1392,21 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
                                          HeapRegion::GrainBytes);
   uint num_regions_to_remove = (uint)(shrink_bytes / HeapRegion::GrainBytes);
 
+  LogTarget(Info, gc, heap) lt;
+  size_t rss_before = lt.is_enabled() ? os::current_rss() : 0;
+
+  if (_pretoucher != NULL) {
+    // Background pre-touching must not touch uncommitted memory.
+    _pretoucher->abort();
+  }
   uint num_regions_removed = _hrm.shrink_by(num_regions_to_remove);
   size_t shrunk_bytes = num_regions_removed * HeapRegion::GrainBytes;
 
+  if (lt.is_enabled() && num_regions_removed > 0) {
+    lt.print("Uncommitted %u regions (" SIZE_FORMAT "K), RSS " SIZE_FORMAT "K->" SIZE_FORMAT "K",
+             num_regions_removed, shrunk_bytes / K, rss_before / K, os::current_rss() / K);
+  }
+
 
   log_debug(gc, ergo, heap)("Shrink the heap. requested shrinking amount: " SIZE_FORMAT "B aligned shrinking amount: " SIZE_FORMAT "B attempted shrinking amount: " SIZE_FORMAT "B",
                             shrink_bytes, aligned_shrink_bytes, shrunk_bytes);
@@ -1396,8 +1420,8 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   _verifier->verify_region_sets_optional();
 
-  // We should only reach here at the end of a Full GC which means we
-  // should not not be holding to any GC alloc regions. The method
+  // We should only reach here at the end of a Full GC or during Remark
+  // which means we should not not be holding to any GC alloc regions. The method
   // below will make sure of that and do any remaining clean up.
   _allocator->abandon_gc_alloc_regions();
 
@@ -1437,6 +1461,8 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* collector_policy) :
   _is_alive_closure_cm(this),
   _is_subject_to_discovery_cm(this),
   _bot(NULL),
+  _numa(G1NUMA::create()),
+  _pretoucher(NULL),
   _hot_card_cache(NULL),
   _g1_rem_set(NULL),
   _cr(NULL),
@@ -1585,6 +1611,7 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
   ReservedSpace g1_rs = heap_rs.first_part(max_byte_size);
   size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_mapper(g1_rs,
                                          g1_rs.size(),
@@ -1667,10 +1694,20 @@ jint G1CollectedHeap::initialize() {
   _cm_thread = _cm->cm_thread();
 
   // Now expand into the initial heap size.
+  bool pretouch_in_background = AlwaysPreTouch && AlwaysPreTouchInBackground;
+  heap_storage->set_pretouch_on_commit(!pretouch_in_background);
   if (!expand(init_byte_size, _workers)) {
     vm_shutdown_during_initialization("Failed to allocate initial heap.");
     return JNI_ENOMEM;
   }
+  heap_storage->set_pretouch_on_commit(true);
+  if (pretouch_in_background) {
+    // Chunks are regions so that allocation can claim untouched regions.
+    // Pre-touching starts in post_initialize().
+    _pretoucher = new HeapPretoucher(HeapRegion::GrainBytes, page_size);
+    _pretoucher->add_range(_hrm.reserved().start(),
+                           _hrm.reserved().start() + (size_t)num_regions() * HeapRegion::GrainWords);
+  }
 
   // Perform any initialization actions delegated to the policy.
   g1_policy()->init(this, &_collection_set);
@@ -1757,6 +1794,9 @@ void G1CollectedHeap::stop() {
   if (G1StringDedup::is_enabled()) {
     G1StringDedup::stop();
   }
+  if (_pretoucher != NULL) {
+    _pretoucher->stop();
+  }
 }
 
 void G1CollectedHeap::safepoint_synchronize_begin() {
@@ -1774,6 +1814,9 @@ size_t G1CollectedHeap::conservative_max_heap_alignment() {
 void G1CollectedHeap::post_initialize() {
   CollectedHeap::post_initialize();
   ref_processing_init();
+  if (_pretoucher != NULL) {
+    _pretoucher->start(ParallelGCThreads);
+  }
 }
 
 void G1CollectedHeap::ref_processing_init() {
@@ -1915,6 +1958,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
   switch (cause) {
     case GCCause::_gc_locker:               return GCLockerInvokesConcurrent;
     case GCCause::_g1_humongous_allocation: return true;
+    case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
     default:                                return is_user_requested_concurrent_full_gc(cause);
   }
 }
@@ -2043,7 +2087,14 @@ void G1CollectedHeap::collect(GCCause::Cause cause) {
 
         if (retry_gc) {
           if (GCLocker::is_active_and_needs_gc()) {
-            GCLocker::stall_until_clear();
+            if (Thread::current()->is_Java_thread()) {
+              GCLocker::stall_until_clear();
+            } else {
+              // Only Java threads can stall for the GCLocker. Other
+              // requesters, like the periodic GC, give up; the GCLocker
+              // will start a GC of its own when it is released.
+              retry_gc = false;
+            }
           }
         }
       }
@@ -2944,11 +2995,16 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
         // Initialize the GC alloc regions.
         _allocator->init_gc_alloc_regions(evacuation_info);
 
-        G1ParScanThreadStateSet per_thread_states(this, workers()->active_workers(), collection_set()->young_region_length());
+        G1ParScanThreadStateSet per_thread_states(this,
+                                                  workers()->active_workers(),
+                                                  collection_set()->young_region_length(),
+                                                  collection_set()->optional_region_length());
         pre_evacuate_collection_set();
 
         // Actually do the work...
         evacuate_collection_set(&per_thread_states);
+        evacuate_optional_collection_set(&per_thread_states, target_pause_time_ms);
+        evacuation_info.set_collectionset_regions(collection_set()->region_length());
 
         post_evacuate_collection_set(evacuation_info, &per_thread_states);
 
@@ -3053,6 +3109,7 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
 
     g1_policy()->print_phases();
     heap_transition.print();
+    _numa->print_statistics();
 
     // It is not yet to safe to tell the concurrent mark to
     // start as we have some optional output below. We don't want the
@@ -3227,6 +3284,77 @@ public:
   }
 };
 
+// Evacuates the optional regions most recently moved into the collection set.
+// The references into them found while evacuating the earlier parts of the
+// collection set serve as roots, together with their remembered sets.
+class G1EvacuateOptionalRegionTask : public AbstractGangTask {
+  G1CollectedHeap*         _g1h;
+  G1ParScanThreadStateSet* _pss;
+  RefToScanQueueSet*       _queues;
+  ParallelTaskTerminator   _terminator;
+  uint                     _n_workers;
+
+  void scan_optional_refs(G1ParScanThreadState* pss, uint worker_id) {
+    G1CollectionSet* cset = _g1h->collection_set();
+    G1ScanObjsDuringScanRSClosure obj_cl(_g1h, pss);
+    OopClosure* root_cl = pss->closures()->raw_strong_oops();
+
+    Tickspan scan_time;
+    Tickspan trim_time;
+    size_t num_refs = 0;
+    {
+      G1EvacPhaseWithTrimTimeTracker timer(pss, scan_time, trim_time);
+      for (uint i = cset->optional_increment_start(); i < cset->optional_increment_end(); i++) {
+        num_refs += pss->oops_into_optional_region(i)->oops_do(&obj_cl, root_cl);
+        pss->trim_queue_partially();
+      }
+    }
+
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptScanRefs, worker_id, scan_time.seconds());
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptObjCopy, worker_id, trim_time.seconds());
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptScanRefs, worker_id, num_refs);
+  }
+
+public:
+  G1EvacuateOptionalRegionTask(G1CollectedHeap* g1h, G1ParScanThreadStateSet* per_thread_states, RefToScanQueueSet* task_queues, uint n_workers)
+    : AbstractGangTask("G1 Evacuate Optional Regions"),
+      _g1h(g1h),
+      _pss(per_thread_states),
+      _queues(task_queues),
+      _terminator(n_workers, _queues),
+      _n_workers(n_workers)
+  {}
+
+  void work(uint worker_id) {
+    if (worker_id >= _n_workers) return;  // no work needed this round
+
+    ResourceMark rm;
+    HandleMark   hm;
+
+    G1ParScanThreadState* pss = _pss->state_for_worker(worker_id);
+    pss->set_ref_discoverer(_g1h->ref_processor_stw());
+
+    scan_optional_refs(pss, worker_id);
+    _g1h->g1_rem_set()->scan_rem_set(pss, worker_id,
+                                     G1GCPhaseTimes::OptScanRS,
+                                     G1GCPhaseTimes::OptCodeRoots,
+                                     G1GCPhaseTimes::OptObjCopy);
+
+    double start = os::elapsedTime();
+    G1ParEvacuateFollowersClosure evac(_g1h, pss, _queues, &_terminator);
+    evac.do_void();
+    double elapsed_sec = os::elapsedTime() - start;
+
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptObjCopy, worker_id, elapsed_sec - evac.term_time());
+    p->record_or_add_time_secs(G1GCPhaseTimes::OptTermination, worker_id, evac.term_time());
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::OptTermination, worker_id, evac.term_attempts());
+
+    assert(pss->queue_is_empty(), "should be empty");
+  }
+};
+
 void G1CollectedHeap::print_termination_stats_hdr() {
   log_debug(gc, task, stats)("GC Termination Stats");
   log_debug(gc, task, stats)("     elapsed  --strong roots-- -------termination------- ------waste (KiB)------");
@@ -4043,6 +4171,53 @@ void G1CollectedHeap::evacuate_collection_set(G1ParScanThreadStateSet* per_threa
   phase_times->record_code_root_fixup_time(code_root_fixup_time_ms);
 }
 
+void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states,
+                                                       double target_pause_time_ms) {
+  G1CollectionSet* cset = collection_set();
+  uint num_optional_regions = cset->optional_region_length();
+  if (num_optional_regions == 0) {
+    return;
+  }
+
+  G1GCPhaseTimes* phase_times = g1_policy()->phase_times();
+
+  while (cset->has_optional_regions()) {
+    if (evacuation_failed()) {
+      // Do not add to the work of handling the evacuation failure.
+      break;
+    }
+
+    double time_remaining_ms = g1_policy()->optional_evacuation_time_remaining_ms(target_pause_time_ms);
+    double predicted_time_ms = 0.0;
+    uint num_regions = cset->select_optional_regions(time_remaining_ms, &predicted_time_ms);
+    if (num_regions == 0) {
+      break;
+    }
+
+    // The cards of these regions may have been scanned as part of the
+    // remembered sets of earlier parts of the collection set, but must not be
+    // scanned any more now that the regions are being evacuated.
+    for (uint i = cset->optional_increment_start(); i < cset->optional_increment_end(); i++) {
+      g1_rem_set()->exclude_region_from_scan(cset->optional_region_at(i)->hrm_index());
+    }
+
+    double start_sec = os::elapsedTime();
+    {
+      const uint n_workers = workers()->active_workers();
+      G1EvacuateOptionalRegionTask task(this, per_thread_states, _task_queues, n_workers);
+      workers()->run_task(&task);
+    }
+    double time_ms = (os::elapsedTime() - start_sec) * 1000.0;
+
+    phase_times->record_optional_increment(num_regions, predicted_time_ms, time_ms);
+    log_debug(gc, ergo, cset)("Evacuated optional regions. optional: %u regions, predicted time: %1.2fms, actual time: %1.2fms",
+                              num_regions, predicted_time_ms, time_ms);
+  }
+
+  uint num_abandoned = cset->abandon_optional_regions();
+  phase_times->record_optional_regions(num_optional_regions, num_abandoned);
+}
+
 void G1CollectedHeap::post_evacuate_collection_set(EvacuationInfo& evacuation_info, G1ParScanThreadStateSet* per_thread_states) {
   // Also cleans the card table from temporary duplicate detection information used
   // during UpdateRS/ScanRS.
@@ -4795,13 +4970,15 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = g1_policy()->should_allocate_mutator_region();
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               false /* is_old */,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
@@ -4837,7 +5014,7 @@ bool G1CollectedHeap::has_more_regions(InCSetState dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -4848,7 +5025,8 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, InCSetState d
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             !is_survivor,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
   if (new_alloc_region != NULL) {
     if (is_survivor) {
       new_alloc_region->set_survivor();
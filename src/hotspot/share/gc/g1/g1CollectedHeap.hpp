@@ -40,6 +40,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1InCSetState.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
 #include "gc/g1/heapRegionManager.hpp"
@@ -60,6 +61,7 @@
 // heap subsets that will yield large amounts of garbage.
 
 // Forward declarations
+class HeapPretoucher;
 class HeapRegion;
 class HRRSCleanupTask;
 class GenerationSpec;
@@ -209,6 +211,13 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager _hrm;
 
+  // The NUMA nodes regions are allocated on.
+  G1NUMA* _numa;
+
+  // Pre-touches the initial heap in the background with
+  // AlwaysPreTouchInBackground, NULL otherwise.
+  HeapPretoucher* _pretoucher;
+
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
@@ -383,8 +392,12 @@ private:
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
-  // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // humongous object, set is_old to true. If not, to false. A region on the
+  // NUMA node with the given index is preferred.
+  HeapRegion* new_region(size_t word_size,
+                         bool is_old,
+                         bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -459,13 +472,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(InCSetState dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -481,9 +494,6 @@ private:
   // Callback from VM_G1CollectFull operation, or collect_as_vm_thread.
   virtual void do_full_collection(bool clear_all_soft_refs);
 
-  // Resize the heap if necessary after a full collection.
-  void resize_if_necessary_after_full_collection();
-
   // Callback from VM_G1CollectForAllocation operation.
   // This function does everything necessary/possible to satisfy a
   // failed allocation request (including collection, expansion, etc.)
@@ -532,6 +542,8 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const { return _numa; }
+
   G1HeapVerifier* verifier() {
     return _verifier;
   }
@@ -547,6 +559,10 @@ public:
   // (Rounds up to a HeapRegion boundary.)
   bool expand(size_t expand_bytes, WorkGang* pretouch_workers = NULL, double* expand_time_ms = NULL);
 
+  // Expand or shrink the heap to honor Min/MaxHeapFreeRatio; called at
+  // the end of a Full GC and at Remark.
+  void resize_heap_if_necessary();
+
   // Returns the PLAB statistics for a given destination.
   inline G1EvacStats* alloc_buffer_stats(InCSetState dest);
 
@@ -582,6 +598,9 @@ public:
   void register_old_region_with_cset(HeapRegion* r) {
     _in_cset_fast_test.set_in_old(r->hrm_index());
   }
+  void register_optional_region_with_cset(HeapRegion* r) {
+    _in_cset_fast_test.set_optional(r->hrm_index());
+  }
   void clear_in_cset(const HeapRegion* hr) {
     _in_cset_fast_test.clear(hr);
   }
@@ -738,6 +757,10 @@ private:
 
   // Actually do the work of evacuating the collection set.
   void evacuate_collection_set(G1ParScanThreadStateSet* per_thread_states);
+  // Evacuate the optional regions of the collection set in increments for
+  // as long as time remains in the pause.
+  void evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states,
+                                        double target_pause_time_ms);
 
   void pre_evacuate_collection_set();
   void post_evacuate_collection_set(EvacuationInfo& evacuation_info, G1ParScanThreadStateSet* pss);
@@ -26,6 +26,8 @@
 #include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1CollectorState.hpp"
+#include "gc/g1/g1GCPhaseTimes.hpp"
+#include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1Policy.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
@@ -62,6 +64,10 @@ G1CollectionSet::G1CollectionSet(G1CollectedHeap* g1h, G1Policy* policy) :
   _collection_set_regions(NULL),
   _collection_set_cur_length(0),
   _collection_set_max_length(0),
+  _optional_regions(NULL),
+  _optional_region_length(0),
+  _optional_increment_start(0),
+  _optional_increment_end(0),
   // Incremental CSet attributes
   _inc_build_state(Inactive),
   _inc_bytes_used_before(0),
@@ -75,6 +81,9 @@ G1CollectionSet::~G1CollectionSet() {
   if (_collection_set_regions != NULL) {
     FREE_C_HEAP_ARRAY(uint, _collection_set_regions);
   }
+  if (_optional_regions != NULL) {
+    FREE_C_HEAP_ARRAY(HeapRegion*, _optional_regions);
+  }
   delete _cset_chooser;
 }
 
@@ -95,6 +104,7 @@ void G1CollectionSet::initialize(uint max_region_length) {
   guarantee(_collection_set_regions == NULL, "Must only initialize once.");
   _collection_set_max_length = max_region_length;
   _collection_set_regions = NEW_C_HEAP_ARRAY(uint, max_region_length, mtGC);
+  _optional_regions = NEW_C_HEAP_ARRAY(HeapRegion*, max_region_length, mtGC);
 }
 
 void G1CollectionSet::set_recorded_rs_lengths(size_t rs_lengths) {
@@ -105,7 +115,7 @@ void G1CollectionSet::set_recorded_rs_lengths(size_t rs_lengths) {
 void G1CollectionSet::add_old_region(HeapRegion* hr) {
   assert_at_safepoint_on_vm_thread();
 
-  assert(_inc_build_state == Active, "Precondition");
+  assert(_inc_build_state == Active || hr->index_in_opt_cset() != -1, "Precondition");
   assert(hr->is_old(), "the region should be old");
 
   assert(!hr->in_collection_set(), "should not already be in the CSet");
@@ -120,6 +130,72 @@ void G1CollectionSet::add_old_region(HeapRegion* hr) {
   _old_region_length += 1;
 }
 
+void G1CollectionSet::add_optional_region(HeapRegion* hr) {
+  assert_at_safepoint_on_vm_thread();
+
+  assert(_inc_build_state == Active, "Precondition");
+  assert(hr->is_old(), "the region should be old");
+  assert(!hr->in_collection_set(), "should not already be in the CSet");
+
+  _g1h->register_optional_region_with_cset(hr);
+
+  hr->set_index_in_opt_cset(_optional_region_length);
+  _optional_regions[_optional_region_length++] = hr;
+  assert(_optional_region_length <= _collection_set_max_length, "Optional regions now more than maximum size.");
+}
+
+uint G1CollectionSet::select_optional_regions(double time_remaining_ms, double* predicted_time_ms) {
+  assert_at_safepoint_on_vm_thread();
+
+  _optional_increment_start = _optional_increment_end;
+  *predicted_time_ms = 0.0;
+
+  while (has_optional_regions()) {
+    HeapRegion* hr = _optional_regions[_optional_increment_end];
+    double region_time_ms = predict_region_elapsed_time_ms(hr);
+    if (*predicted_time_ms + region_time_ms > time_remaining_ms) {
+      break;
+    }
+    *predicted_time_ms += region_time_ms;
+    if (_g1h->hr_printer()->is_active()) {
+      _g1h->hr_printer()->cset(hr);
+    }
+    _g1h->old_set_remove(hr);
+    add_old_region(hr);
+    _optional_increment_end++;
+  }
+
+  uint num_regions = _optional_increment_end - _optional_increment_start;
+  log_debug(gc, ergo, cset)("Add optional regions to CSet. optional: %u regions, predicted time: %1.2fms, remaining time: %1.2fms, left: %u regions",
+                            num_regions, *predicted_time_ms, time_remaining_ms, _optional_region_length - _optional_increment_end);
+  return num_regions;
+}
+
+uint G1CollectionSet::abandon_optional_regions() {
+  assert_at_safepoint_on_vm_thread();
+
+  uint num_abandoned = _optional_region_length - _optional_increment_end;
+  // Push the regions back in reverse order to restore the order of the
+  // CollectionSetChooser.
+  for (uint i = _optional_region_length; i > _optional_increment_end; i--) {
+    HeapRegion* hr = _optional_regions[i - 1];
+    _g1h->clear_in_cset(hr);
+    cset_chooser()->push(hr);
+  }
+  for (uint i = 0; i < _optional_region_length; i++) {
+    _optional_regions[i]->set_index_in_opt_cset(-1);
+  }
+  if (num_abandoned > 0) {
+    log_debug(gc, ergo, cset)("Abandon optional regions. optional: %u regions, abandoned: %u regions",
+                              _optional_region_length, num_abandoned);
+  }
+
+  _optional_region_length = 0;
+  _optional_increment_start = 0;
+  _optional_increment_end = 0;
+  return num_abandoned;
+}
+
 // Initialize the per-collection-set information
 void G1CollectionSet::start_incremental_building() {
   assert(_collection_set_cur_length == 0, "Collection set must be empty before starting a new collection set.");
@@ -391,6 +467,8 @@ double G1CollectionSet::finalize_young_part(double target_pause_time_ms, G1Survi
   // collection set's current size
   set_recorded_rs_lengths(_inc_recorded_rs_lengths);
 
+  phase_times()->record_predicted_pause_time_ms(base_time_ms + _inc_predicted_elapsed_time_ms);
+
   double young_end_time_sec = os::elapsedTime();
   phase_times()->record_young_cset_choice_time_ms((young_end_time_sec - young_start_time_sec) * 1000.0);
 
@@ -410,6 +488,7 @@ static int compare_region_idx(const uint a, const uint b) {
 void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
   double non_young_start_time_sec = os::elapsedTime();
   double predicted_old_time_ms = 0.0;
+  double predicted_optional_time_ms = 0.0;
 
   if (collector_state()->in_mixed_phase()) {
     cset_chooser()->verify();
@@ -419,9 +498,14 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
     uint expensive_region_num = 0;
     bool check_time_remaining = _policy->adaptive_young_list_length();
 
+    // Once the remaining time drops below this threshold, further regions are
+    // only added as optional regions: predictions are not exact, so these are
+    // only evacuated if the mandatory part finishes in time.
+    double optional_threshold_ms = time_remaining_ms * G1OptionalCSetPercent / 100.0;
+
     HeapRegion* hr = cset_chooser()->peek();
     while (hr != NULL) {
-      if (old_region_length() >= max_old_cset_length) {
+      if (old_region_length() + optional_region_length() >= max_old_cset_length) {
         // Added maximum number of old regions to the CSet.
         log_debug(gc, ergo, cset)("Finish adding old regions to CSet (old CSet region num reached max). old %u regions, max %u regions",
                                   old_region_length(), max_old_cset_length);
@@ -444,6 +528,7 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
       }
 
       double predicted_time_ms = predict_region_elapsed_time_ms(hr);
+      bool is_optional = false;
       if (check_time_remaining) {
         if (predicted_time_ms > time_remaining_ms) {
           // Too expensive for the current CSet.
@@ -460,6 +545,9 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
           // We'll add it anyway given that we haven't reached the
           // minimum number of old regions.
           expensive_region_num += 1;
+        } else if (old_region_length() >= min_old_cset_length &&
+                   time_remaining_ms - predicted_time_ms < optional_threshold_ms) {
+          is_optional = true;
         }
       } else {
         if (old_region_length() >= min_old_cset_length) {
@@ -474,10 +562,15 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
 
       // We will add this region to the CSet.
       time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
-      predicted_old_time_ms += predicted_time_ms;
       cset_chooser()->pop(); // already have region via peek()
-      _g1h->old_set_remove(hr);
-      add_old_region(hr);
+      if (is_optional) {
+        predicted_optional_time_ms += predicted_time_ms;
+        add_optional_region(hr);
+      } else {
+        predicted_old_time_ms += predicted_time_ms;
+        _g1h->old_set_remove(hr);
+        add_old_region(hr);
+      }
 
       hr = cset_chooser()->peek();
     }
@@ -499,8 +592,10 @@ void G1CollectionSet::finalize_old_part(double time_remaining_ms) {
 
   stop_incremental_building();
 
-  log_debug(gc, ergo, cset)("Finish choosing CSet. old: %u regions, predicted old region time: %1.2fms, time remaining: %1.2f",
-                            old_region_length(), predicted_old_time_ms, time_remaining_ms);
+  log_debug(gc, ergo, cset)("Finish choosing CSet. old: %u regions, optional: %u regions, predicted old region time: %1.2fms, predicted optional region time: %1.2fms, time remaining: %1.2f",
+                            old_region_length(), optional_region_length(), predicted_old_time_ms, predicted_optional_time_ms, time_remaining_ms);
+
+  phase_times()->add_predicted_pause_time_ms(predicted_old_time_ms);
 
   double non_young_end_time_sec = os::elapsedTime();
   phase_times()->record_non_young_cset_choice_time_ms((non_young_end_time_sec - non_young_start_time_sec) * 1000.0);
@@ -56,6 +56,18 @@ class G1CollectionSet {
   volatile size_t _collection_set_cur_length;
   size_t _collection_set_max_length;
 
+  // Old regions chosen for a mixed collection in addition to the mandatory
+  // part of the collection set, in the order they were taken from the
+  // CollectionSetChooser. They are moved into the collection set in increments
+  // after the mandatory part has been evacuated, but only while time remains
+  // in the pause; the remaining ones are handed back to the CollectionSetChooser.
+  HeapRegion** _optional_regions;
+  uint _optional_region_length;
+  // Optional regions [_optional_increment_start, _optional_increment_end) are
+  // the ones most recently moved into the collection set.
+  uint _optional_increment_start;
+  uint _optional_increment_end;
+
   // The number of bytes in the collection set before the pause. Set from
   // the incrementally built collection set at the start of an evacuation
   // pause, and incremented in finalize_old_part() when adding old regions
@@ -109,6 +121,9 @@ class G1CollectionSet {
   double predict_region_elapsed_time_ms(HeapRegion* hr);
 
   void verify_young_cset_indices() const NOT_DEBUG_RETURN;
+
+  // Add old region "hr" to the optional part of the collection set.
+  void add_optional_region(HeapRegion* hr);
 public:
   G1CollectionSet(G1CollectedHeap* g1h, G1Policy* policy);
   ~G1CollectionSet();
@@ -132,6 +147,24 @@ public:
   uint survivor_region_length() const { return _survivor_region_length; }
   uint old_region_length() const      { return _old_region_length;      }
 
+  uint optional_region_length() const { return _optional_region_length; }
+
+  // Whether there are optional regions that have not been moved into the
+  // collection set yet.
+  bool has_optional_regions() const {
+    return _optional_increment_end < _optional_region_length;
+  }
+
+  // The range of indices of the optional regions most recently moved into
+  // the collection set.
+  uint optional_increment_start() const { return _optional_increment_start; }
+  uint optional_increment_end() const   { return _optional_increment_end; }
+
+  HeapRegion* optional_region_at(uint index) const {
+    assert(index < _optional_region_length, "Optional region index %u out of bounds %u", index, _optional_region_length);
+    return _optional_regions[index];
+  }
+
   // Incremental collection set support
 
   // Initialize incremental collection set info.
@@ -175,6 +208,16 @@ public:
   // Add old region "hr" to the collection set.
   void add_old_region(HeapRegion* hr);
 
+  // Move optional regions into the collection set as long as their combined
+  // predicted evacuation time fits into time_remaining_ms. Returns the number
+  // of regions moved, and their predicted evacuation time in predicted_time_ms.
+  uint select_optional_regions(double time_remaining_ms, double* predicted_time_ms);
+
+  // Hand the optional regions that have not been moved into the collection set
+  // back to the CollectionSetChooser, and forget about all optional regions.
+  // Returns the number of regions handed back.
+  uint abandon_optional_regions();
+
   // Update information about hr in the aggregated information for
   // the incrementally built collection set.
   void update_young_region_prediction(HeapRegion* hr, size_t new_rs_length);
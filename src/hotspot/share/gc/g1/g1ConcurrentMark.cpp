@@ -1202,6 +1202,10 @@ void G1ConcurrentMark::remark() {
       ClassLoaderDataGraph::purge();
     }
 
+    // Uncommit regions freed by marking, e.g. after a periodic GC of an
+    // idle application.
+    _g1h->resize_heap_if_necessary();
+
     compute_new_sizes();
 
     verify_during_pause(G1HeapVerifier::G1VerifyRemark, VerifyOption_G1UsePrevMarking, "Remark after");
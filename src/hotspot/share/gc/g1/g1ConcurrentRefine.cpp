@@ -198,15 +198,17 @@ inline size_t deactivation_level(const Thresholds& t) { return t.second; }
 
 static Thresholds calc_thresholds(size_t green_zone,
                                   size_t yellow_zone,
+                                  uint wanted_threads,
                                   uint worker_i) {
   double yellow_size = yellow_zone - green_zone;
   double step = yellow_size / G1ConcurrentRefine::max_num_threads();
-  if (worker_i == 0) {
-    // Potentially activate worker 0 more aggressively, to keep
-    // available buffers near green_zone value.  When yellow_size is
-    // large we don't want to allow a full step to accumulate before
-    // doing any processing, as that might lead to significantly more
-    // than green_zone buffers to be processed by update_rs.
+  if (worker_i == 0 || worker_i < wanted_threads) {
+    // Potentially activate worker 0, and the other workers needed to keep
+    // up with the mutators, more aggressively, to keep available buffers
+    // near green_zone value.  When yellow_size is large we don't want to
+    // allow a full step to accumulate before doing any processing, as that
+    // might lead to significantly more than green_zone buffers to be
+    // processed by update_rs.
     step = MIN2(step, ParallelGCThreads / 2.0);
   }
   size_t activate_offset = static_cast<size_t>(ceil(step * (worker_i + 1)));
@@ -223,7 +225,8 @@ G1ConcurrentRefine::G1ConcurrentRefine(size_t green_zone,
   _green_zone(green_zone),
   _yellow_zone(yellow_zone),
   _red_zone(red_zone),
-  _min_yellow_zone_size(min_yellow_zone_size)
+  _min_yellow_zone_size(min_yellow_zone_size),
+  _wanted_threads(MIN2(1u, max_num_threads()))
 {
   assert_zone_constraints_gyr(green_zone, yellow_zone, red_zone);
 }
@@ -340,6 +343,36 @@ static size_t calc_new_green_zone(size_t green,
   return green;
 }
 
+// Derive the green zone from the pause time model: the number of buffers
+// update_rs is predicted to process within its time goal. The zone moves
+// by at most a factor of two per pause to damp noisy predictions, and does
+// not grow while update_rs exceeds its goal.
+size_t G1ConcurrentRefine::calc_predicted_green_zone(size_t green,
+                                                     double update_rs_time,
+                                                     double predicted_buffer_ms,
+                                                     double goal_ms) {
+  assert(predicted_buffer_ms > 0.0, "must have a prediction");
+  double target = goal_ms / predicted_buffer_ms;
+  target = MIN2(target, green * 2.0 + 1.0);
+  if (update_rs_time > goal_ms) {
+    target = MIN2(target, (double)green);
+  }
+  target = MAX2(target, green / 2.0);
+  return MIN2(static_cast<size_t>(target), max_green_zone);
+}
+
+// The number of refinement threads needed to refine buffers as fast as
+// mutators complete them. A single refinement thread takes about as long
+// for a buffer as all update_rs workers together.
+uint G1ConcurrentRefine::calc_wanted_threads(double predicted_buffer_ms,
+                                             uint update_rs_workers,
+                                             double dirtied_buffers_rate_ms) {
+  double thread_buffer_ms = predicted_buffer_ms * MAX2(update_rs_workers, 1u);
+  double wanted = ceil(dirtied_buffers_rate_ms * thread_buffer_ms);
+  wanted = MIN2(wanted, (double)G1ConcurrentRefine::max_num_threads());
+  return static_cast<uint>(MAX2(wanted, 1.0));
+}
+
 static size_t calc_new_yellow_zone(size_t green, size_t min_yellow_size) {
   size_t size = green * 2;
   size = MAX2(size, min_yellow_size);
@@ -352,19 +385,41 @@ static size_t calc_new_red_zone(size_t green, size_t yellow) {
 
 void G1ConcurrentRefine::update_zones(double update_rs_time,
                                       size_t update_rs_processed_buffers,
-                                      double goal_ms) {
+                                      double goal_ms,
+                                      double predicted_buffer_ms,
+                                      uint update_rs_workers,
+                                      double dirtied_buffers_rate_ms) {
   log_trace( CTRL_TAGS )("Updating Refinement Zones: "
                          "update_rs time: %.3fms, "
                          "update_rs buffers: " SIZE_FORMAT ", "
-                         "update_rs goal time: %.3fms",
+                         "update_rs goal time: %.3fms, "
+                         "predicted buffer time: %.3fms, "
+                         "dirtied buffers rate: %.3f/ms",
                          update_rs_time,
                          update_rs_processed_buffers,
-                         goal_ms);
-
-  _green_zone = calc_new_green_zone(_green_zone,
-                                    update_rs_time,
-                                    update_rs_processed_buffers,
-                                    goal_ms);
+                         goal_ms,
+                         predicted_buffer_ms,
+                         dirtied_buffers_rate_ms);
+
+  if (predicted_buffer_ms > 0.0) {
+    _green_zone = calc_predicted_green_zone(_green_zone,
+                                            update_rs_time,
+                                            predicted_buffer_ms,
+                                            goal_ms);
+    if (max_num_threads() > 0) {
+      _wanted_threads = calc_wanted_threads(predicted_buffer_ms,
+                                            update_rs_workers,
+                                            dirtied_buffers_rate_ms);
+    }
+  } else {
+    // Too few measurements for the model; step the green zone towards the
+    // goal and activate only the primary thread early.
+    _green_zone = calc_new_green_zone(_green_zone,
+                                      update_rs_time,
+                                      update_rs_processed_buffers,
+                                      goal_ms);
+    _wanted_threads = MIN2(1u, max_num_threads());
+  }
   _yellow_zone = calc_new_yellow_zone(_green_zone, _min_yellow_zone_size);
   _red_zone = calc_new_red_zone(_green_zone, _yellow_zone);
 
@@ -372,17 +427,26 @@ void G1ConcurrentRefine::update_zones(double update_rs_time,
   LOG_ZONES("Updated Refinement Zones: "
             "green: " SIZE_FORMAT ", "
             "yellow: " SIZE_FORMAT ", "
-            "red: " SIZE_FORMAT,
-            _green_zone, _yellow_zone, _red_zone);
+            "red: " SIZE_FORMAT ", "
+            "wanted threads: %u",
+            _green_zone, _yellow_zone, _red_zone, _wanted_threads);
 }
 
 void G1ConcurrentRefine::adjust(double update_rs_time,
                                 size_t update_rs_processed_buffers,
-                                double goal_ms) {
+                                double goal_ms,
+                                double predicted_buffer_ms,
+                                uint update_rs_workers,
+                                double dirtied_buffers_rate_ms) {
   DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
 
   if (G1UseAdaptiveConcRefinement) {
-    update_zones(update_rs_time, update_rs_processed_buffers, goal_ms);
+    update_zones(update_rs_time,
+                 update_rs_processed_buffers,
+                 goal_ms,
+                 predicted_buffer_ms,
+                 update_rs_workers,
+                 dirtied_buffers_rate_ms);
 
     // Change the barrier params
     if (max_num_threads() == 0) {
@@ -403,16 +467,17 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
   } else {
     dcqs.set_completed_queue_padding(0);
   }
+  // Does not wake the primary thread if there is nothing to refine.
   dcqs.notify_if_necessary();
 }
 
 size_t G1ConcurrentRefine::activation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, _wanted_threads, worker_id);
   return activation_level(thresholds);
 }
 
 size_t G1ConcurrentRefine::deactivation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, _wanted_threads, worker_id);
   return deactivation_level(thresholds);
 }
 
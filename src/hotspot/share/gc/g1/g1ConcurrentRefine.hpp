@@ -68,6 +68,8 @@ public:
 // Refinement thread n activates thread n+1 if the instance of this class determines there
 // is enough work available. Threads deactivate themselves if the current amount of
 // completed buffers falls below their individual threshold.
+// No thread is woken while the queue is empty, so an idle application does not pay
+// for refinement at all.
 class G1ConcurrentRefine : public CHeapObj<mtGC> {
   G1ConcurrentRefineThreadControl _thread_control;
   /*
@@ -92,6 +94,11 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   size_t _red_zone;
   size_t _min_yellow_zone_size;
 
+  // Number of threads expected to keep up with the rate at which mutators
+  // dirty cards. These are activated right above the green zone; the
+  // remaining threads are spread over the yellow zone to absorb bursts.
+  uint _wanted_threads;
+
   G1ConcurrentRefine(size_t green_zone,
                      size_t yellow_zone,
                      size_t red_zone,
@@ -100,7 +107,10 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   // Update green/yellow/red zone values based on how well goals are being met.
   void update_zones(double update_rs_time,
                     size_t update_rs_processed_buffers,
-                    double goal_ms);
+                    double goal_ms,
+                    double predicted_buffer_ms,
+                    uint update_rs_workers,
+                    double dirtied_buffers_rate_ms);
 
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_buffers);
@@ -116,10 +126,30 @@ public:
   void stop();
 
   // Adjust refinement thresholds based on work done during the pause and the goal time.
-  void adjust(double update_rs_time, size_t update_rs_processed_buffers, double goal_ms);
+  // predicted_buffer_ms is the predicted pause time contribution of a single buffer
+  // processed by update_rs_workers threads, or 0.0 while the prediction is not yet
+  // based on enough measurements, and dirtied_buffers_rate_ms the predicted
+  // number of buffers completed by mutators per ms.
+  void adjust(double update_rs_time,
+              size_t update_rs_processed_buffers,
+              double goal_ms,
+              double predicted_buffer_ms,
+              uint update_rs_workers,
+              double dirtied_buffers_rate_ms);
 
   size_t activation_threshold(uint worker_id) const;
   size_t deactivation_threshold(uint worker_id) const;
+
+  // The green zone derived from the pause time model, and the number of
+  // refinement threads needed to keep up with the mutators.  Used by
+  // update_zones(); public for testing.
+  static size_t calc_predicted_green_zone(size_t green,
+                                          double update_rs_time,
+                                          double predicted_buffer_ms,
+                                          double goal_ms);
+  static uint calc_wanted_threads(double predicted_buffer_ms,
+                                  uint update_rs_workers,
+                                  double dirtied_buffers_rate_ms);
   // Perform a single refinement step. Called by the refinement threads when woken up.
   bool do_refinement_step(uint worker_id);
 
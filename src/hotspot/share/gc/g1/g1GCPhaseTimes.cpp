@@ -98,6 +98,23 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _termination_attempts = new WorkerDataArray<size_t>(max_gc_threads, "Termination Attempts:");
   _gc_par_phases[Termination]->link_thread_work_items(_termination_attempts);
 
+  _gc_par_phases[OptScanRefs] = new WorkerDataArray<double>(max_gc_threads, "Optional Scan Refs (ms):");
+  _gc_par_phases[OptScanRS] = new WorkerDataArray<double>(max_gc_threads, "Optional Scan RS (ms):");
+  _gc_par_phases[OptCodeRoots] = new WorkerDataArray<double>(max_gc_threads, "Optional Code Root Scanning (ms):");
+  _gc_par_phases[OptObjCopy] = new WorkerDataArray<double>(max_gc_threads, "Optional Object Copy (ms):");
+  _gc_par_phases[OptTermination] = new WorkerDataArray<double>(max_gc_threads, "Optional Termination (ms):");
+
+  _opt_scan_refs_scanned_refs = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Refs:");
+  _gc_par_phases[OptScanRefs]->link_thread_work_items(_opt_scan_refs_scanned_refs);
+  _opt_scan_rs_scanned_cards = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Cards:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_scanned_cards, ScanRSScannedCards);
+  _opt_scan_rs_claimed_cards = new WorkerDataArray<size_t>(max_gc_threads, "Claimed Cards:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_claimed_cards, ScanRSClaimedCards);
+  _opt_scan_rs_skipped_cards = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Cards:");
+  _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_scan_rs_skipped_cards, ScanRSSkippedCards);
+  _opt_termination_attempts = new WorkerDataArray<size_t>(max_gc_threads, "Termination Attempts:");
+  _gc_par_phases[OptTermination]->link_thread_work_items(_opt_termination_attempts);
+
   if (UseStringDeduplication) {
     _gc_par_phases[StringDedupQueueFixup] = new WorkerDataArray<double>(max_gc_threads, "Queue Fixup (ms):");
     _gc_par_phases[StringDedupTableFixup] = new WorkerDataArray<double>(max_gc_threads, "Table Fixup (ms):");
@@ -149,6 +166,13 @@ void G1GCPhaseTimes::reset() {
   _cur_fast_reclaim_humongous_reclaimed = 0;
   _cur_verify_before_time_ms = 0.0;
   _cur_verify_after_time_ms = 0.0;
+  _recorded_predicted_pause_time_ms = 0.0;
+  _cur_optional_evac_time_ms = 0.0;
+  _cur_optional_predicted_time_ms = 0.0;
+  _cur_optional_increments = 0;
+  _cur_optional_regions = 0;
+  _cur_optional_regions_evacuated = 0;
+  _cur_optional_regions_abandoned = 0;
 
   for (int i = 0; i < GCParPhasesSentinel; i++) {
     if (_gc_par_phases[i] != NULL) {
@@ -225,18 +249,31 @@ void G1GCPhaseTimes::add_time_secs(GCParPhases phase, uint worker_i, double secs
   _gc_par_phases[phase]->add(worker_i, secs);
 }
 
-void G1GCPhaseTimes::record_or_add_objcopy_time_secs(uint worker_i, double secs) {
-  if (_gc_par_phases[ObjCopy]->get(worker_i) == _gc_par_phases[ObjCopy]->uninitialized()) {
-    record_time_secs(ObjCopy, worker_i, secs);
+void G1GCPhaseTimes::record_or_add_time_secs(GCParPhases phase, uint worker_i, double secs) {
+  if (_gc_par_phases[phase]->get(worker_i) == _gc_par_phases[phase]->uninitialized()) {
+    record_time_secs(phase, worker_i, secs);
   } else {
-    add_time_secs(ObjCopy, worker_i, secs);
+    add_time_secs(phase, worker_i, secs);
   }
 }
 
+void G1GCPhaseTimes::record_or_add_objcopy_time_secs(uint worker_i, double secs) {
+  record_or_add_time_secs(ObjCopy, worker_i, secs);
+}
+
 void G1GCPhaseTimes::record_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index) {
   _gc_par_phases[phase]->set_thread_work_item(worker_i, count, index);
 }
 
+void G1GCPhaseTimes::record_or_add_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index) {
+  WorkerDataArray<size_t>* work_items = _gc_par_phases[phase]->thread_work_items(index);
+  if (work_items->get(worker_i) == work_items->uninitialized()) {
+    record_thread_work_item(phase, worker_i, count, index);
+  } else {
+    _gc_par_phases[phase]->add_thread_work_item(worker_i, count, index);
+  }
+}
+
 // return the average time for a phase in milliseconds
 double G1GCPhaseTimes::average_time_ms(GCParPhases phase) {
   return _gc_par_phases[phase]->average() * 1000.0;
@@ -374,6 +411,31 @@ double G1GCPhaseTimes::print_evacuate_collection_set() const {
   return sum_ms;
 }
 
+double G1GCPhaseTimes::print_evacuate_optional_collection_set() const {
+  const double sum_ms = _cur_optional_evac_time_ms;
+
+  if (_cur_optional_regions == 0) {
+    return sum_ms;
+  }
+
+  info_time("Evacuate Optional Collection Set", sum_ms);
+
+  log_debug(gc, phases)("%sOptional Regions: %u (Evacuated: %u, Abandoned: %u, Increments: %u)",
+                        Indents[2], _cur_optional_regions, _cur_optional_regions_evacuated,
+                        _cur_optional_regions_abandoned, _cur_optional_increments);
+  if (_cur_optional_increments > 0) {
+    log_debug(gc, phases)("%sOptional Prediction: " TIME_FORMAT " (Actual: " TIME_FORMAT ")",
+                          Indents[2], _cur_optional_predicted_time_ms, sum_ms);
+    debug_phase(_gc_par_phases[OptScanRefs]);
+    debug_phase(_gc_par_phases[OptScanRS]);
+    debug_phase(_gc_par_phases[OptCodeRoots]);
+    debug_phase(_gc_par_phases[OptObjCopy]);
+    debug_phase(_gc_par_phases[OptTermination]);
+  }
+
+  return sum_ms;
+}
+
 double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
   const double evac_fail_handling = _cur_evac_fail_recalc_used +
                                     _cur_evac_fail_remove_self_forwards;
@@ -456,9 +518,16 @@ void G1GCPhaseTimes::print() {
   double accounted_ms = 0.0;
   accounted_ms += print_pre_evacuate_collection_set();
   accounted_ms += print_evacuate_collection_set();
+  accounted_ms += print_evacuate_optional_collection_set();
   accounted_ms += print_post_evacuate_collection_set();
   print_other(accounted_ms);
 
+  if (_recorded_predicted_pause_time_ms > 0.0) {
+    log_debug(gc, phases)("%sPause Prediction: " TIME_FORMAT " (Actual: " TIME_FORMAT ", Error: %+.1lf%%)",
+                          Indents[1], _recorded_predicted_pause_time_ms, _gc_pause_time_ms,
+                          (_gc_pause_time_ms - _recorded_predicted_pause_time_ms) * 100.0 / _recorded_predicted_pause_time_ms);
+  }
+
   if (_cur_verify_after_time_ms > 0.0) {
     debug_time("Verify After", _cur_verify_after_time_ms);
   }
@@ -70,6 +70,11 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     Other,
     GCWorkerTotal,
     GCWorkerEnd,
+    OptScanRefs,
+    OptScanRS,
+    OptCodeRoots,
+    OptObjCopy,
+    OptTermination,
     StringDedupQueueFixup,
     StringDedupTableFixup,
     RedirtyCards,
@@ -108,6 +113,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   WorkerDataArray<size_t>* _termination_attempts;
 
+  WorkerDataArray<size_t>* _opt_scan_refs_scanned_refs;
+  WorkerDataArray<size_t>* _opt_scan_rs_scanned_cards;
+  WorkerDataArray<size_t>* _opt_scan_rs_claimed_cards;
+  WorkerDataArray<size_t>* _opt_scan_rs_skipped_cards;
+  WorkerDataArray<size_t>* _opt_termination_attempts;
+
   WorkerDataArray<size_t>* _redirtied_cards;
 
   double _cur_collection_par_time_ms;
@@ -162,6 +173,16 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   double _cur_verify_before_time_ms;
   double _cur_verify_after_time_ms;
 
+  // The predicted time of the pause for the collection set actually evacuated.
+  double _recorded_predicted_pause_time_ms;
+
+  double _cur_optional_evac_time_ms;
+  double _cur_optional_predicted_time_ms;
+  uint _cur_optional_increments;
+  uint _cur_optional_regions;
+  uint _cur_optional_regions_evacuated;
+  uint _cur_optional_regions_abandoned;
+
   ReferenceProcessorPhaseTimes _ref_phase_times;
 
   double worker_time(GCParPhases phase, uint worker);
@@ -184,6 +205,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double print_pre_evacuate_collection_set() const;
   double print_evacuate_collection_set() const;
+  double print_evacuate_optional_collection_set() const;
   double print_post_evacuate_collection_set() const;
   void print_other(double accounted_ms) const;
 
@@ -198,10 +220,15 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   // add a number of seconds to a phase
   void add_time_secs(GCParPhases phase, uint worker_i, double secs);
 
+  // record the time of a phase that may be executed several times during a pause
+  void record_or_add_time_secs(GCParPhases phase, uint worker_i, double secs);
+
   void record_or_add_objcopy_time_secs(uint worker_i, double secs);
 
   void record_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index = 0);
 
+  void record_or_add_thread_work_item(GCParPhases phase, uint worker_i, size_t count, uint index = 0);
+
   // return the average time for a phase in milliseconds
   double average_time_ms(GCParPhases phase);
 
@@ -320,6 +347,27 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_verify_after_time_ms = time_ms;
   }
 
+  void record_predicted_pause_time_ms(double time_ms) {
+    _recorded_predicted_pause_time_ms = time_ms;
+  }
+
+  void add_predicted_pause_time_ms(double time_ms) {
+    _recorded_predicted_pause_time_ms += time_ms;
+  }
+
+  void record_optional_increment(uint num_regions, double predicted_time_ms, double time_ms) {
+    _cur_optional_increments++;
+    _cur_optional_regions_evacuated += num_regions;
+    _cur_optional_predicted_time_ms += predicted_time_ms;
+    _recorded_predicted_pause_time_ms += predicted_time_ms;
+    _cur_optional_evac_time_ms += time_ms;
+  }
+
+  void record_optional_regions(uint num_regions, uint num_abandoned) {
+    _cur_optional_regions = num_regions;
+    _cur_optional_regions_abandoned = num_abandoned;
+  }
+
   void inc_external_accounted_time_ms(double time_ms) {
     _external_accounted_time_ms += time_ms;
   }
@@ -336,6 +384,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     return _cur_collection_par_time_ms;
   }
 
+  double cur_optional_evac_time_ms() {
+    return _cur_optional_evac_time_ms;
+  }
+
   double cur_clear_ct_time_ms() {
     return _cur_clear_ct_time_ms;
   }
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1NUMA.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
+
+G1NUMA* G1NUMA::_inst = NULL;
+
+size_t G1NUMA::region_size() const {
+  assert(_region_size > 0, "Heap region size is not yet set");
+  return _region_size;
+}
+
+size_t G1NUMA::page_size() const {
+  assert(_page_size > 0, "Page size is not yet set");
+  return _page_size;
+}
+
+G1NUMA* G1NUMA::create() {
+  guarantee(_inst == NULL, "Should be called once.");
+  _inst = new G1NUMA();
+
+  // Region memory is bound to nodes using the libnuma support of the Linux
+  // port; other platforms only get the interleaving of UseNUMAInterleaving.
+  LINUX_ONLY(_inst->initialize(UseNUMA);)
+  NOT_LINUX(_inst->initialize(false);)
+
+  return _inst;
+}
+
+G1NUMA::G1NUMA() :
+  _node_id_to_index_map(NULL), _len_node_id_to_index_map(0),
+  _node_ids(NULL), _num_active_node_ids(0),
+  _region_size(0), _page_size(0), _stats(NULL) {
+}
+
+void G1NUMA::initialize_without_numa() {
+  // Without NUMA support all memory is considered to be on a single node
+  // with id and index 0.
+  _num_active_node_ids = 1;
+  _node_ids = NEW_C_HEAP_ARRAY(int, _num_active_node_ids, mtGC);
+  _node_ids[0] = 0;
+  _len_node_id_to_index_map = 1;
+  _node_id_to_index_map = NEW_C_HEAP_ARRAY(uint, _len_node_id_to_index_map, mtGC);
+  _node_id_to_index_map[0] = 0;
+}
+
+void G1NUMA::initialize(bool use_numa) {
+  if (!use_numa) {
+    initialize_without_numa();
+    return;
+  }
+
+  size_t num_node_ids = os::numa_get_groups_num();
+  _node_ids = NEW_C_HEAP_ARRAY(int, num_node_ids, mtGC);
+  _num_active_node_ids = (uint)os::numa_get_leaf_groups(_node_ids, num_node_ids);
+
+  if (_num_active_node_ids <= 1) {
+    FREE_C_HEAP_ARRAY(int, _node_ids);
+    initialize_without_numa();
+    return;
+  }
+
+  int max_node_id = 0;
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    max_node_id = MAX2(max_node_id, _node_ids[i]);
+  }
+
+  _len_node_id_to_index_map = max_node_id + 1;
+  _node_id_to_index_map = NEW_C_HEAP_ARRAY(uint, _len_node_id_to_index_map, mtGC);
+  for (int i = 0; i < _len_node_id_to_index_map; i++) {
+    _node_id_to_index_map[i] = UnknownNodeIndex;
+  }
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _node_id_to_index_map[_node_ids[i]] = i;
+  }
+
+  _stats = new G1NUMAStats(_node_ids, _num_active_node_ids);
+}
+
+G1NUMA::~G1NUMA() {
+  delete _stats;
+  FREE_C_HEAP_ARRAY(uint, _node_id_to_index_map);
+  FREE_C_HEAP_ARRAY(int, _node_ids);
+}
+
+void G1NUMA::set_region_info(size_t region_size, size_t page_size) {
+  _region_size = region_size;
+  _page_size = page_size;
+
+  if (is_enabled()) {
+    log_info(gc, heap, numa)("NUMA aware allocation on %u nodes, %s",
+                             _num_active_node_ids,
+                             region_size >= page_size ? "one node per region" : "one node per page");
+  }
+}
+
+uint G1NUMA::index_of_node_id(int node_id) const {
+  if (node_id < 0 || node_id >= _len_node_id_to_index_map) {
+    return UnknownNodeIndex;
+  }
+  return _node_id_to_index_map[node_id];
+}
+
+uint G1NUMA::index_of_current_thread() const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  uint node_index = index_of_node_id(os::numa_get_group_id());
+  // CPUs may be located on a node without memory, or one we are not bound to.
+  return node_index == UnknownNodeIndex ? 0 : node_index;
+}
+
+uint G1NUMA::preferred_node_index_for_index(uint region_index) const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  if (region_size() >= page_size()) {
+    // A region spans one or more pages, so alternate nodes per region.
+    return region_index % _num_active_node_ids;
+  } else {
+    // A page contains several regions, which all need to prefer the node
+    // the page is bound to.
+    size_t regions_per_page = page_size() / region_size();
+    return (uint)((region_index / regions_per_page) % _num_active_node_ids);
+  }
+}
+
+void G1NUMA::request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index) {
+  if (!is_enabled() || size_in_bytes == 0) {
+    return;
+  }
+
+  uint node_index = preferred_node_index_for_index(region_index);
+
+  assert(is_aligned(aligned_address, os::vm_page_size()),
+         "Given address (" PTR_FORMAT ") should be aligned.", p2i(aligned_address));
+  assert(is_aligned(size_in_bytes, os::vm_page_size()),
+         "Given size (" SIZE_FORMAT ") should be aligned.", size_in_bytes);
+
+  log_trace(gc, heap, numa)("Request memory [" PTR_FORMAT ", " PTR_FORMAT ") to be NUMA id (%d)",
+                            p2i(aligned_address), p2i((char*)aligned_address + size_in_bytes),
+                            _node_ids[node_index]);
+  os::numa_make_local((char*)aligned_address, size_in_bytes, _node_ids[node_index]);
+}
+
+uint G1NUMA::max_search_depth() const {
+  // Look at a few regions per node; with pages larger than regions, regions
+  // of the same node come in runs of the number of regions per page.
+  return 3 * MAX2((uint)(page_size() / region_size()), 1u) * num_active_nodes();
+}
+
+void G1NUMA::update_statistics(G1NUMAStats::NodeDataItems phase,
+                               uint requested_node_index,
+                               uint allocated_node_index) {
+  if (_stats == NULL || requested_node_index == AnyNodeIndex) {
+    return;
+  }
+  _stats->update(phase, requested_node_index, allocated_node_index);
+}
+
+void G1NUMA::copy_statistics(G1NUMAStats::NodeDataItems phase,
+                             uint requested_node_index,
+                             size_t* allocated_stat) {
+  if (_stats == NULL) {
+    return;
+  }
+  size_t num_requested = 0;
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    num_requested += allocated_stat[i];
+  }
+  _stats->update(phase, requested_node_index, num_requested, allocated_stat[requested_node_index]);
+}
+
+void G1NUMA::print_statistics() const {
+  if (_stats == NULL) {
+    return;
+  }
+  _stats->print_statistics();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1NUMA_HPP
+#define SHARE_VM_GC_G1_G1NUMA_HPP
+
+#include "gc/g1/g1NUMAStats.hpp"
+#include "memory/allocation.hpp"
+
+// Keeps track of the active NUMA nodes G1 allocates memory on. Nodes are
+// referred to by a dense node index in [0, num_active_nodes()), which is used
+// to index the per-node allocation regions and PLABs.
+//
+// Heap regions are assigned to nodes round-robin at page granularity: region
+// memory is bound to its preferred node when it is committed, so the node of a
+// region follows from its index without querying the OS.
+class G1NUMA : public CHeapObj<mtGC> {
+  // Map from node id to node index; UnknownNodeIndex for node ids that are
+  // not active.
+  uint* _node_id_to_index_map;
+  int _len_node_id_to_index_map;
+
+  // Active node ids, indexed by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+
+  // Heap region size and the page size of the heap.
+  size_t _region_size;
+  size_t _page_size;
+
+  G1NUMAStats* _stats;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+  void initialize_without_numa();
+
+  size_t region_size() const;
+  size_t page_size() const;
+
+public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Set the heap region size and the page size of the heap. Must be called
+  // before any heap memory is committed.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  // Returns whether G1 allocates NUMA aware, i.e. there is more than one
+  // active node.
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  uint num_active_nodes() const { return _num_active_node_ids; }
+
+  // Returns the active node ids.
+  const int* node_ids() const { return _node_ids; }
+
+  // Returns the node index of the given node id, or UnknownNodeIndex if the
+  // node is not active.
+  uint index_of_node_id(int node_id) const;
+
+  // Returns the node index of the node the current thread runs on. Threads
+  // running on a node G1 does not allocate memory on get node index 0.
+  uint index_of_current_thread() const;
+
+  // Returns the node index the memory of the region with the given index is
+  // bound to.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Bind the memory of the region with the given index to its preferred
+  // node. The memory must not have been touched yet.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // Maximum number of free regions to examine when looking for a region on
+  // a particular node.
+  uint max_search_depth() const;
+
+  // Record a request for memory on requested_node_index that has been
+  // satisfied on allocated_node_index. Requests for AnyNodeIndex are ignored.
+  void update_statistics(G1NUMAStats::NodeDataItems phase, uint requested_node_index, uint allocated_node_index);
+  // Record requests per node index from the given array of length
+  // num_active_nodes(); the requests for requested_node_index are hits.
+  void copy_statistics(G1NUMAStats::NodeDataItems phase, uint requested_node_index, size_t* allocated_stat);
+
+  // Log and reset the statistics.
+  void print_statistics() const;
+};
+
+#endif // SHARE_VM_GC_G1_G1NUMA_HPP
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1NUMAStats.hpp"
+#include "logging/log.hpp"
+#include "logging/logStream.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+
+const char* G1NUMAStats::phase_to_explanatory_string(NodeDataItems phase) {
+  switch (phase) {
+    case NewRegionAlloc:
+      return "Placement match ratio";
+    case LocalObjProcessAtCopyToSurv:
+      return "Worker task locality match ratio";
+    default:
+      ShouldNotReachHere();
+      return "";
+  }
+}
+
+G1NUMAStats::G1NUMAStats(const int* node_ids, uint num_node_ids) :
+  _node_ids(node_ids), _num_node_ids(num_node_ids) {
+  for (int i = 0; i < NodeDataItemsSentinel; i++) {
+    _requested[i] = NEW_C_HEAP_ARRAY(size_t, _num_node_ids, mtGC);
+    _hits[i] = NEW_C_HEAP_ARRAY(size_t, _num_node_ids, mtGC);
+    clear((NodeDataItems)i);
+  }
+}
+
+G1NUMAStats::~G1NUMAStats() {
+  for (int i = 0; i < NodeDataItemsSentinel; i++) {
+    FREE_C_HEAP_ARRAY(size_t, _requested[i]);
+    FREE_C_HEAP_ARRAY(size_t, _hits[i]);
+  }
+}
+
+void G1NUMAStats::clear(NodeDataItems phase) {
+  for (uint i = 0; i < _num_node_ids; i++) {
+    _requested[phase][i] = 0;
+    _hits[phase][i] = 0;
+  }
+}
+
+void G1NUMAStats::update(NodeDataItems phase, uint requested_node_index, uint allocated_node_index) {
+  update(phase, requested_node_index, 1, requested_node_index == allocated_node_index ? 1 : 0);
+}
+
+void G1NUMAStats::update(NodeDataItems phase, uint requested_node_index, size_t num_requested, size_t num_hits) {
+  assert(requested_node_index < _num_node_ids, "Node index %u out of bounds %u", requested_node_index, _num_node_ids);
+  assert(num_hits <= num_requested, "More hits " SIZE_FORMAT " than requests " SIZE_FORMAT, num_hits, num_requested);
+  if (num_requested == 0) {
+    return;
+  }
+  Atomic::add(num_requested, &_requested[phase][requested_node_index]);
+  if (num_hits > 0) {
+    Atomic::add(num_hits, &_hits[phase][requested_node_index]);
+  }
+}
+
+void G1NUMAStats::print_info(NodeDataItems phase) {
+  LogTarget(Debug, gc, heap, numa) lt;
+
+  if (lt.is_enabled()) {
+    size_t total_requested = 0;
+    size_t total_hits = 0;
+    for (uint i = 0; i < _num_node_ids; i++) {
+      total_requested += _requested[phase][i];
+      total_hits += _hits[phase][i];
+    }
+    if (total_requested == 0) {
+      return;
+    }
+
+    LogStream ls(lt);
+    ls.print("%s: %3.0f%% " SIZE_FORMAT "/" SIZE_FORMAT " (",
+             phase_to_explanatory_string(phase),
+             percent_of(total_hits, total_requested), total_hits, total_requested);
+    for (uint i = 0; i < _num_node_ids; i++) {
+      ls.print("%s%d: %3.0f%% " SIZE_FORMAT "/" SIZE_FORMAT,
+               i == 0 ? "" : ", ",
+               _node_ids[i],
+               percent_of(_hits[phase][i], _requested[phase][i]),
+               _hits[phase][i], _requested[phase][i]);
+    }
+    ls.print_cr(")");
+  }
+}
+
+void G1NUMAStats::print_statistics() {
+  for (int i = 0; i < NodeDataItemsSentinel; i++) {
+    print_info((NodeDataItems)i);
+    clear((NodeDataItems)i);
+  }
+}
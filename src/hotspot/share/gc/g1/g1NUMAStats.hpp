@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1NUMASTATS_HPP
+#define SHARE_VM_GC_G1_G1NUMASTATS_HPP
+
+#include "memory/allocation.hpp"
+
+// Per NUMA node hit and miss counters of G1. A hit is a request for memory
+// on a given node that has been satisfied with memory on that node.
+class G1NUMAStats : public CHeapObj<mtGC> {
+public:
+  enum NodeDataItems {
+    // Allocation of a new region with a preferred node.
+    NewRegionAlloc,
+    // Objects copied into survivor space by a GC worker running on the
+    // same node as the source region of the object.
+    LocalObjProcessAtCopyToSurv,
+    NodeDataItemsSentinel
+  };
+
+private:
+  const int* _node_ids;
+  uint _num_node_ids;
+
+  // Number of requests and hits per item and node index.
+  size_t* _requested[NodeDataItemsSentinel];
+  size_t* _hits[NodeDataItemsSentinel];
+
+  static const char* phase_to_explanatory_string(NodeDataItems phase);
+
+  void print_info(NodeDataItems phase);
+
+public:
+  G1NUMAStats(const int* node_ids, uint num_node_ids);
+  ~G1NUMAStats();
+
+  void clear(NodeDataItems phase);
+
+  // Record a single request for memory on requested_node_index that has been
+  // satisfied on allocated_node_index.
+  void update(NodeDataItems phase, uint requested_node_index, uint allocated_node_index);
+  // Record num_requested requests on requested_node_index, num_hits of them
+  // satisfied on that node. May be called concurrently.
+  void update(NodeDataItems phase, uint requested_node_index, size_t num_requested, size_t num_hits);
+
+  // Log and reset the statistics of all items.
+  void print_statistics();
+};
+
+#endif // SHARE_VM_GC_G1_G1NUMASTATS_HPP
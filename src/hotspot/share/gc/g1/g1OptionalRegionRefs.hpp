@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_HPP
+#define SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/stack.hpp"
+
+class OopClosure;
+
+// The references into a single optional collection set region found by one
+// GC worker while evacuating earlier parts of the collection set. References
+// from roots are kept apart from references located in the heap as they need
+// to be processed by different closures.
+class G1OptionalRegionRefs : public CHeapObj<mtGC> {
+  Stack<oop*, mtGC>       _roots;
+  Stack<narrowOop*, mtGC> _croots;
+  Stack<oop*, mtGC>       _oops;
+  Stack<narrowOop*, mtGC> _coops;
+
+  template <typename T> inline size_t drain(Stack<T*, mtGC>* refs, OopClosure* cl);
+
+public:
+  inline void push_root(oop* p)       { _roots.push(p); }
+  inline void push_root(narrowOop* p) { _croots.push(p); }
+  inline void push_oop(oop* p)        { _oops.push(p); }
+  inline void push_oop(narrowOop* p)  { _coops.push(p); }
+
+  // Applies obj_cl to all recorded heap references and root_cl to all recorded
+  // roots, emptying the lists. Returns the number of references processed.
+  inline size_t oops_do(OopClosure* obj_cl, OopClosure* root_cl);
+};
+
+#endif // SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_HPP
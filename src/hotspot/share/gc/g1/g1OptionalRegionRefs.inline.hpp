@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_INLINE_HPP
+#define SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_INLINE_HPP
+
+#include "gc/g1/g1OptionalRegionRefs.hpp"
+#include "memory/iterator.hpp"
+#include "utilities/stack.inline.hpp"
+
+template <typename T>
+inline size_t G1OptionalRegionRefs::drain(Stack<T*, mtGC>* refs, OopClosure* cl) {
+  size_t num_refs = 0;
+  while (!refs->is_empty()) {
+    cl->do_oop(refs->pop());
+    num_refs++;
+  }
+  return num_refs;
+}
+
+inline size_t G1OptionalRegionRefs::oops_do(OopClosure* obj_cl, OopClosure* root_cl) {
+  size_t num_refs = 0;
+  num_refs += drain(&_roots, root_cl);
+  num_refs += drain(&_croots, root_cl);
+  num_refs += drain(&_oops, obj_cl);
+  num_refs += drain(&_coops, obj_cl);
+  return num_refs;
+}
+
+#endif // SHARE_VM_GC_G1_G1OPTIONALREGIONREFS_INLINE_HPP
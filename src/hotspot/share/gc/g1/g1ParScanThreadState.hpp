@@ -37,6 +37,7 @@
 #include "oops/oop.hpp"
 #include "utilities/ticks.hpp"
 
+class G1OptionalRegionRefs;
 class G1PLABAllocator;
 class G1EvacuationRootClosures;
 class HeapRegion;
@@ -75,6 +76,19 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   // available for allocation.
   bool _old_gen_is_full;
 
+  // References into the optional regions of the collection set, one entry
+  // per optional region.
+  G1OptionalRegionRefs* _oops_into_optional_regions;
+  uint _num_optional_regions;
+
+  G1NUMA* _numa;
+  // NUMA node index of the worker thread, sampled when the worker starts
+  // evacuating as GC worker threads are not bound to nodes.
+  uint _worker_node_index;
+  // Number of objects copied to survivor space per NUMA node index of their
+  // source region. NULL if NUMA is not enabled.
+  size_t* _obj_alloc_stat;
+
 #define PADDING_ELEM_NUM (DEFAULT_CACHE_LINE_SIZE / sizeof(size_t))
 
   DirtyCardQueue& dirty_card_queue()             { return _dcq;  }
@@ -89,7 +103,7 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   }
 
 public:
-  G1ParScanThreadState(G1CollectedHeap* g1h, uint worker_id, size_t young_cset_length);
+  G1ParScanThreadState(G1CollectedHeap* g1h, uint worker_id, size_t young_cset_length, uint optional_cset_length);
   virtual ~G1ParScanThreadState();
 
   void set_ref_discoverer(ReferenceDiscoverer* rd) { _scanner.set_ref_discoverer(rd); }
@@ -122,6 +136,14 @@ public:
   G1EvacuationRootClosures* closures() { return _closures; }
   uint worker_id() { return _worker_id; }
 
+  // Remember a reference from a root or from within the heap to an object in
+  // an optional region, to be processed if that region is evacuated later.
+  template <class T> inline void remember_root_into_optional_region(T* p);
+  template <class T> inline void remember_reference_into_optional_region(T* p);
+
+  // The references into the optional region with the given index.
+  G1OptionalRegionRefs* oops_into_optional_region(uint index);
+
   // Returns the current amount of waste due to alignment or not being able to fit
   // objects within LABs and the undo waste.
   virtual void waste(size_t& wasted, size_t& undo_wasted);
@@ -173,6 +195,14 @@ private:
 
   inline void dispatch_reference(StarTask ref);
 
+  // Upper bound of G1EvacuationBatchSize.
+  static const uint MaxEvacuationBatchSize = 16;
+
+  // Prefetches the header of the object the given task refers to, which is
+  // about to be forwarded and copied.
+  template <class T> inline void prefetch_referent(T* p);
+  inline void prefetch_reference(StarTask ref);
+
   // Tries to allocate word_sz in the PLAB of the next "generation" after trying to
   // allocate into dest. State is the original (source) cset state for the object
   // that is allocated for. Previous_plab_refill_failed indicates whether previously
@@ -183,13 +213,18 @@ private:
   HeapWord* allocate_in_next_plab(InCSetState const state,
                                   InCSetState* dest,
                                   size_t word_sz,
-                                  bool previous_plab_refill_failed);
+                                  bool previous_plab_refill_failed,
+                                  uint node_index);
 
   inline InCSetState next_state(InCSetState const state, markOop const m, uint& age);
 
   void report_promotion_event(InCSetState const dest_state,
                               oop const old, size_t word_sz, uint age,
-                              HeapWord * const obj_ptr) const;
+                              HeapWord * const obj_ptr, uint node_index) const;
+
+  void initialize_numa_stats();
+  void flush_numa_stats();
+  inline void update_numa_stats(uint node_index);
 
   inline bool needs_partial_trimming() const;
   inline bool is_partially_trimmed() const;
@@ -215,11 +250,12 @@ class G1ParScanThreadStateSet : public StackObj {
   G1ParScanThreadState** _states;
   size_t* _surviving_young_words_total;
   size_t _young_cset_length;
+  uint _optional_cset_length;
   uint _n_workers;
   bool _flushed;
 
  public:
-  G1ParScanThreadStateSet(G1CollectedHeap* g1h, uint n_workers, size_t young_cset_length);
+  G1ParScanThreadStateSet(G1CollectedHeap* g1h, uint n_workers, size_t young_cset_length, uint optional_cset_length);
   ~G1ParScanThreadStateSet();
 
   void flush();
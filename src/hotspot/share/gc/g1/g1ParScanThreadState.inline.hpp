@@ -25,10 +25,12 @@
 #ifndef SHARE_VM_GC_G1_G1PARSCANTHREADSTATE_INLINE_HPP
 #define SHARE_VM_GC_G1_G1PARSCANTHREADSTATE_INLINE_HPP
 
+#include "gc/g1/g1OptionalRegionRefs.inline.hpp"
 #include "gc/g1/g1ParScanThreadState.hpp"
 #include "gc/g1/g1RemSet.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 template <class T> void G1ParScanThreadState::do_oop_evac(T* p) {
   // Reference should not be NULL here as such are never pushed to the task queue.
@@ -138,6 +140,21 @@ inline void G1ParScanThreadState::dispatch_reference(StarTask ref) {
   }
 }
 
+template <class T> inline void G1ParScanThreadState::prefetch_referent(T* p) {
+  oop obj = RawAccess<IS_NOT_NULL>::oop_load(p);
+  // The mark word is read and then written when forwarding the object, and
+  // the klass next to it is read to get the object size.
+  Prefetch::write(obj->mark_addr_raw(), 0);
+}
+
+inline void G1ParScanThreadState::prefetch_reference(StarTask ref) {
+  if (ref.is_narrow()) {
+    prefetch_referent((narrowOop*)ref);
+  } else if (!has_partial_array_mask((oop*)ref)) {
+    prefetch_referent((oop*)ref);
+  }
+}
+
 void G1ParScanThreadState::steal_and_trim_queue(RefToScanQueueSet *task_queues) {
   StarTask stolen_task;
   while (task_queues->steal(_worker_id, &_hash_seed, stolen_task)) {
@@ -168,9 +185,22 @@ inline void G1ParScanThreadState::trim_queue_to_threshold(uint threshold) {
     }
   }
 
-  while (_refs->pop_local(ref, threshold)) {
-    dispatch_reference(ref);
-  }
+  // Take references in batches and prefetch all their objects before
+  // evacuating the first one, so that the cache misses on the headers of
+  // the objects overlap instead of stalling one after another.
+  assert(G1EvacuationBatchSize <= MaxEvacuationBatchSize, "must be");
+  StarTask batch[MaxEvacuationBatchSize];
+  uint num_refs;
+  do {
+    num_refs = 0;
+    while (num_refs < G1EvacuationBatchSize && _refs->pop_local(batch[num_refs], threshold)) {
+      prefetch_reference(batch[num_refs]);
+      num_refs++;
+    }
+    for (uint i = 0; i < num_refs; i++) {
+      dispatch_reference(batch[i]);
+    }
+  } while (num_refs > 0);
 }
 
 inline void G1ParScanThreadState::trim_queue_partially() {
@@ -193,4 +223,24 @@ inline void G1ParScanThreadState::reset_trim_ticks() {
   _trim_ticks = Tickspan();
 }
 
+template <class T>
+inline void G1ParScanThreadState::remember_root_into_optional_region(T* p) {
+  oop o = RawAccess<IS_NOT_NULL>::oop_load(p);
+  uint index = _g1h->heap_region_containing(o)->index_in_opt_cset();
+  oops_into_optional_region(index)->push_root(p);
+}
+
+template <class T>
+inline void G1ParScanThreadState::remember_reference_into_optional_region(T* p) {
+  oop o = RawAccess<IS_NOT_NULL>::oop_load(p);
+  uint index = _g1h->heap_region_containing(o)->index_in_opt_cset();
+  oops_into_optional_region(index)->push_oop(p);
+}
+
+inline void G1ParScanThreadState::update_numa_stats(uint node_index) {
+  if (_obj_alloc_stat != NULL) {
+    _obj_alloc_stat[node_index]++;
+  }
+}
+
 #endif // SHARE_VM_GC_G1_G1PARSCANTHREADSTATE_INLINE_HPP
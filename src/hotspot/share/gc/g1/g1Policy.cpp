@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1Analytics.hpp"
+#include "gc/g1/g1BarrierSet.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1ConcurrentMark.hpp"
@@ -60,6 +61,8 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _reserve_factor((double) G1ReservePercent / 100.0),
   _reserve_regions(0),
   _rs_lengths_prediction(0),
+  _mutator_completed_buffers(0),
+  _dirtied_buffers(0),
   _initial_mark_to_mixed(),
   _collection_set(NULL),
   _g1h(NULL),
@@ -427,6 +430,8 @@ void G1Policy::record_full_collection_end() {
   double full_gc_time_ms = full_gc_time_sec * 1000.0;
 
   _analytics->update_recent_gc_times(end_sec, full_gc_time_ms);
+  // The periodic GC measures idle time from the end of the last collection.
+  _collection_pause_end_millis = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
 
   collector_state()->set_in_full_gc(false);
 
@@ -466,6 +471,10 @@ void G1Policy::record_collection_pause_start(double start_time_sec) {
   phase_times()->record_cur_collection_start_sec(start_time_sec);
   _pending_cards = _g1h->pending_card_num();
 
+  size_t mutator_completed_buffers = G1BarrierSet::dirty_card_queue_set().mutator_completed_buffers();
+  _dirtied_buffers = mutator_completed_buffers - _mutator_completed_buffers;
+  _mutator_completed_buffers = mutator_completed_buffers;
+
   _collection_set->reset_bytes_used_before();
   _bytes_copied_during_gc = 0;
 
@@ -513,7 +522,7 @@ double G1Policy::non_young_other_time_ms() const {
 }
 
 double G1Policy::other_time_ms(double pause_time_ms) const {
-  return pause_time_ms - phase_times()->cur_collection_par_time_ms();
+  return pause_time_ms - phase_times()->cur_collection_par_time_ms() - phase_times()->cur_optional_evac_time_ms();
 }
 
 double G1Policy::constant_other_time_ms(double pause_time_ms) const {
@@ -595,6 +604,10 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
     double alloc_rate_ms = (double) regions_allocated / app_time_ms;
     _analytics->report_alloc_rate_ms(alloc_rate_ms);
 
+    // Likewise all dirty card buffers completed by mutator threads were
+    // filled since the previous GC.
+    _analytics->report_dirtied_buffers_rate_ms((double) _dirtied_buffers / app_time_ms);
+
     double interval_ms =
       (end_time_sec - _analytics->last_known_gc_end_time_sec()) * 1000.0;
     _analytics->update_recent_gc_times(end_time_sec, pause_time_ms);
@@ -669,7 +682,7 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
 
     if (_collection_set->bytes_used_before() > freed_bytes) {
       size_t copied_bytes = _collection_set->bytes_used_before() - freed_bytes;
-      double average_copy_time = average_time_ms(G1GCPhaseTimes::ObjCopy);
+      double average_copy_time = average_time_ms(G1GCPhaseTimes::ObjCopy) + average_time_ms(G1GCPhaseTimes::OptObjCopy);
       double cost_per_byte_ms = average_copy_time / (double) copied_bytes;
       _analytics->report_cost_per_byte_ms(cost_per_byte_ms, collector_state()->mark_or_rebuild_in_progress());
     }
@@ -729,9 +742,19 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
   } else {
     update_rs_time_goal_ms -= scan_hcc_time_ms;
   }
+  // Until the cost per card has been measured a few times its prediction
+  // mostly reflects the default tables; keep the model out of refinement.
+  const int min_cost_per_card_samples = 3;
+  double predicted_buffer_ms = 0.0;
+  if (_analytics->num_cost_per_card_ms() >= min_cost_per_card_samples) {
+    predicted_buffer_ms = _analytics->predict_cost_per_card_ms() * G1UpdateBufferSize;
+  }
   _g1h->concurrent_refine()->adjust(average_time_ms(G1GCPhaseTimes::UpdateRS),
                                     phase_times()->sum_thread_work_items(G1GCPhaseTimes::UpdateRS),
-                                    update_rs_time_goal_ms);
+                                    update_rs_time_goal_ms,
+                                    predicted_buffer_ms,
+                                    _g1h->workers()->active_workers(),
+                                    _analytics->predict_dirtied_buffers_rate_ms());
 
   cset_chooser()->verify();
 }
@@ -858,6 +881,12 @@ double G1Policy::predict_region_elapsed_time_ms(HeapRegion* hr,
   return region_elapsed_time_ms;
 }
 
+double G1Policy::optional_evacuation_time_remaining_ms(double target_pause_time_ms) const {
+  double elapsed_ms = (os::elapsedTime() - phase_times()->cur_collection_start_sec()) * 1000.0;
+  // Leave room for the work following evacuation in this pause.
+  return target_pause_time_ms - elapsed_ms - _analytics->predict_constant_other_time_ms();
+}
+
 bool G1Policy::should_allocate_mutator_region() const {
   uint young_list_length = _g1h->young_regions_count();
   uint young_list_target_length = _young_list_target_length;
@@ -106,6 +106,12 @@ class G1Policy: public CHeapObj<mtGC> {
 
   size_t _pending_cards;
 
+  // Number of dirty card buffers completed by mutators as of the start of
+  // the last pause, and how many of them were completed since the pause
+  // before that.
+  size_t _mutator_completed_buffers;
+  size_t _dirtied_buffers;
+
   G1InitialMarkToMixedTimeTracker _initial_mark_to_mixed;
 
   bool should_update_surv_rate_group_predictors() {
@@ -141,6 +147,10 @@ public:
 
   double predict_survivor_regions_evac_time() const;
 
+  // The time left in the current pause for evacuating optional collection set
+  // regions, given the pause time target.
+  double optional_evacuation_time_remaining_ms(double target_pause_time_ms) const;
+
   void cset_regions_freed() {
     bool update = should_update_surv_rate_group_predictors();
 
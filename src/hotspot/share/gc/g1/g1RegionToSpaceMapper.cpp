@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1BiasedArray.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/virtualspace.hpp"
@@ -40,7 +41,9 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _storage(rs, used_size, page_size),
   _region_granularity(region_granularity),
   _listener(NULL),
-  _commit_map(rs.size() * commit_factor / region_granularity, mtGC) {
+  _commit_map(rs.size() * commit_factor / region_granularity, mtGC),
+  _memory_type(type),
+  _pretouch_on_commit(true) {
   guarantee(is_power_of_2(page_size), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
 
@@ -70,7 +73,10 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   virtual void commit_regions(uint start_idx, size_t num_regions, WorkGang* pretouch_gang) {
     size_t const start_page = (size_t)start_idx * _pages_per_region;
     bool zero_filled = _storage.commit(start_page, num_regions * _pages_per_region);
-    if (AlwaysPreTouch) {
+    for (uint i = start_idx; i < start_idx + num_regions; i++) {
+      numa_request_on_node(i, 1);
+    }
+    if (AlwaysPreTouch && _pretouch_on_commit) {
       _storage.pretouch(start_page, num_regions * _pages_per_region, pretouch_gang);
     }
     _commit_map.set_range(start_idx, start_idx + num_regions);
@@ -137,13 +143,14 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
           num_committed++;
         }
         zero_filled = _storage.commit(idx, 1);
+        numa_request_on_node((uint)(idx * _regions_per_page), _regions_per_page);
       }
       all_zero_filled &= zero_filled;
 
       _refcounts.set_by_index(idx, old_refcount + 1);
       _commit_map.set_bit(i);
     }
-    if (AlwaysPreTouch && num_committed > 0) {
+    if (AlwaysPreTouch && _pretouch_on_commit && num_committed > 0) {
       _storage.pretouch(first_committed, num_committed, pretouch_gang);
     }
     fire_on_commit(start_idx, num_regions, all_zero_filled);
@@ -170,6 +177,15 @@ void G1RegionToSpaceMapper::fire_on_commit(uint start_idx, size_t num_regions, b
   }
 }
 
+void G1RegionToSpaceMapper::numa_request_on_node(uint region_index, size_t num_regions) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (_memory_type != mtJavaHeap || !numa->is_enabled()) {
+    return;
+  }
+  char* start = (char*)_storage.reserved().start() + (size_t)region_index * _region_granularity;
+  numa->request_memory_on_node(start, num_regions * _region_granularity, region_index);
+}
+
 G1RegionToSpaceMapper* G1RegionToSpaceMapper::create_mapper(ReservedSpace rs,
                                                             size_t actual_size,
                                                             size_t page_size,
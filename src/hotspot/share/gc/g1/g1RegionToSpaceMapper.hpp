@@ -53,9 +53,19 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   CHeapBitMap _commit_map;
 
+  MemoryType _memory_type;
+
+  // Whether to pre-touch memory as it is committed with AlwaysPreTouch.
+  bool _pretouch_on_commit;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t used_size, size_t page_size, size_t region_granularity, size_t commit_factor, MemoryType type);
 
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
+
+  // Bind the just committed memory of num_regions regions starting at
+  // region_index to the NUMA node preferred for region_index. Only the
+  // memory of the Java heap is bound to nodes.
+  void numa_request_on_node(uint region_index, size_t num_regions);
  public:
   MemRegion reserved() { return _storage.reserved(); }
 
@@ -64,6 +74,10 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
 
   void set_mapping_changed_listener(G1MappingChangedListener* listener) { _listener = listener; }
 
+  // Turned off while committing the initial heap if it is pre-touched in
+  // the background instead.
+  void set_pretouch_on_commit(bool value) { _pretouch_on_commit = value; }
+
   virtual ~G1RegionToSpaceMapper() {}
 
   bool is_committed(uintptr_t idx) const {
@@ -27,6 +27,7 @@
 
 #include "gc/g1/dirtyCardQueue.hpp"
 #include "gc/g1/g1CardTable.hpp"
+#include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1OopClosures.hpp"
 #include "gc/g1/g1RemSetSummary.hpp"
 #include "gc/g1/heapRegion.hpp"
@@ -60,10 +61,6 @@ private:
 
   G1RemSetSummary _prev_period_summary;
 
-  // Scan all remembered sets of the collection set for references into the collection
-  // set.
-  void scan_rem_set(G1ParScanThreadState* pss, uint worker_i);
-
   // Flush remaining refinement buffers for cross-region references to either evacuate references
   // into the collection set or update the remembered set.
   void update_rem_set(G1ParScanThreadState* pss, uint worker_i);
@@ -109,6 +106,20 @@ public:
   void prepare_for_oops_into_collection_set_do();
   void cleanup_after_oops_into_collection_set_do();
 
+  // Scan all remembered sets of the collection set for references into the collection
+  // set, recording the times and work items into the given phases. Remembered sets
+  // that have already been scanned during this pause are skipped.
+  void scan_rem_set(G1ParScanThreadState* pss,
+                    uint worker_i,
+                    G1GCPhaseTimes::GCParPhases scan_phase,
+                    G1GCPhaseTimes::GCParPhases code_roots_phase,
+                    G1GCPhaseTimes::GCParPhases obj_copy_phase);
+
+  // Do not scan cards within the given region any more during this pause. Used
+  // for regions that are added to the collection set after the remembered set
+  // scan has started.
+  void exclude_region_from_scan(uint region_idx);
+
   G1RemSetScanState* scan_state() const { return _scan_state; }
 
   // Refine the card corresponding to "card_ptr". Safe to be called concurrently
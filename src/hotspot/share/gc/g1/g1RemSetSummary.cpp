@@ -229,6 +229,8 @@ private:
   RegionTypeCounter _old;
   RegionTypeCounter _all;
 
+  HeapRegionRemSetContainerStats _containers;
+
   size_t _max_rs_mem_sz;
   HeapRegion* _max_rs_mem_sz_region;
 
@@ -264,6 +266,7 @@ public:
       _max_rs_mem_sz_region = r;
     }
     size_t occupied_cards = hrrs->occupied();
+    hrrs->add_container_stats(&_containers);
     size_t code_root_mem_sz = hrrs->strong_code_roots_mem_size();
     if (code_root_mem_sz > max_code_root_mem_sz()) {
       _max_code_root_mem_sz = code_root_mem_sz;
@@ -309,6 +312,7 @@ public:
                   proper_unit_for_byte_size(HeapRegionRemSet::static_mem_size()),
                   byte_size_in_proper_unit(HeapRegionRemSet::fl_mem_size()),
                   proper_unit_for_byte_size(HeapRegionRemSet::fl_mem_size()));
+    _containers.print_on(out);
 
     out->print_cr("    " SIZE_FORMAT " occupied cards represented.",
                   total_cards_occupied());
@@ -27,10 +27,10 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1StringDedup.hpp"
-#include "gc/g1/g1StringDedupQueue.hpp"
 #include "gc/g1/g1StringDedupStat.hpp"
 #include "gc/shared/stringdedup/stringDedup.inline.hpp"
-#include "gc/shared/stringdedup/stringDedupQueue.hpp"
+#include "gc/shared/stringdedup/stringDedupQueue.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupSTWQueue.hpp"
 #include "gc/shared/stringdedup/stringDedupTable.hpp"
 #include "gc/shared/stringdedup/stringDedupThread.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -38,7 +38,7 @@
 
 void G1StringDedup::initialize() {
   assert(UseG1GC, "String deduplication available with G1");
-  StringDedup::initialize_impl<G1StringDedupQueue, G1StringDedupStat>();
+  StringDedup::initialize_impl<StringDedupSTWQueue, G1StringDedupStat>();
 }
 
 bool G1StringDedup::is_candidate_from_mark(oop obj) {
@@ -59,7 +59,7 @@ bool G1StringDedup::is_candidate_from_mark(oop obj) {
 void G1StringDedup::enqueue_from_mark(oop java_string, uint worker_id) {
   assert(is_enabled(), "String deduplication not enabled");
   if (is_candidate_from_mark(java_string)) {
-    G1StringDedupQueue::push(worker_id, java_string);
+    StringDedupQueue::push(worker_id, java_string);
   }
 }
 
@@ -85,7 +85,7 @@ bool G1StringDedup::is_candidate_from_evacuation(bool from_young, bool to_young,
 void G1StringDedup::enqueue_from_evacuation(bool from_young, bool to_young, uint worker_id, oop java_string) {
   assert(is_enabled(), "String deduplication not enabled");
   if (is_candidate_from_evacuation(from_young, to_young, java_string)) {
-    G1StringDedupQueue::push(worker_id, java_string);
+    StringDedupQueue::push(worker_id, java_string);
   }
 }
 
@@ -25,28 +25,91 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
+#include "gc/g1/g1ConcurrentMark.hpp"
+#include "gc/g1/g1ConcurrentMarkThread.inline.hpp"
 #include "gc/g1/g1Policy.hpp"
 #include "gc/g1/g1YoungRemSetSamplingThread.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
+#include "gc/shared/gcLocker.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 
 G1YoungRemSetSamplingThread::G1YoungRemSetSamplingThread() :
     ConcurrentGCThread(),
     _monitor(Mutex::nonleaf,
              "G1YoungRemSetSamplingThread monitor",
              true,
-             Monitor::_safepoint_check_never) {
+             Monitor::_safepoint_check_never),
+    _last_periodic_gc_attempt_s(os::elapsedTime()) {
   set_name("G1 Young RemSet Sampling");
   create_and_start();
 }
 
+uintx G1YoungRemSetSamplingThread::calc_wait_time_ms() {
+  uintx waitms = G1ConcRefinementServiceIntervalMillis; // 300, really should be?
+  if (G1PeriodicGCInterval != 0) {
+    double since_last_attempt_ms = (os::elapsedTime() - _last_periodic_gc_attempt_s) * MILLIUNITS;
+    double until_next_attempt_ms = (double)G1PeriodicGCInterval - since_last_attempt_ms;
+    waitms = MIN2(waitms, (uintx)MAX2(until_next_attempt_ms, 1.0));
+  }
+  return waitms;
+}
+
 void G1YoungRemSetSamplingThread::sleep_before_next_cycle() {
   MutexLockerEx x(&_monitor, Mutex::_no_safepoint_check_flag);
   if (!should_terminate()) {
-    uintx waitms = G1ConcRefinementServiceIntervalMillis; // 300, really should be?
-    _monitor.wait(Mutex::_no_safepoint_check_flag, waitms);
+    _monitor.wait(Mutex::_no_safepoint_check_flag, calc_wait_time_ms());
+  }
+}
+
+bool G1YoungRemSetSamplingThread::should_start_periodic_gc() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  // A concurrent cycle in progress will shrink the heap at its Remark.
+  if (g1h->concurrent_mark()->cm_thread()->during_cycle()) {
+    log_debug(gc, periodic)("Concurrent cycle in progress. Skipping.");
+    return false;
+  }
+
+  // A GC is already pending until the JNI critical sections are left.
+  if (GCLocker::is_active_and_needs_gc()) {
+    log_debug(gc, periodic)("GCLocker is active. Skipping.");
+    return false;
+  }
+
+  // Only an application that has not needed a GC for a while is idle.
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  jlong since_last_gc_ms = now_ms - g1h->g1_policy()->collection_pause_end_millis();
+  if (since_last_gc_ms < (jlong)G1PeriodicGCInterval) {
+    log_debug(gc, periodic)("Last GC occurred " JLONG_FORMAT "ms before which is below threshold " UINTX_FORMAT "ms. Skipping.",
+                            since_last_gc_ms, G1PeriodicGCInterval);
+    return false;
+  }
+
+  // Do not add to the load of a busy machine.
+  double recent_load = 0.0;
+  if (G1PeriodicGCSystemLoadThreshold > 0.0 &&
+      (os::loadavg(&recent_load, 1) == -1 || recent_load > G1PeriodicGCSystemLoadThreshold)) {
+    log_debug(gc, periodic)("Load %1.2f is higher than threshold %1.2f. Skipping.",
+                            recent_load, G1PeriodicGCSystemLoadThreshold);
+    return false;
+  }
+  return true;
+}
+
+void G1YoungRemSetSamplingThread::check_for_periodic_gc() {
+  if (G1PeriodicGCInterval == 0) {
+    return;
+  }
+  if ((os::elapsedTime() - _last_periodic_gc_attempt_s) * MILLIUNITS >= G1PeriodicGCInterval) {
+    log_debug(gc, periodic)("Checking for periodic GC.");
+    if (should_start_periodic_gc()) {
+      log_info(gc, periodic)("Triggering periodic GC, RSS " SIZE_FORMAT "K", os::current_rss() / K);
+      Universe::heap()->collect(GCCause::_g1_periodic_collection);
+    }
+    _last_periodic_gc_attempt_s = os::elapsedTime();
   }
 }
 
@@ -56,6 +119,8 @@ void G1YoungRemSetSamplingThread::run_service() {
   while (!should_terminate()) {
     sample_young_list_rs_lengths();
 
+    check_for_periodic_gc();
+
     if (os::supports_vtime()) {
       _vtime_accum = (os::elapsedVTime() - vtime_start);
     } else {
@@ -39,10 +39,16 @@
 // reevaluates the prediction for the remembered set scanning costs, and potentially
 // G1Policy resizes the young gen. This may do a premature GC or even
 // increase the young gen size to keep pause time length goal.
+//
+// The thread also triggers periodic GCs (G1PeriodicGCInterval) when the
+// application has been idle, so that the heap shrinks at the following
+// Remark and unused memory is returned to the operating system.
 class G1YoungRemSetSamplingThread: public ConcurrentGCThread {
 private:
   Monitor _monitor;
 
+  double _last_periodic_gc_attempt_s;
+
   void sample_young_list_rs_lengths();
 
   void run_service();
@@ -50,6 +56,12 @@ private:
 
   void sleep_before_next_cycle();
 
+  // Milliseconds to wait before the next sampling or periodic GC check.
+  uintx calc_wait_time_ms();
+
+  bool should_start_periodic_gc();
+  void check_for_periodic_gc();
+
   double _vtime_accum;  // Accumulated virtual time.
 
 public:
@@ -135,6 +135,19 @@
           "specified number of milliseconds to do miscellaneous work.")     \
           range(0, max_jint)                                                \
                                                                             \
+  manageable(uintx, G1PeriodicGCInterval, 0,                                \
+          "Number of milliseconds after the previous GC after which G1 "    \
+          "triggers a periodic GC so that it can return unused heap "       \
+          "memory to the OS. 0 disables periodic GCs.")                     \
+                                                                            \
+  product(bool, G1PeriodicGCInvokesConcurrent, true,                        \
+          "Make the periodic GC a concurrent cycle rather than a Full GC.") \
+                                                                            \
+  manageable(double, G1PeriodicGCSystemLoadThreshold, 0.0,                  \
+          "Maximum one-minute system load average at which G1 still "       \
+          "triggers a periodic GC. 0.0 disables the check.")                \
+          range(0.0, (double)max_uintx)                                     \
+                                                                            \
   product(size_t, G1ConcRefinementThresholdStep, 2,                         \
           "Each time the rset update queue increases by this amount "       \
           "activate the next refinement thread if available. "              \
@@ -180,6 +193,17 @@
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetSparseRegionEntriesConstraintFunc,AfterErgo)     \
                                                                             \
+  develop(intx, G1RSetArrayEntriesBase, 32,                                 \
+          "Max number of cards per region in a card array before it is "    \
+          "turned into a bitmap, per MB.")                                  \
+          range(1, max_jint/wordSize)                                       \
+                                                                            \
+  product(intx, G1RSetArrayEntries, 0,                                      \
+          "Max number of cards per region in a card array before it is "    \
+          "turned into a bitmap. Capped at the size where a bitmap "        \
+          "takes less memory. Will be set ergonomically by default.")       \
+          range(0, max_jint/wordSize)                                       \
+                                                                            \
   develop(intx, G1MaxVerifyFailures, -1,                                    \
           "The maximum number of verification failures to print.  "         \
           "-1 means print all.")                                            \
@@ -257,6 +281,12 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(uint, G1EvacuationBatchSize, 4,                              \
+          "Number of references taken from the task queue at once during "  \
+          "evacuation. The objects they refer to are prefetched before "    \
+          "any of them is copied. 1 disables batching.")                    \
+          range(1, 16)                                                      \
+                                                                            \
   experimental(size_t, G1RebuildRemSetChunkSize, 256 * K,                   \
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
@@ -266,6 +296,13 @@
           "as a percentage of the heap size.")                              \
           range(0, 100)                                                     \
                                                                             \
+  experimental(uintx, G1OptionalCSetPercent, 20,                            \
+          "The percentage of the predicted old region evacuation time of "  \
+          "a mixed collection that is made up of optional regions. These "  \
+          "are only evacuated if time remains in the pause. 0 disables "    \
+          "optional regions.")                                              \
+          range(0, 100)                                                     \
+                                                                            \
   notproduct(bool, G1EvacuationFailureALot, false,                          \
           "Force use of evacuation failure handling during certain "        \
           "evacuation pauses")                                              \
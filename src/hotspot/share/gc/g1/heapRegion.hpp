@@ -251,7 +251,12 @@ class HeapRegion: public G1ContiguousSpace {
   double _gc_efficiency;
 
   int  _young_index_in_cset;
+  // Index of this region among the optional regions of the current
+  // collection set, or -1 if it is not an optional region.
+  int  _index_in_opt_cset;
   SurvRateGroup* _surv_rate_group;
+  // Index of the NUMA node the memory of this region is bound to.
+  uint _node_index;
   int  _age_index;
 
   // The start of the unmarked area. The unmarked area extends from this
@@ -366,6 +371,10 @@ class HeapRegion: public G1ContiguousSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The index of the NUMA node (see G1NUMA) the memory of this region is
+  // bound to.
+  uint node_index() const { return _node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -558,6 +567,12 @@ class HeapRegion: public G1ContiguousSpace {
     _young_index_in_cset = index;
   }
 
+  int  index_in_opt_cset() const { return _index_in_opt_cset; }
+  void set_index_in_opt_cset(int index) {
+    assert( (index == -1) || is_old(), "pre-condition" );
+    _index_in_opt_cset = index;
+  }
+
   int age_in_surv_rate_group() {
     assert( _surv_rate_group != NULL, "pre-condition" );
     assert( _age_index > -1, "pre-condition" );
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
@@ -146,6 +147,28 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions, Wor
   }
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(bool is_old, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  G1NUMA* numa = G1NUMA::numa();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && numa->is_enabled()) {
+    hr = _free_list.remove_region_with_node_index(is_old, requested_node_index);
+  }
+  if (hr == NULL) {
+    // No region on the requested node close to the end of the free list we
+    // allocate from; take any region.
+    hr = _free_list.remove_region(is_old);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+
+    numa->update_statistics(G1NUMAStats::NewRegionAlloc, requested_node_index, hr->node_index());
+  }
+  return hr;
+}
+
 MemoryUsage HeapRegionManager::get_auxiliary_data_memory_usage() const {
   size_t used_sz =
     _prev_bitmap_mapper->committed_size() +
@@ -33,6 +33,7 @@
 #include "memory/padded.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -42,13 +43,30 @@
 const char* HeapRegionRemSet::_state_strings[] =  {"Untracked", "Updating", "Complete"};
 const char* HeapRegionRemSet::_short_state_strings[] =  {"UNTRA", "UPDAT", "CMPLT"};
 
-class PerRegionTable: public CHeapObj<mtGC> {
+// A PerRegionTable holds the cards of one "from" region. It starts out as a
+// small unsorted array of card indices and is turned into a bitmap over all
+// cards of the region once that array is full, so that the common case of a
+// region pair with few references does not pay for a full bitmap.
+//
+// Cards in the array are only read and written with the owning
+// OtherRegionsTable's lock held. Once the table has been turned into a
+// bitmap cards are added without locking.
+class PerRegionTable: public CHeapObj<mtGCCardSet> {
   friend class OtherRegionsTable;
   friend class HeapRegionRemSetIterator;
 
   HeapRegion*     _hr;
+
+  // Card array. Card indices within a region fit into 16 bits as regions
+  // are at most 32M in size.
+  u2*             _cards;
+  uint            _num_cards;
+
+  // Bitmap, allocated on first use. It is kept when the table is reused
+  // and only given back while the table sits on the free list.
   CHeapBitMap     _bm;
   jint            _occupied;
+  volatile bool   _is_bitmap;
 
   // next pointer for free/allocated 'all' list
   PerRegionTable* _next;
@@ -62,14 +80,20 @@ class PerRegionTable: public CHeapObj<mtGC> {
   // Global free list of PRTs
   static PerRegionTable* volatile _free_list;
 
+  // Maximum number of cards in the card array; static after init.
+  static uint _max_array_cards;
+
 protected:
   // We need access in order to union things into the base table.
   BitMap* bm() { return &_bm; }
 
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
+    _cards(NEW_C_HEAP_ARRAY(u2, _max_array_cards, mtGCCardSet)),
+    _num_cards(0),
+    _bm(mtGCCardSet),
     _occupied(0),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
+    _is_bitmap(false),
     _collision_list_next(NULL), _next(NULL), _prev(NULL)
   {}
 
@@ -100,14 +124,42 @@ protected:
     }
   }
 
+  bool array_contains(CardIdx_t card_index) const {
+    for (uint i = 0; i < _num_cards; i++) {
+      if (_cards[i] == card_index) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Move the cards of the array into the bitmap and publish the bitmap to
+  // lock-free adders. Requires the owning table's lock.
+  void convert_to_bitmap() {
+    assert(!is_bitmap(), "already converted");
+    if (_bm.size() == 0) {
+      _bm.initialize(HeapRegion::CardsPerRegion);
+    } else {
+      _bm.clear();
+    }
+    _occupied = 0;
+    for (uint i = 0; i < _num_cards; i++) {
+      add_card_work(_cards[i], /*parallel*/ true);
+    }
+    _num_cards = 0;
+    OrderAccess::release_store(&_is_bitmap, true);
+  }
+
 public:
 
   HeapRegion* hr() const { return OrderAccess::load_acquire(&_hr); }
 
+  bool is_bitmap() const { return OrderAccess::load_acquire(&_is_bitmap); }
+
   jint occupied() const {
     // Overkill, but if we ever need it...
     // guarantee(_occupied == _bm.count_one_bits(), "Check");
-    return _occupied;
+    return is_bitmap() ? _occupied : (jint)_num_cards;
   }
 
   void init(HeapRegion* hr, bool clear_links_to_all_list) {
@@ -116,38 +168,51 @@ public:
       set_prev(NULL);
     }
     _collision_list_next = NULL;
+    _num_cards = 0;
     _occupied = 0;
-    _bm.clear();
-    // Make sure that the bitmap clearing above has been finished before publishing
+    // The bitmap is cleared when the card array overflows into it again.
+    // Make sure that the reset above has been finished before publishing
     // this PRT to concurrent threads.
+    OrderAccess::release_store(&_is_bitmap, false);
     OrderAccess::release_store(&_hr, hr);
   }
 
+  // Lock-free addition; requires the table to be a bitmap.
   void add_reference(OopOrNarrowOopStar from) {
     add_reference_work(from, /*parallel*/ true);
   }
 
-  void seq_add_reference(OopOrNarrowOopStar from) {
-    add_reference_work(from, /*parallel*/ false);
-  }
-
-  void add_card(CardIdx_t from_card_index) {
+  // Adds the given card, turning the card array into a bitmap when it is
+  // full. Requires the owning table's lock.
+  void add_card_locked(CardIdx_t from_card_index) {
+    if (!is_bitmap()) {
+      if (array_contains(from_card_index)) {
+        return;
+      }
+      if (_num_cards < _max_array_cards) {
+        _cards[_num_cards++] = (u2)from_card_index;
+        return;
+      }
+      convert_to_bitmap();
+    }
     add_card_work(from_card_index, /*parallel*/ true);
   }
 
-  void seq_add_card(CardIdx_t from_card_index) {
-    add_card_work(from_card_index, /*parallel*/ false);
-  }
-
-  // (Destructively) union the bitmap of the current table into the given
+  // (Destructively) union the cards of the current table into the given
   // bitmap (which is assumed to be of the same size.)
   void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
+    if (is_bitmap()) {
+      bm->set_union(_bm);
+    } else {
+      for (uint i = 0; i < _num_cards; i++) {
+        bm->set_bit(_cards[i]);
+      }
+    }
   }
 
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    return sizeof(PerRegionTable) + _max_array_cards * sizeof(u2) + _bm.size_in_words() * HeapWordSize;
   }
 
   // Requires "from" to be in "hr()".
@@ -155,7 +220,22 @@ public:
     assert(hr()->is_in_reserved(from), "Precondition.");
     size_t card_ind = pointer_delta(from, hr()->bottom(),
                                     G1CardTable::card_size);
-    return _bm.at(card_ind);
+    return is_bitmap() ? _bm.at(card_ind) : array_contains((CardIdx_t)card_ind);
+  }
+
+  // Iteration support. Positions are card indices for bitmaps and indices
+  // into the card array otherwise. Returns CardsPerRegion if there is no
+  // next position.
+  size_t next_pos(size_t pos) const {
+    if (is_bitmap()) {
+      return _bm.get_next_one_offset(pos + 1);
+    }
+    pos++;
+    return pos < _num_cards ? pos : (size_t)HeapRegion::CardsPerRegion;
+  }
+
+  size_t card_at(size_t pos) const {
+    return is_bitmap() ? pos : (size_t)_cards[pos];
   }
 
   // Bulk-free the PRTs from prt to last, assumes that they are
@@ -193,6 +273,18 @@ public:
     return new PerRegionTable(hr);
   }
 
+  // Give the bitmaps of all PRTs on the free list back to the C heap. Most
+  // reused tables only ever need their card array. Must be called at a
+  // safepoint when no thread can still be accessing a freed PRT.
+  static void release_free_list_bitmaps() {
+    assert(SafepointSynchronize::is_at_safepoint(), "must be");
+    for (PerRegionTable* cur = _free_list; cur != NULL; cur = cur->next()) {
+      if (cur->_bm.size() != 0) {
+        cur->_bm.resize(0);
+      }
+    }
+  }
+
   PerRegionTable* next() const { return _next; }
   void set_next(PerRegionTable* next) { _next = next; }
   PerRegionTable* prev() const { return _prev; }
@@ -228,10 +320,15 @@ public:
     return res;
   }
 
+  static void set_max_array_cards(uint max_array_cards) {
+    _max_array_cards = max_array_cards;
+  }
+
   static void test_fl_mem_size();
 };
 
 PerRegionTable* volatile PerRegionTable::_free_list = NULL;
+uint PerRegionTable::_max_array_cards = 0;
 
 size_t OtherRegionsTable::_max_fine_entries = 0;
 size_t OtherRegionsTable::_mod_max_fine_entries_mask = 0;
@@ -241,7 +338,7 @@ size_t OtherRegionsTable::_fine_eviction_sample_size = 0;
 OtherRegionsTable::OtherRegionsTable(HeapRegion* hr, Mutex* m) :
   _g1h(G1CollectedHeap::heap()),
   _hr(hr), _m(m),
-  _coarse_map(G1CollectedHeap::heap()->max_regions(), mtGC),
+  _coarse_map(G1CollectedHeap::heap()->max_regions(), mtGCCardSet),
   _fine_grain_regions(NULL),
   _first_all_fine_prts(NULL), _last_all_fine_prts(NULL),
   _n_fine_entries(0), _n_coarse_entries(0),
@@ -263,7 +360,7 @@ OtherRegionsTable::OtherRegionsTable(HeapRegion* hr, Mutex* m) :
   }
 
   _fine_grain_regions = NEW_C_HEAP_ARRAY3(PerRegionTablePtr, _max_fine_entries,
-                        mtGC, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
+                        mtGCCardSet, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
 
   if (_fine_grain_regions == NULL) {
     vm_exit_out_of_memory(sizeof(void*)*_max_fine_entries, OOM_MALLOC_ERROR,
@@ -366,65 +463,74 @@ void OtherRegionsTable::add_reference(OopOrNarrowOopStar from, uint tid) {
   // Otherwise find a per-region table to add it to.
   size_t ind = from_hrm_ind & _mod_max_fine_entries_mask;
   PerRegionTable* prt = find_region_table(ind, from_hr);
-  if (prt == NULL) {
-    MutexLockerEx x(_m, Mutex::_no_safepoint_check_flag);
-    // Confirm that it's really not there...
-    prt = find_region_table(ind, from_hr);
-    if (prt == NULL) {
+  if (prt != NULL && prt->is_bitmap()) {
+    // Note that we can't assert "prt->hr() == from_hr", because of the
+    // possibility of concurrent reuse.  But see head comment of
+    // OtherRegionsTable for why this is OK.
+    prt->add_reference(from);
+    assert(contains_reference(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
+    return;
+  }
 
-      CardIdx_t card_index = card_within_region(from, from_hr);
+  // Sparse entries and card arrays are only modified under the lock.
+  MutexLockerEx x(_m, Mutex::_no_safepoint_check_flag);
+  // The region may have been coarsened while we were waiting.
+  if (_coarse_map.at(from_hrm_ind)) {
+    return;
+  }
 
-      if (G1HRRSUseSparseTable &&
-          _sparse_table.add_card(from_hrm_ind, card_index)) {
-        assert(contains_reference_locked(from), "We just added " PTR_FORMAT " to the Sparse table", p2i(from));
-        return;
-      }
+  CardIdx_t card_index = card_within_region(from, from_hr);
 
-      if (_n_fine_entries == _max_fine_entries) {
-        prt = delete_region_table();
-        // There is no need to clear the links to the 'all' list here:
-        // prt will be reused immediately, i.e. remain in the 'all' list.
-        prt->init(from_hr, false /* clear_links_to_all_list */);
-      } else {
-        prt = PerRegionTable::alloc(from_hr);
-        link_to_all(prt);
-      }
+  // Confirm that it's really not there, or find the table we saw above
+  // again now that it cannot be reused concurrently.
+  prt = find_region_table(ind, from_hr);
+  if (prt == NULL) {
+    if (G1HRRSUseSparseTable &&
+        _sparse_table.add_card(from_hrm_ind, card_index)) {
+      assert(contains_reference_locked(from), "We just added " PTR_FORMAT " to the Sparse table", p2i(from));
+      return;
+    }
 
-      PerRegionTable* first_prt = _fine_grain_regions[ind];
-      prt->set_collision_list_next(first_prt);
-      // The assignment into _fine_grain_regions allows the prt to
-      // start being used concurrently. In addition to
-      // collision_list_next which must be visible (else concurrent
-      // parsing of the list, if any, may fail to see other entries),
-      // the content of the prt must be visible (else for instance
-      // some mark bits may not yet seem cleared or a 'later' update
-      // performed by a concurrent thread could be undone when the
-      // zeroing becomes visible). This requires store ordering.
-      OrderAccess::release_store(&_fine_grain_regions[ind], prt);
-      _n_fine_entries++;
-
-      if (G1HRRSUseSparseTable) {
-        // Transfer from sparse to fine-grain.
-        SparsePRTEntry *sprt_entry = _sparse_table.get_entry(from_hrm_ind);
-        assert(sprt_entry != NULL, "There should have been an entry");
-        for (int i = 0; i < sprt_entry->num_valid_cards(); i++) {
-          CardIdx_t c = sprt_entry->card(i);
-          prt->add_card(c);
-        }
-        // Now we can delete the sparse entry.
-        bool res = _sparse_table.delete_entry(from_hrm_ind);
-        assert(res, "It should have been there.");
+    if (_n_fine_entries == _max_fine_entries) {
+      prt = delete_region_table();
+      // There is no need to clear the links to the 'all' list here:
+      // prt will be reused immediately, i.e. remain in the 'all' list.
+      prt->init(from_hr, false /* clear_links_to_all_list */);
+    } else {
+      prt = PerRegionTable::alloc(from_hr);
+      link_to_all(prt);
+    }
+
+    PerRegionTable* first_prt = _fine_grain_regions[ind];
+    prt->set_collision_list_next(first_prt);
+    // The assignment into _fine_grain_regions allows the prt to
+    // start being used concurrently. In addition to
+    // collision_list_next which must be visible (else concurrent
+    // parsing of the list, if any, may fail to see other entries),
+    // the content of the prt must be visible (else for instance
+    // some mark bits may not yet seem cleared or a 'later' update
+    // performed by a concurrent thread could be undone when the
+    // zeroing becomes visible). This requires store ordering.
+    OrderAccess::release_store(&_fine_grain_regions[ind], prt);
+    _n_fine_entries++;
+
+    if (G1HRRSUseSparseTable) {
+      // Transfer from sparse to the card array.
+      SparsePRTEntry *sprt_entry = _sparse_table.get_entry(from_hrm_ind);
+      assert(sprt_entry != NULL, "There should have been an entry");
+      for (int i = 0; i < sprt_entry->num_valid_cards(); i++) {
+        CardIdx_t c = sprt_entry->card(i);
+        prt->add_card_locked(c);
       }
+      // Now we can delete the sparse entry.
+      bool res = _sparse_table.delete_entry(from_hrm_ind);
+      assert(res, "It should have been there.");
     }
-    assert(prt != NULL && prt->hr() == from_hr, "consequence");
   }
-  // Note that we can't assert "prt->hr() == from_hr", because of the
-  // possibility of concurrent reuse.  But see head comment of
-  // OtherRegionsTable for why this is OK.
-  assert(prt != NULL, "Inv");
+  assert(prt != NULL && prt->hr() == from_hr, "consequence");
 
-  prt->add_reference(from);
-  assert(contains_reference(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
+  prt->add_card_locked(card_index);
+  assert(contains_reference_locked(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
 }
 
 PerRegionTable*
@@ -544,11 +650,9 @@ size_t OtherRegionsTable::occ_sparse() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs differ in size depending on whether they have a bitmap.
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    sum += cur->mem_size();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -557,6 +661,37 @@ size_t OtherRegionsTable::mem_size() const {
   return sum;
 }
 
+void OtherRegionsTable::add_container_stats(HeapRegionRemSetContainerStats* stats) const {
+  stats->_num_inline += _sparse_table.occupied_entries();
+  stats->_inline_mem_size += _sparse_table.mem_size();
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    if (cur->is_bitmap()) {
+      stats->_num_bitmap++;
+      stats->_bitmap_mem_size += cur->mem_size();
+    } else {
+      stats->_num_array++;
+      stats->_array_mem_size += cur->mem_size();
+    }
+  }
+  stats->_num_full += _n_coarse_entries;
+  stats->_full_mem_size += _coarse_map.size_in_words() * HeapWordSize;
+}
+
+void HeapRegionRemSetContainerStats::print_on(outputStream* out) const {
+  out->print_cr("   Containers: " SIZE_FORMAT " inline (" SIZE_FORMAT "%s), "
+                SIZE_FORMAT " array (" SIZE_FORMAT "%s), "
+                SIZE_FORMAT " bitmap (" SIZE_FORMAT "%s), "
+                SIZE_FORMAT " full (" SIZE_FORMAT "%s).",
+                _num_inline,
+                byte_size_in_proper_unit(_inline_mem_size), proper_unit_for_byte_size(_inline_mem_size),
+                _num_array,
+                byte_size_in_proper_unit(_array_mem_size), proper_unit_for_byte_size(_array_mem_size),
+                _num_bitmap,
+                byte_size_in_proper_unit(_bitmap_mem_size), proper_unit_for_byte_size(_bitmap_mem_size),
+                _num_full,
+                byte_size_in_proper_unit(_full_mem_size), proper_unit_for_byte_size(_full_mem_size));
+}
+
 size_t OtherRegionsTable::static_mem_size() {
   return G1FromCardCache::static_mem_size();
 }
@@ -638,11 +773,22 @@ void HeapRegionRemSet::setup_remset_size() {
   if (FLAG_IS_DEFAULT(G1RSetRegionEntries)) {
     G1RSetRegionEntries = G1RSetRegionEntriesBase * (region_size_log_mb + 1);
   }
+  if (FLAG_IS_DEFAULT(G1RSetArrayEntries)) {
+    G1RSetArrayEntries = G1RSetArrayEntriesBase * (region_size_log_mb + 1);
+  }
   guarantee(G1RSetSparseRegionEntries > 0 && G1RSetRegionEntries > 0 , "Sanity");
+
+  // Card arrays store card indices as u2. Beyond one card per 16 cards of
+  // the region the array would take more memory than the bitmap.
+  guarantee(HeapRegion::CardsPerRegion <= (size_t)max_jushort + 1, "Card indices must fit into a u2");
+  size_t max_array_cards = MIN2((size_t)G1RSetArrayEntries,
+                                HeapRegion::CardsPerRegion / (BitsPerByte * sizeof(u2)));
+  PerRegionTable::set_max_array_cards((uint)max_array_cards);
 }
 
 void HeapRegionRemSet::cleanup() {
   SparsePRT::cleanup_all();
+  PerRegionTable::release_free_list_bitmaps();
 }
 
 void HeapRegionRemSet::clear(bool only_cardset) {
@@ -757,10 +903,9 @@ bool HeapRegionRemSetIterator::coarse_has_next(size_t& card_index) {
 
 bool HeapRegionRemSetIterator::fine_has_next(size_t& card_index) {
   if (fine_has_next()) {
-    _cur_card_in_prt =
-      _fine_cur_prt->_bm.get_next_one_offset(_cur_card_in_prt + 1);
+    _cur_card_in_prt = _fine_cur_prt->next_pos(_cur_card_in_prt);
   }
-  if (_cur_card_in_prt == HeapRegion::CardsPerRegion) {
+  while (_cur_card_in_prt == HeapRegion::CardsPerRegion) {
     // _fine_cur_prt may still be NULL in case if there are not PRTs at all for
     // the remembered set.
     if (_fine_cur_prt == NULL || _fine_cur_prt->next() == NULL) {
@@ -768,12 +913,13 @@ bool HeapRegionRemSetIterator::fine_has_next(size_t& card_index) {
     }
     PerRegionTable* next_prt = _fine_cur_prt->next();
     switch_to_prt(next_prt);
-    _cur_card_in_prt = _fine_cur_prt->_bm.get_next_one_offset(_cur_card_in_prt + 1);
+    _cur_card_in_prt = _fine_cur_prt->next_pos(_cur_card_in_prt);
   }
 
-  card_index = _cur_region_card_offset + _cur_card_in_prt;
-  guarantee(_cur_card_in_prt < HeapRegion::CardsPerRegion,
-            "Card index " SIZE_FORMAT " must be within the region", _cur_card_in_prt);
+  size_t card_in_region = _fine_cur_prt->card_at(_cur_card_in_prt);
+  card_index = _cur_region_card_offset + card_in_region;
+  guarantee(card_in_region < HeapRegion::CardsPerRegion,
+            "Card index " SIZE_FORMAT " must be within the region", card_in_region);
   return true;
 }
 
@@ -788,9 +934,9 @@ void HeapRegionRemSetIterator::switch_to_prt(PerRegionTable* prt) {
   HeapWord* r_bot = _fine_cur_prt->hr()->bottom();
   _cur_region_card_offset = _bot->index_for(r_bot);
 
-  // The bitmap scan for the PRT always scans from _cur_region_cur_card + 1.
-  // To avoid special-casing this start case, and not miss the first bitmap
-  // entry, initialize _cur_region_cur_card with -1 instead of 0.
+  // The scan for the PRT always scans from _cur_card_in_prt + 1.
+  // To avoid special-casing this start case, and not miss the first
+  // entry, initialize _cur_card_in_prt with -1 instead of 0.
   _cur_card_in_prt = (size_t)-1;
 }
 
@@ -57,6 +57,12 @@ class HRRSCleanupTask : public SparsePRTCleanupTask {
 // deleting an entry and setting the corresponding coarse-grained bit when
 // we would overflow this cap.
 
+// The cards of a single "from" region thus live in one of four containers,
+// picked by how many cards there are: a few cards inline in the sparse
+// table, up to G1RSetArrayEntries cards in the card array of a PRT, a
+// bitmap over all cards of the region in a PRT, or the region's bit in
+// the coarse map. Containers only ever grow into the next kind.
+
 // We use a mixture of locking and lock-free techniques here.  We allow
 // threads to locate PRTs without locking, but threads attempting to alter
 // a bucket list obtain a lock.  This means that any failing attempt to
@@ -65,11 +71,37 @@ class HRRSCleanupTask : public SparsePRTCleanupTask {
 // because:
 //
 //   1) We only actually free PRT's at safe points (though we reuse them at
-//      other times).
+//      other times).  Bitmaps of PRTs are only released at safe points too.
 //   2) We find PRT's in an attempt to add entries.  If a PRT is deleted,
 //      it's _coarse_map bit is set, so the that we were attempting to add
 //      is represented.  If a deleted PRT is re-used, a thread adding a bit,
 //      thinking the PRT is for a different region, does no harm.
+//
+// Only PRTs that have been turned into bitmaps are updated without the lock;
+// card arrays are looked up again and modified with the lock held.
+
+// Number of containers of each kind and the memory they take, summed up
+// over one or more remembered sets.
+class HeapRegionRemSetContainerStats {
+  friend class OtherRegionsTable;
+
+  size_t _num_inline;
+  size_t _num_array;
+  size_t _num_bitmap;
+  size_t _num_full;
+
+  size_t _inline_mem_size;
+  size_t _array_mem_size;
+  size_t _bitmap_mem_size;
+  size_t _full_mem_size;
+
+public:
+  HeapRegionRemSetContainerStats() :
+    _num_inline(0), _num_array(0), _num_bitmap(0), _num_full(0),
+    _inline_mem_size(0), _array_mem_size(0), _bitmap_mem_size(0), _full_mem_size(0) { }
+
+  void print_on(outputStream* out) const;
+};
 
 class OtherRegionsTable {
   friend class HeapRegionRemSetIterator;
@@ -156,6 +188,8 @@ public:
 
   // Returns size of the actual remembered set containers in bytes.
   size_t mem_size() const;
+  // Adds the number and size of the containers of this table to stats.
+  void add_container_stats(HeapRegionRemSetContainerStats* stats) const;
   // Returns the size of static data in bytes.
   static size_t static_mem_size();
   // Returns the size of the free list content in bytes.
@@ -284,6 +318,11 @@ public:
       + strong_code_roots_mem_size();
   }
 
+  void add_container_stats(HeapRegionRemSetContainerStats* stats) {
+    MutexLockerEx x(&_m, Mutex::_no_safepoint_check_flag);
+    _other_regions.add_container_stats(stats);
+  }
+
   // Returns the memory occupancy of all static data structures associated
   // with remembered sets.
   static size_t static_mem_size() {
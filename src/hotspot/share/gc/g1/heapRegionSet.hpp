@@ -196,6 +196,11 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region on the given NUMA node found within the first
+  // G1NUMA::max_search_depth() regions from head or tail. Returns NULL if
+  // there is no such region.
+  HeapRegion* remove_region_with_node_index(bool from_head, uint requested_node_index);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_GC_G1_HEAPREGIONSET_INLINE_HPP
 #define SHARE_VM_GC_G1_HEAPREGIONSET_INLINE_HPP
 
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegionSet.hpp"
 
 inline void HeapRegionSetBase::add(HeapRegion* hr) {
@@ -147,5 +148,49 @@ inline HeapRegion* FreeRegionList::remove_region(bool from_head) {
   return hr;
 }
 
+inline HeapRegion* FreeRegionList::remove_region_with_node_index(bool from_head,
+                                                                 uint requested_node_index) {
+  assert(G1NUMA::numa()->is_enabled(), "invariant");
+  check_mt_safety();
+  verify_optional();
+
+  const uint max_search_depth = G1NUMA::numa()->max_search_depth();
+  uint cur_depth = 0;
+  HeapRegion* cur = from_head ? _head : _tail;
+  while (cur != NULL && cur->node_index() != requested_node_index) {
+    if (++cur_depth >= max_search_depth) {
+      return NULL;
+    }
+    cur = from_head ? cur->next() : cur->prev();
+  }
+  if (cur == NULL) {
+    return NULL;
+  }
+
+  // Unlink the region.
+  HeapRegion* prev = cur->prev();
+  HeapRegion* next = cur->next();
+  if (prev == NULL) {
+    _head = next;
+  } else {
+    prev->set_next(next);
+  }
+  if (next == NULL) {
+    _tail = prev;
+  } else {
+    next->set_prev(prev);
+  }
+  cur->set_prev(NULL);
+  cur->set_next(NULL);
+
+  if (_last == cur) {
+    _last = NULL;
+  }
+
+  // remove() will verify the region and check mt safety.
+  remove(cur);
+  return cur;
+}
+
 #endif // SHARE_VM_GC_G1_HEAPREGIONSET_INLINE_HPP
 
@@ -26,6 +26,7 @@
 #include "gc/g1/ptrQueue.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
@@ -99,7 +100,8 @@ PtrQueueSet::PtrQueueSet(bool notify_when_complete) :
   _completed_buffers_tail(NULL),
   _n_completed_buffers(0),
   _process_completed_threshold(0), _process_completed(false),
-  _buf_free_list(NULL), _buf_free_list_sz(0)
+  _buf_free_list(NULL), _buf_free_list_sz(0),
+  _mutator_completed_buffers(0)
 {
   _fl_owner = this;
 }
@@ -205,6 +207,7 @@ void PtrQueue::handle_zero_index() {
 
 bool PtrQueueSet::process_or_enqueue_complete_buffer(BufferNode* node) {
   if (Thread::current()->is_Java_thread()) {
+    Atomic::inc(&_mutator_completed_buffers);
     // We don't lock. It is fine to be epsilon-precise here.
     if (_max_completed_queue == 0 ||
         (_max_completed_queue > 0 &&
@@ -300,7 +303,8 @@ void PtrQueueSet::merge_bufferlists(PtrQueueSet *src) {
 void PtrQueueSet::notify_if_necessary() {
   MutexLockerEx x(_cbl_mon, Mutex::_no_safepoint_check_flag);
   assert(_process_completed_threshold >= 0, "_process_completed is negative");
-  if (_n_completed_buffers >= (size_t)_process_completed_threshold || _max_completed_queue == 0) {
+  if (_n_completed_buffers > 0 &&
+      (_n_completed_buffers >= (size_t)_process_completed_threshold || _max_completed_queue == 0)) {
     _process_completed = true;
     if (_notify_when_complete)
       _cbl_mon->notify();
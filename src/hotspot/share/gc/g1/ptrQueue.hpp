@@ -288,6 +288,10 @@ protected:
   int _max_completed_queue;
   size_t _completed_queue_padding;
 
+  // Total number of buffers completed by mutator threads, whether they
+  // processed the buffer themselves or enqueued it.
+  volatile size_t _mutator_completed_buffers;
+
   size_t completed_buffers_list_length();
   void assert_completed_buffer_list_len_correct_locked();
   void assert_completed_buffer_list_len_correct();
@@ -357,6 +361,8 @@ public:
 
   size_t completed_buffers_num() { return _n_completed_buffers; }
 
+  size_t mutator_completed_buffers() const { return _mutator_completed_buffers; }
+
   void merge_bufferlists(PtrQueueSet* src);
 
   void set_max_completed_queue(int m) { _max_completed_queue = m; }
@@ -365,7 +371,8 @@ public:
   void set_completed_queue_padding(size_t padding) { _completed_queue_padding = padding; }
   size_t completed_queue_padding() { return _completed_queue_padding; }
 
-  // Notify the consumer if the number of buffers crossed the threshold
+  // Notify the consumer if the number of buffers crossed the threshold.
+  // Never notifies while there are no completed buffers.
   void notify_if_necessary();
 };
 
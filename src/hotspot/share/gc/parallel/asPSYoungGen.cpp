@@ -196,6 +196,7 @@ bool ASPSYoungGen::resize_generation(size_t eden_size, size_t survivor_size) {
     // How much is available for shrinking.
     size_t available_bytes = limit_gen_shrink(desired_change);
     size_t change = MIN2(desired_change, available_bytes);
+    ParallelScavengeHeap::heap()->abort_pretouch();
     virtual_space()->shrink_by(change);
     size_changed = true;
   } else {
@@ -26,6 +26,7 @@
 #include "gc/parallel/mutableSpace.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "memory/iterator.inline.hpp"
+#include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
@@ -113,7 +114,8 @@ void MutableSpace::initialize(MemRegion mr,
       numa_setup_pages(tail, clear_space);
     }
 
-    if (AlwaysPreTouch) {
+    // The initially committed heap is pre-touched by the heap as a whole.
+    if (AlwaysPreTouch && Universe::is_fully_initialized()) {
       pretouch_pages(head);
       pretouch_pages(tail);
     }
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "code/codeCache.hpp"
 #include "gc/parallel/adjoiningGenerations.hpp"
 #include "gc/parallel/adjoiningVirtualSpaces.hpp"
@@ -40,6 +41,9 @@
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcWhen.hpp"
+#include "gc/shared/heapPretoucher.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.hpp"
 #include "memory/metaspaceCounters.hpp"
@@ -120,6 +124,9 @@ jint ParallelScavengeHeap::initialize() {
     return JNI_ENOMEM;
   }
 
+  // Initialize string deduplication
+  StringDedup::initialize();
+
   return JNI_OK;
 }
 
@@ -160,6 +167,51 @@ void ParallelScavengeHeap::post_initialize() {
     PSMarkSweepProxy::initialize();
   }
   PSPromotionManager::initialize();
+
+  if (AlwaysPreTouch) {
+    // The young generation is used first, so pre-touch it before the old one.
+    _pretoucher = new HeapPretoucher(MAX2(PreTouchParallelChunkSize, (size_t)os::vm_page_size()), os::vm_page_size());
+    _pretoucher->add_range(young_gen()->virtual_space()->low(), young_gen()->virtual_space()->high());
+    _pretoucher->add_range(old_gen()->virtual_space()->low(), old_gen()->virtual_space()->high());
+    _pretoucher->start(ParallelGCThreads);
+    if (!AlwaysPreTouchInBackground) {
+      _pretoucher->wait_until_done();
+    }
+  }
+}
+
+void ParallelScavengeHeap::stop() {
+  if (_pretoucher != NULL) {
+    _pretoucher->stop();
+  }
+  if (StringDedup::is_enabled()) {
+    StringDedup::stop();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_begin() {
+  if (_pretoucher != NULL || StringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_end() {
+  if (_pretoucher != NULL || StringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
+}
+
+void ParallelScavengeHeap::deduplicate_string(oop str) {
+  assert(java_lang_String::is_instance(str), "invariant");
+  if (StringDedup::is_enabled()) {
+    StringDedup::deduplicate(str);
+  }
+}
+
+void ParallelScavengeHeap::abort_pretouch() {
+  if (_pretoucher != NULL) {
+    _pretoucher->abort();
+  }
 }
 
 void ParallelScavengeHeap::update_counters() {
@@ -598,10 +650,16 @@ void ParallelScavengeHeap::print_on_error(outputStream* st) const {
 
 void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
   PSScavenge::gc_task_manager()->threads_do(tc);
+  if (StringDedup::is_enabled()) {
+    StringDedup::threads_do(tc);
+  }
 }
 
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
   PSScavenge::gc_task_manager()->print_threads_on(st);
+  if (StringDedup::is_enabled()) {
+    StringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ParallelScavengeHeap::print_tracing_info() const {
@@ -620,6 +678,11 @@ void ParallelScavengeHeap::verify(VerifyOption option /* ignored */) {
 
     log_debug(gc, verify)("Eden");
     young_gen()->verify();
+
+    if (StringDedup::is_enabled()) {
+      log_debug(gc, verify)("StrDedup");
+      StringDedup::verify();
+    }
   }
 }
 
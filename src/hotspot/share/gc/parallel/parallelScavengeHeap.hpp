@@ -44,6 +44,7 @@
 class AdjoiningGenerations;
 class GCHeapSummary;
 class GCTaskManager;
+class HeapPretoucher;
 class MemoryManager;
 class MemoryPool;
 class PSAdaptiveSizePolicy;
@@ -79,6 +80,9 @@ class ParallelScavengeHeap : public CollectedHeap {
   MemoryPool* _survivor_pool;
   MemoryPool* _old_pool;
 
+  // Pre-touches the initially committed heap if AlwaysPreTouch is set.
+  HeapPretoucher* _pretoucher;
+
   virtual void initialize_serviceability();
 
   void trace_heap(GCWhen::Type when, const GCTracer* tracer);
@@ -93,7 +97,7 @@ class ParallelScavengeHeap : public CollectedHeap {
 
  public:
   ParallelScavengeHeap(GenerationSizer* policy) :
-    CollectedHeap(), _collector_policy(policy), _death_march_count(0) { }
+    CollectedHeap(), _collector_policy(policy), _death_march_count(0), _pretoucher(NULL) { }
 
   // For use by VM operations
   enum CollectionType {
@@ -138,6 +142,16 @@ class ParallelScavengeHeap : public CollectedHeap {
   void post_initialize();
   void update_counters();
 
+  virtual void stop();
+  virtual void safepoint_synchronize_begin();
+  virtual void safepoint_synchronize_end();
+
+  virtual void deduplicate_string(oop str);
+
+  // Stops background pre-touching of the heap. Must be called at a safepoint
+  // before uncommitting any part of the heap.
+  void abort_pretouch();
+
   // The alignment used for the various areas
   size_t space_alignment()      { return _collector_policy->space_alignment(); }
   size_t generation_alignment() { return _collector_policy->gen_alignment(); }
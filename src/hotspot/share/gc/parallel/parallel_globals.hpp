@@ -77,6 +77,12 @@
   develop(uintx, GCWorkerDelayMillis, 0,                                    \
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
+  develop(uintx, ParallelOldSummaryMinChunkRegions, 1024,                   \
+          "The minimum number of regions in each chunk of a parallel "      \
+          "summary in ParallelOldGC; smaller ranges are summarized "        \
+          "serially")                                                       \
+          range(1, max_uintx)                                               \
+                                                                            \
   product(bool, PSChunkLargeArrays, true,                                   \
           "Process large arrays in chunks")
 
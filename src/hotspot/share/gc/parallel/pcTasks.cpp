@@ -39,7 +39,9 @@
 #include "oops/objArrayKlass.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vmThread.hpp"
 #include "services/management.hpp"
@@ -196,33 +198,85 @@ void StealMarkingTask::do_it(GCTaskManager* manager, uint which) {
   } while (!terminator()->offer_termination());
 }
 
+//
+// DensePrefixClaimer
+//
+
+void DensePrefixClaimer::add_range(PSParallelCompact::SpaceId space_id,
+                                   size_t beg_region, size_t end_region,
+                                   size_t chunk_size) {
+  assert(_num_ranges < PSParallelCompact::last_space_id, "too many ranges");
+  assert(beg_region < end_region, "empty range");
+  assert(chunk_size > 0, "must claim at least one region");
+  Range* const r = &_ranges[_num_ranges++];
+  r->_space_id = space_id;
+  r->_end_region = end_region;
+  r->_chunk_size = chunk_size;
+  r->_next_region = beg_region;
+}
+
+bool DensePrefixClaimer::claim(PSParallelCompact::SpaceId* space_id,
+                               size_t* beg_region, size_t* end_region) {
+  for (uint i = 0; i < _num_ranges; i++) {
+    Range* const r = &_ranges[i];
+    if (r->_next_region >= r->_end_region) {
+      continue;
+    }
+    const size_t beg = Atomic::add(r->_chunk_size, &r->_next_region) - r->_chunk_size;
+    if (beg < r->_end_region) {
+      *space_id = r->_space_id;
+      *beg_region = beg;
+      *end_region = MIN2(beg + r->_chunk_size, r->_end_region);
+      return true;
+    }
+  }
+  return false;
+}
+
 //
 // CompactionWithStealingTask
 //
 
-CompactionWithStealingTask::CompactionWithStealingTask(ParallelTaskTerminator* t):
-  _terminator(t) {}
+CompactionWithStealingTask::CompactionWithStealingTask(ParallelTaskTerminator* t,
+                                                       DensePrefixClaimer* dense_prefix,
+                                                       CompactionWorkerStats* stats):
+  _terminator(t), _dense_prefix(dense_prefix), _stats(stats) {}
 
 void CompactionWithStealingTask::do_it(GCTaskManager* manager, uint which) {
   assert(ParallelScavengeHeap::heap()->is_gc_active(), "called outside gc");
 
+  const double start = os::elapsedTime();
+  CompactionWorkerStats* const stats = &_stats[which];
+
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
 
   // Drain the stacks that have been preloaded with regions
   // that are ready to fill.
 
-  cm->drain_region_stacks();
+  stats->_regions_filled += cm->drain_region_stacks();
 
   guarantee(cm->region_stack()->is_empty(), "Not empty");
 
   size_t region_index = 0;
   int random_seed = 17;
+  PSParallelCompact::SpaceId space_id;
+  size_t beg_region;
+  size_t end_region;
 
   while(true) {
     if (ParCompactionManager::steal(which, &random_seed, region_index)) {
       PSParallelCompact::fill_and_update_region(cm, region_index);
-      cm->drain_region_stacks();
+      stats->_regions_stolen++;
+      stats->_regions_filled += 1 + cm->drain_region_stacks();
+    } else if (_dense_prefix->claim(&space_id, &beg_region, &end_region)) {
+      // No region is ready to be filled; update part of a dense prefix
+      // while the other workers empty the regions that the rest depend on.
+      PSParallelCompact::update_and_deadwood_in_dense_prefix(cm,
+                                                             space_id,
+                                                             beg_region,
+                                                             end_region);
+      stats->_dense_prefix_regions += end_region - beg_region;
     } else {
       if (terminator()->offer_termination()) {
         break;
@@ -230,23 +284,72 @@ void CompactionWithStealingTask::do_it(GCTaskManager* manager, uint which) {
       // Go around again.
     }
   }
-  return;
+
+  stats->_ran = true;
+  stats->_time_ms += (os::elapsedTime() - start) * MILLIUNITS;
 }
 
-UpdateDensePrefixTask::UpdateDensePrefixTask(
-                                   PSParallelCompact::SpaceId space_id,
-                                   size_t region_index_start,
-                                   size_t region_index_end) :
-  _space_id(space_id), _region_index_start(region_index_start),
-  _region_index_end(region_index_end) {}
+//
+// ParallelSummary
+//
 
-void UpdateDensePrefixTask::do_it(GCTaskManager* manager, uint which) {
+ParallelSummary::ParallelSummary(const SplitInfo& split_info,
+                                 size_t beg_region, size_t end_region,
+                                 uint num_chunks, HeapWord* target_beg) :
+  _split_info(split_info),
+  _beg_region(beg_region),
+  _end_region(end_region),
+  _chunk_size((end_region - beg_region + num_chunks - 1) / num_chunks),
+  _num_chunks(num_chunks),
+  _target_beg(target_beg),
+  _chunk_words(NEW_C_HEAP_ARRAY(size_t, num_chunks, mtGC)),
+  _count_live(true),
+  _claimed(0) {
+  assert(beg_region < end_region, "empty range");
+  assert(num_chunks > 0, "must have a chunk");
+}
 
-  ParCompactionManager* cm =
-    ParCompactionManager::gc_thread_compaction_manager(which);
+ParallelSummary::~ParallelSummary() {
+  FREE_C_HEAP_ARRAY(size_t, _chunk_words);
+}
+
+void ParallelSummary::start_counting() {
+  _count_live = true;
+  _claimed = 0;
+}
+
+HeapWord* ParallelSummary::start_summarizing() {
+  assert(_count_live, "must have counted the live words");
+  size_t offset = 0;
+  for (uint i = 0; i < _num_chunks; i++) {
+    const size_t words = _chunk_words[i];
+    _chunk_words[i] = offset;
+    offset += words;
+  }
+  _count_live = false;
+  _claimed = 0;
+  return _target_beg + offset;
+}
+
+void ParallelSummary::work() {
+  ParallelCompactData& sd = PSParallelCompact::summary_data();
+  uint chunk;
+  while ((chunk = Atomic::add(1u, &_claimed) - 1) < _num_chunks) {
+    const size_t beg = _beg_region + chunk * _chunk_size;
+    const size_t end = MIN2(beg + _chunk_size, _end_region);
+    if (_count_live) {
+      _chunk_words[chunk] = beg < end ? sd.live_words_in_regions(beg, end) : 0;
+    } else if (beg < end) {
+      sd.summarize_regions(_split_info, beg, end,
+                           _target_beg + _chunk_words[chunk]);
+    }
+  }
+}
+
+//
+// ParallelSummaryTask
+//
 
-  PSParallelCompact::update_and_deadwood_in_dense_prefix(cm,
-                                                         _space_id,
-                                                         _region_index_start,
-                                                         _region_index_end);
+void ParallelSummaryTask::do_it(GCTaskManager* manager, uint which) {
+  _summary->work();
 }
@@ -165,17 +165,79 @@ class StealMarkingTask : public GCTask {
   virtual void do_it(GCTaskManager* manager, uint which);
 };
 
+//
+// DensePrefixClaimer
+//
+// Hands out the dense prefixes of the spaces in chunks of regions.  The
+// dense prefix is not moved, so updating it creates no region work; the
+// compaction workers update a chunk whenever they have no region to fill
+// and none to steal, instead of updating a statically partitioned dense
+// prefix before they start filling regions.
+//
+
+class DensePrefixClaimer : public StackObj {
+ private:
+  struct Range {
+    PSParallelCompact::SpaceId _space_id;
+    size_t                     _end_region;
+    size_t                     _chunk_size;
+    volatile size_t            _next_region;
+  };
+
+  Range _ranges[PSParallelCompact::last_space_id];
+  uint  _num_ranges;
+
+ public:
+  DensePrefixClaimer() : _num_ranges(0) {}
+
+  // Add the regions [beg_region, end_region) of the dense prefix of the
+  // space, to be claimed chunk_size regions at a time.
+  void add_range(PSParallelCompact::SpaceId space_id,
+                 size_t beg_region, size_t end_region, size_t chunk_size);
+
+  // Claim the next chunk of regions; return false if all have been claimed.
+  bool claim(PSParallelCompact::SpaceId* space_id,
+             size_t* beg_region, size_t* end_region);
+};
+
+//
+// CompactionWorkerStats
+//
+// The work done by one worker in the compaction phase, logged per worker
+// with gc+phases to show how well the work was balanced.
+//
+
+class CompactionWorkerStats : public CHeapObj<mtGC> {
+ public:
+  bool   _ran;
+  double _time_ms;
+  size_t _regions_filled;
+  size_t _regions_stolen;
+  size_t _dense_prefix_regions;
+
+  CompactionWorkerStats() :
+    _ran(false), _time_ms(0.0), _regions_filled(0), _regions_stolen(0),
+    _dense_prefix_regions(0) {}
+};
+
 //
 // CompactionWithStealingTask
 //
-// This task is used to distribute work to idle threads.
+// This task is used to distribute work to idle threads.  A worker first
+// fills the regions on its own stack, then steals regions from the other
+// workers and, when there is nothing to steal, updates a chunk of a dense
+// prefix.  It offers termination only when no work of either kind is left.
 //
 
 class CompactionWithStealingTask : public GCTask {
  private:
    ParallelTaskTerminator* const _terminator;
+   DensePrefixClaimer* const     _dense_prefix;
+   CompactionWorkerStats* const  _stats;
  public:
-  CompactionWithStealingTask(ParallelTaskTerminator* t);
+  CompactionWithStealingTask(ParallelTaskTerminator* t,
+                             DensePrefixClaimer* dense_prefix,
+                             CompactionWorkerStats* stats);
 
   char* name() { return (char *)"steal-region-task"; }
   ParallelTaskTerminator* terminator() { return _terminator; }
@@ -184,25 +246,60 @@ class CompactionWithStealingTask : public GCTask {
 };
 
 //
-// UpdateDensePrefixTask
+// ParallelSummary
 //
-// This task is used to update the dense prefix
-// of a space.
+// Summarizes a source range that fits entirely into its target in parallel.
+// The regions are split into chunks that workers claim dynamically: the
+// first pass counts the live words of each chunk, which gives the
+// destination of each chunk, and the second pass summarizes the regions of
+// each chunk starting at that destination.
 //
 
-class UpdateDensePrefixTask : public GCTask {
+class ParallelSummary : public StackObj {
  private:
-  PSParallelCompact::SpaceId _space_id;
-  size_t _region_index_start;
-  size_t _region_index_end;
+  const SplitInfo& _split_info;
+  const size_t     _beg_region;
+  const size_t     _end_region;
+  const size_t     _chunk_size;
+  const uint       _num_chunks;
+  HeapWord* const  _target_beg;
+  // The live words of each chunk after the first pass, the destination
+  // offset of each chunk from _target_beg before the second.
+  size_t*          _chunk_words;
+  bool             _count_live;
+  volatile uint    _claimed;
 
  public:
-  char* name() { return (char *)"update-dense_prefix-task"; }
+  ParallelSummary(const SplitInfo& split_info,
+                  size_t beg_region, size_t end_region, uint num_chunks,
+                  HeapWord* target_beg);
+  ~ParallelSummary();
+
+  // Start counting the live words of the chunks.
+  void start_counting();
+  // Compute the destination of each chunk and start summarizing the
+  // regions.  Return the address following the last live word.
+  HeapWord* start_summarizing();
+
+  // Claim and process chunks until none are left.
+  void work();
+};
 
-  UpdateDensePrefixTask(PSParallelCompact::SpaceId space_id,
-                        size_t region_index_start,
-                        size_t region_index_end);
+//
+// ParallelSummaryTask
+//
+// Processes chunks of a ParallelSummary for the current pass.
+//
+
+class ParallelSummaryTask : public GCTask {
+ private:
+  ParallelSummary* const _summary;
+ public:
+  ParallelSummaryTask(ParallelSummary* summary) : _summary(summary) {}
+
+  char* name() { return (char *)"parallel-summary-task"; }
 
   virtual void do_it(GCTaskManager* manager, uint which);
 };
+
 #endif // SHARE_VM_GC_PARALLEL_PCTASKS_HPP
@@ -260,16 +260,20 @@ void ParCompactionManager::follow_marking_stacks() {
   assert(marking_stacks_empty(), "Sanity");
 }
 
-void ParCompactionManager::drain_region_stacks() {
+size_t ParCompactionManager::drain_region_stacks() {
+  size_t filled = 0;
   do {
     // Drain overflow stack first so other threads can steal.
     size_t region_index;
     while (region_stack()->pop_overflow(region_index)) {
       PSParallelCompact::fill_and_update_region(this, region_index);
+      filled++;
     }
 
     while (region_stack()->pop_local(region_index)) {
       PSParallelCompact::fill_and_update_region(this, region_index);
+      filled++;
     }
   } while (!region_stack()->is_empty());
+  return filled;
 }
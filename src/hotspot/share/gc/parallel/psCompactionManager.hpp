@@ -167,8 +167,8 @@ private:
   void follow_marking_stacks();
   inline bool marking_stacks_empty() const;
 
-  // Process tasks remaining on any stack
-  void drain_region_stacks();
+  // Process tasks remaining on any stack; return the number of regions filled.
+  size_t drain_region_stacks();
 
   void follow_contents(oop obj);
   void follow_contents(objArrayOop array, int index);
@@ -48,6 +48,7 @@
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
@@ -572,6 +573,12 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
     StringTable::unlink(is_alive_closure());
   }
 
+  if (StringDedup::is_enabled()) {
+    GCTraceTime(Debug, gc, phases) t("Scrub String Deduplication", _gc_timer);
+    // Delete dead deduplication candidates and table entries.
+    StringDedup::unlink_or_oops_do(is_alive_closure(), NULL, false /* allow_resize_and_rehash */);
+  }
+
   {
     GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", _gc_timer);
     // Clean up unreferenced symbols in symbol table.
@@ -631,6 +638,9 @@ void PSMarkSweep::mark_sweep_phase3() {
   CodeCache::blobs_do(&adjust_from_blobs);
   AOTLoader::oops_do(adjust_pointer_closure());
   StringTable::oops_do(adjust_pointer_closure());
+  if (StringDedup::is_enabled()) {
+    StringDedup::oops_do(adjust_pointer_closure());
+  }
   ref_processor()->weak_oops_do(adjust_pointer_closure());
   PSScavenge::reference_processor()->weak_oops_do(adjust_pointer_closure());
 
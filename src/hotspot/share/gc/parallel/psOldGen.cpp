@@ -327,6 +327,7 @@ void PSOldGen::shrink(size_t bytes) {
   size_t size = align_down(bytes, virtual_space()->alignment());
   if (size > 0) {
     assert_lock_strong(ExpandHeap_lock);
+    ParallelScavengeHeap::heap()->abort_pretouch();
     virtual_space()->shrink_by(bytes);
     post_resize();
 
@@ -52,6 +52,7 @@
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
@@ -683,6 +684,58 @@ ParallelCompactData::summarize_split_space(size_t src_region,
   return source_next;
 }
 
+void ParallelCompactData::summarize_region(const SplitInfo& split_info,
+                                           size_t cur_region,
+                                           HeapWord* dest_addr, size_t words)
+{
+  assert(words > 0, "only regions with live data have destinations");
+  // Compute the destination_count for cur_region, and if necessary, update
+  // source_region for a destination region.  The source_region field is
+  // updated if cur_region is the first (left-most) region to be copied to a
+  // destination region.
+  //
+  // The destination_count calculation is a bit subtle.  A region that has
+  // data that compacts into itself does not count itself as a destination.
+  // This maintains the invariant that a zero count means the region is
+  // available and can be claimed and then filled.
+  uint destination_count = 0;
+  if (split_info.is_split(cur_region)) {
+    // The current region has been split:  the partial object will be copied
+    // to one destination space and the remaining data will be copied to
+    // another destination space.  Adjust the initial destination_count and,
+    // if necessary, set the source_region field if the partial object will
+    // cross a destination region boundary.
+    destination_count = split_info.destination_count();
+    if (destination_count == 2) {
+      size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
+      _region_data[dest_idx].set_source_region(cur_region);
+    }
+  }
+
+  HeapWord* const last_addr = dest_addr + words - 1;
+  const size_t dest_region_1 = addr_to_region_idx(dest_addr);
+  const size_t dest_region_2 = addr_to_region_idx(last_addr);
+
+  // Initially assume that the destination regions will be the same and
+  // adjust the value below if necessary.  Under this assumption, if
+  // cur_region == dest_region_2, then cur_region will be compacted
+  // completely into itself.
+  destination_count += cur_region == dest_region_2 ? 0 : 1;
+  if (dest_region_1 != dest_region_2) {
+    // Destination regions differ; adjust destination_count.
+    destination_count += 1;
+    // Data from cur_region will be copied to the start of dest_region_2.
+    _region_data[dest_region_2].set_source_region(cur_region);
+  } else if (region_offset(dest_addr) == 0) {
+    // Data from cur_region will be copied to the start of the destination
+    // region.
+    _region_data[dest_region_1].set_source_region(cur_region);
+  }
+
+  _region_data[cur_region].set_destination_count(destination_count);
+  _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+}
+
 bool ParallelCompactData::summarize(SplitInfo& split_info,
                                     HeapWord* source_beg, HeapWord* source_end,
                                     HeapWord** source_next,
@@ -716,51 +769,7 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
         return false;
       }
 
-      // Compute the destination_count for cur_region, and if necessary, update
-      // source_region for a destination region.  The source_region field is
-      // updated if cur_region is the first (left-most) region to be copied to a
-      // destination region.
-      //
-      // The destination_count calculation is a bit subtle.  A region that has
-      // data that compacts into itself does not count itself as a destination.
-      // This maintains the invariant that a zero count means the region is
-      // available and can be claimed and then filled.
-      uint destination_count = 0;
-      if (split_info.is_split(cur_region)) {
-        // The current region has been split:  the partial object will be copied
-        // to one destination space and the remaining data will be copied to
-        // another destination space.  Adjust the initial destination_count and,
-        // if necessary, set the source_region field if the partial object will
-        // cross a destination region boundary.
-        destination_count = split_info.destination_count();
-        if (destination_count == 2) {
-          size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
-          _region_data[dest_idx].set_source_region(cur_region);
-        }
-      }
-
-      HeapWord* const last_addr = dest_addr + words - 1;
-      const size_t dest_region_1 = addr_to_region_idx(dest_addr);
-      const size_t dest_region_2 = addr_to_region_idx(last_addr);
-
-      // Initially assume that the destination regions will be the same and
-      // adjust the value below if necessary.  Under this assumption, if
-      // cur_region == dest_region_2, then cur_region will be compacted
-      // completely into itself.
-      destination_count += cur_region == dest_region_2 ? 0 : 1;
-      if (dest_region_1 != dest_region_2) {
-        // Destination regions differ; adjust destination_count.
-        destination_count += 1;
-        // Data from cur_region will be copied to the start of dest_region_2.
-        _region_data[dest_region_2].set_source_region(cur_region);
-      } else if (region_offset(dest_addr) == 0) {
-        // Data from cur_region will be copied to the start of the destination
-        // region.
-        _region_data[dest_region_1].set_source_region(cur_region);
-      }
-
-      _region_data[cur_region].set_destination_count(destination_count);
-      _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+      summarize_region(split_info, cur_region, dest_addr, words);
       dest_addr += words;
     }
 
@@ -771,6 +780,34 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
   return true;
 }
 
+HeapWord* ParallelCompactData::summarize_regions(const SplitInfo& split_info,
+                                                 size_t beg_region,
+                                                 size_t end_region,
+                                                 HeapWord* dest_addr)
+{
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    // The destination must be set even if the region has no data.
+    _region_data[cur_region].set_destination(dest_addr);
+
+    const size_t words = _region_data[cur_region].data_size();
+    if (words > 0) {
+      summarize_region(split_info, cur_region, dest_addr, words);
+      dest_addr += words;
+    }
+  }
+  return dest_addr;
+}
+
+size_t ParallelCompactData::live_words_in_regions(size_t beg_region,
+                                                  size_t end_region) const
+{
+  size_t words = 0;
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    words += _region_data[cur_region].data_size();
+  }
+  return words;
+}
+
 HeapWord* ParallelCompactData::calc_new_pointer(HeapWord* addr, ParCompactionManager* cm) {
   assert(addr != NULL, "Should detect NULL oop earlier");
   assert(ParallelScavengeHeap::heap()->is_in(addr), "not in heap");
@@ -1417,15 +1454,103 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
   return sd.region_to_addr(best_cp);
 }
 
+// The number of chunks per worker in a parallel summary.
+#define PAR_OLD_SUMMARY_OVER_PARTITIONING 4
+
+void PSParallelCompact::summarize_fitting(SplitInfo& split_info,
+                                          HeapWord* source_beg,
+                                          HeapWord* source_end,
+                                          HeapWord* target_beg,
+                                          HeapWord* target_end,
+                                          HeapWord** target_next)
+{
+  ParallelCompactData& sd = summary_data();
+  const size_t beg_region = sd.addr_to_region_idx(source_beg);
+  const size_t end_region =
+    sd.addr_to_region_idx(sd.region_align_up(source_end));
+  const uint active_gc_threads = gc_task_manager()->active_workers();
+  const size_t max_chunks = (end_region - beg_region) /
+                            ParallelOldSummaryMinChunkRegions;
+  const uint num_chunks =
+    (uint)MIN2(max_chunks,
+               (size_t)active_gc_threads * PAR_OLD_SUMMARY_OVER_PARTITIONING);
+
+  if (active_gc_threads < 2 || num_chunks < 2) {
+    bool done = sd.summarize(split_info, source_beg, source_end, NULL,
+                             target_beg, target_end, target_next);
+    assert(done, "source must fit into target");
+    return;
+  }
+
+  log_develop_trace(gc, compaction)(
+      "Parallel summary sb=" PTR_FORMAT " se=" PTR_FORMAT
+      " tb=" PTR_FORMAT " te=" PTR_FORMAT " chunks=%u",
+      p2i(source_beg), p2i(source_end), p2i(target_beg), p2i(target_end),
+      num_chunks);
+
+#ifdef ASSERT
+  // Save the regions the summary may write, to check the parallel result
+  // against a serial summary of the same range below.
+  const size_t check_beg =
+    MIN2(beg_region, sd.addr_to_region_idx(target_beg));
+  const size_t check_end =
+    MAX2(end_region, sd.addr_to_region_idx(sd.region_align_up(target_end)));
+  const size_t check_count = check_end - check_beg;
+  RegionData* const saved = NEW_C_HEAP_ARRAY(RegionData, check_count, mtGC);
+  RegionData* const parallel = NEW_C_HEAP_ARRAY(RegionData, check_count, mtGC);
+  memcpy(saved, sd.region(check_beg), check_count * sizeof(RegionData));
+#endif
+
+  ParallelSummary summary(split_info, beg_region, end_region, num_chunks,
+                          target_beg);
+
+  // Count the live words of each chunk.
+  summary.start_counting();
+  GCTaskQueue* q = GCTaskQueue::create();
+  for (uint i = 0; i < active_gc_threads; i++) {
+    q->enqueue(new ParallelSummaryTask(&summary));
+  }
+  gc_task_manager()->execute_and_wait(q);
+
+  // Summarize the regions of each chunk, now that its destination is known.
+  HeapWord* const dest_end = summary.start_summarizing();
+  assert(dest_end <= target_end, "source must fit into target");
+  q = GCTaskQueue::create();
+  for (uint i = 0; i < active_gc_threads; i++) {
+    q->enqueue(new ParallelSummaryTask(&summary));
+  }
+  gc_task_manager()->execute_and_wait(q);
+
+#ifdef ASSERT
+  memcpy(parallel, sd.region(check_beg), check_count * sizeof(RegionData));
+  memcpy(sd.region(check_beg), saved, check_count * sizeof(RegionData));
+  HeapWord* serial_end = NULL;
+  bool done = sd.summarize(split_info, source_beg, source_end, NULL,
+                           target_beg, target_end, &serial_end);
+  assert(done, "source must fit into target");
+  assert(serial_end == dest_end, "parallel summary ends at " PTR_FORMAT
+         ", serial summary at " PTR_FORMAT, p2i(dest_end), p2i(serial_end));
+  for (size_t i = 0; i < check_count; i++) {
+    assert(memcmp(&parallel[i], sd.region(check_beg + i),
+                  sizeof(RegionData)) == 0,
+           "parallel and serial summary differ at region " SIZE_FORMAT,
+           check_beg + i);
+  }
+  FREE_C_HEAP_ARRAY(RegionData, parallel);
+  FREE_C_HEAP_ARRAY(RegionData, saved);
+#endif
+
+  *target_next = dest_end;
+}
+
 void PSParallelCompact::summarize_spaces_quick()
 {
   for (unsigned int i = 0; i < last_space_id; ++i) {
     const MutableSpace* space = _space_info[i].space();
     HeapWord** nta = _space_info[i].new_top_addr();
-    bool result = _summary_data.summarize(_space_info[i].split_info(),
-                                          space->bottom(), space->top(), NULL,
-                                          space->bottom(), space->end(), nta);
-    assert(result, "space must fit into itself");
+    summarize_fitting(_space_info[i].split_info(),
+                      space->bottom(), space->top(),
+                      space->bottom(), space->end(), nta);
     _space_info[i].set_dense_prefix(space->bottom());
   }
 }
@@ -1531,10 +1656,10 @@ PSParallelCompact::summarize_space(SpaceId id, bool maximum_compaction)
 
       // Compute the destination of each Region, and thus each object.
       _summary_data.summarize_dense_prefix(space->bottom(), dense_prefix_end);
-      _summary_data.summarize(_space_info[id].split_info(),
-                              dense_prefix_end, space->top(), NULL,
-                              dense_prefix_end, space->end(),
-                              _space_info[id].new_top_addr());
+      summarize_fitting(_space_info[id].split_info(),
+                        dense_prefix_end, space->top(),
+                        dense_prefix_end, space->end(),
+                        _space_info[id].new_top_addr());
     }
   }
 
@@ -1636,12 +1761,10 @@ void PSParallelCompact::summary_phase(ParCompactionManager* cm,
                                   SpaceId(id), space->bottom(), space->top());)
     if (live > 0 && live <= available) {
       // All the live data will fit.
-      bool done = _summary_data.summarize(_space_info[id].split_info(),
-                                          space->bottom(), space->top(),
-                                          NULL,
-                                          *new_top_addr, dst_space_end,
-                                          new_top_addr);
-      assert(done, "space must fit into old gen");
+      summarize_fitting(_space_info[id].split_info(),
+                        space->bottom(), space->top(),
+                        *new_top_addr, dst_space_end,
+                        new_top_addr);
 
       // Reset the new_top value for the space.
       _space_info[id].set_new_top(space->bottom());
@@ -1664,12 +1787,10 @@ void PSParallelCompact::summary_phase(ParCompactionManager* cm,
       NOT_PRODUCT(summary_phase_msg(dst_space_id,
                                     space->bottom(), dst_space_end,
                                     SpaceId(id), next_src_addr, space->top());)
-      done = _summary_data.summarize(_space_info[id].split_info(),
-                                     next_src_addr, space->top(),
-                                     NULL,
-                                     space->bottom(), dst_space_end,
-                                     new_top_addr);
-      assert(done, "space must fit when compacted into itself");
+      summarize_fitting(_space_info[id].split_info(),
+                        next_src_addr, space->top(),
+                        space->bottom(), dst_space_end,
+                        new_top_addr);
       assert(*new_top_addr <= space->top(), "usage should not grow");
     }
   }
@@ -2162,6 +2283,12 @@ void PSParallelCompact::marking_phase(ParCompactionManager* cm,
     StringTable::unlink(is_alive_closure());
   }
 
+  if (StringDedup::is_enabled()) {
+    GCTraceTime(Debug, gc, phases) t("Scrub String Deduplication", &_gc_timer);
+    // Delete dead deduplication candidates and table entries.
+    StringDedup::unlink_or_oops_do(is_alive_closure(), NULL, false /* allow_resize_and_rehash */);
+  }
+
   {
     GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", &_gc_timer);
     // Clean up unreferenced symbols in symbol table.
@@ -2198,6 +2325,9 @@ void PSParallelCompact::adjust_roots(ParCompactionManager* cm) {
   CodeCache::blobs_do(&adjust_from_blobs);
   AOTLoader::oops_do(&oop_closure);
   StringTable::oops_do(&oop_closure);
+  if (StringDedup::is_enabled()) {
+    StringDedup::oops_do(&oop_closure);
+  }
   ref_processor()->weak_oops_do(&oop_closure);
   // Roots were visited so references into the young gen in roots
   // may have been scanned.  Process them also.
@@ -2289,16 +2419,15 @@ void PSParallelCompact::prepare_region_draining_tasks(GCTaskQueue* q,
 
 #define PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING 4
 
-void PSParallelCompact::enqueue_dense_prefix_tasks(GCTaskQueue* q,
-                                                    uint parallel_gc_threads) {
-  GCTraceTime(Trace, gc, phases) tm("Dense Prefix Task Setup", &_gc_timer);
+void PSParallelCompact::prepare_dense_prefix_claimer(DensePrefixClaimer* claimer,
+                                                     uint parallel_gc_threads) {
+  GCTraceTime(Trace, gc, phases) tm("Dense Prefix Claimer Setup", &_gc_timer);
 
   ParallelCompactData& sd = PSParallelCompact::summary_data();
 
-  // Iterate over all the spaces adding tasks for updating
-  // regions in the dense prefix.  Assume that 1 gc thread
-  // will work on opening the gaps and the remaining gc threads
-  // will work on the dense prefix.
+  // Add the dense prefix of each space.  The workers claim chunks of it
+  // whenever they run out of regions to fill, so the chunks are small enough
+  // to balance the work but large enough to keep the claiming cheap.
   unsigned int space_id;
   for (space_id = old_space_id; space_id < last_space_id; ++ space_id) {
     HeapWord* const dense_prefix_end = _space_info[space_id].dense_prefix();
@@ -2324,47 +2453,15 @@ void PSParallelCompact::enqueue_dense_prefix_tasks(GCTaskQueue* q,
     // Is there dense prefix work?
     size_t total_dense_prefix_regions =
       region_index_end_dense_prefix - region_index_start;
-    // How many regions of the dense prefix should be given to
-    // each thread?
     if (total_dense_prefix_regions > 0) {
-      uint tasks_for_dense_prefix = 1;
-      if (total_dense_prefix_regions <=
-          (parallel_gc_threads * PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING)) {
-        // Don't over partition.  This assumes that
-        // PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING is a small integer value
-        // so there are not many regions to process.
-        tasks_for_dense_prefix = parallel_gc_threads;
-      } else {
-        // Over partition
-        tasks_for_dense_prefix = parallel_gc_threads *
-          PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING;
-      }
-      size_t regions_per_thread = total_dense_prefix_regions /
-        tasks_for_dense_prefix;
-      // Give each thread at least 1 region.
-      if (regions_per_thread == 0) {
-        regions_per_thread = 1;
-      }
-
-      for (uint k = 0; k < tasks_for_dense_prefix; k++) {
-        if (region_index_start >= region_index_end_dense_prefix) {
-          break;
-        }
-        // region_index_end is not processed
-        size_t region_index_end = MIN2(region_index_start + regions_per_thread,
-                                       region_index_end_dense_prefix);
-        q->enqueue(new UpdateDensePrefixTask(SpaceId(space_id),
-                                             region_index_start,
-                                             region_index_end));
-        region_index_start = region_index_end;
-      }
-    }
-    // This gets any part of the dense prefix that did not
-    // fit evenly.
-    if (region_index_start < region_index_end_dense_prefix) {
-      q->enqueue(new UpdateDensePrefixTask(SpaceId(space_id),
-                                           region_index_start,
-                                           region_index_end_dense_prefix));
+      // How many regions of the dense prefix should be claimed at a time?
+      // Over partition, but give each claim at least 1 region.
+      size_t regions_per_chunk = total_dense_prefix_regions /
+        (parallel_gc_threads * PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING);
+      claimer->add_range(SpaceId(space_id),
+                         region_index_start,
+                         region_index_end_dense_prefix,
+                         MAX2(regions_per_chunk, (size_t)1));
     }
   }
 }
@@ -2372,13 +2469,57 @@ void PSParallelCompact::enqueue_dense_prefix_tasks(GCTaskQueue* q,
 void PSParallelCompact::enqueue_region_stealing_tasks(
                                      GCTaskQueue* q,
                                      ParallelTaskTerminator* terminator_ptr,
+                                     DensePrefixClaimer* dense_prefix,
+                                     CompactionWorkerStats* stats,
                                      uint parallel_gc_threads) {
   GCTraceTime(Trace, gc, phases) tm("Steal Task Setup", &_gc_timer);
 
   // Once a thread has drained it's stack, it should try to steal regions from
   // other threads.
   for (uint j = 0; j < parallel_gc_threads; j++) {
-    q->enqueue(new CompactionWithStealingTask(terminator_ptr));
+    q->enqueue(new CompactionWithStealingTask(terminator_ptr, dense_prefix,
+                                              stats));
+  }
+}
+
+void PSParallelCompact::log_compaction_worker_stats(const CompactionWorkerStats* stats,
+                                                    uint num_workers) {
+  LogTarget(Debug, gc, phases) lt;
+  if (!lt.is_enabled()) {
+    return;
+  }
+
+  uint ran = 0;
+  double min_ms = 0.0;
+  double max_ms = 0.0;
+  double sum_ms = 0.0;
+  for (uint i = 0; i < num_workers; i++) {
+    if (!stats[i]._ran) {
+      continue;
+    }
+    const double ms = stats[i]._time_ms;
+    min_ms = ran == 0 ? ms : MIN2(min_ms, ms);
+    max_ms = ran == 0 ? ms : MAX2(max_ms, ms);
+    sum_ms += ms;
+    ran++;
+  }
+  if (ran == 0) {
+    return;
+  }
+  lt.print("Compaction Workers (ms): Min: %.1lf, Avg: %.1lf, Max: %.1lf, Diff: %.1lf, Sum: %.1lf, Workers: %u",
+           min_ms, sum_ms / ran, max_ms, max_ms - min_ms, sum_ms, ran);
+
+  LogTarget(Trace, gc, phases) lt_worker;
+  if (lt_worker.is_enabled()) {
+    for (uint i = 0; i < num_workers; i++) {
+      const CompactionWorkerStats* s = &stats[i];
+      if (s->_ran) {
+        lt_worker.print("  Worker %u: %.1lfms, regions filled: " SIZE_FORMAT
+                        " (stolen: " SIZE_FORMAT "), dense prefix regions: " SIZE_FORMAT,
+                        i, s->_time_ms, s->_regions_filled, s->_regions_stolen,
+                        s->_dense_prefix_regions);
+      }
+    }
   }
 }
 
@@ -2435,16 +2576,29 @@ void PSParallelCompact::compact() {
   TaskQueueSetSuper* qset = ParCompactionManager::region_array();
   ParallelTaskTerminator terminator(active_gc_threads, qset);
 
+  // The workers are indexed by their GCTaskThread id, which may exceed the
+  // number of active workers.
+  CompactionWorkerStats* const stats =
+    NEW_C_HEAP_ARRAY(CompactionWorkerStats, parallel_gc_threads, mtGC);
+  for (uint i = 0; i < parallel_gc_threads; i++) {
+    stats[i] = CompactionWorkerStats();
+  }
+  DensePrefixClaimer dense_prefix;
+
   GCTaskQueue* q = GCTaskQueue::create();
   prepare_region_draining_tasks(q, active_gc_threads);
-  enqueue_dense_prefix_tasks(q, active_gc_threads);
-  enqueue_region_stealing_tasks(q, &terminator, active_gc_threads);
+  prepare_dense_prefix_claimer(&dense_prefix, active_gc_threads);
+  enqueue_region_stealing_tasks(q, &terminator, &dense_prefix, stats,
+                                active_gc_threads);
 
   {
     GCTraceTime(Trace, gc, phases) tm("Par Compact", &_gc_timer);
 
     gc_task_manager()->execute_and_wait(q);
 
+    log_compaction_worker_stats(stats, parallel_gc_threads);
+    FREE_C_HEAP_ARRAY(CompactionWorkerStats, stats);
+
 #ifdef  ASSERT
     // Verify that all regions have been processed before the deferred updates.
     for (unsigned int id = old_space_id; id < last_space_id; ++id) {
@@ -47,6 +47,8 @@ class MoveAndUpdateClosure;
 class RefProcTaskExecutor;
 class ParallelOldTracer;
 class STWGCTimer;
+class DensePrefixClaimer;
+class CompactionWorkerStats;
 
 // The SplitInfo class holds the information needed to 'split' a source region
 // so that the live data can be copied to two destination *spaces*.  Normally,
@@ -412,6 +414,18 @@ public:
                  HeapWord* target_beg, HeapWord* target_end,
                  HeapWord** target_next);
 
+  // Summarize the regions [beg_region, end_region) of a source range that is
+  // known to fit into its target, starting with the data of beg_region at
+  // dest_addr.  Return the address following the last word summarized.  The
+  // regions of a fitting range can be summarized in independent chunks once
+  // the destination of each chunk is known.
+  HeapWord* summarize_regions(const SplitInfo& split_info,
+                              size_t beg_region, size_t end_region,
+                              HeapWord* dest_addr);
+
+  // Return the number of live words in the regions [beg_region, end_region).
+  size_t live_words_in_regions(size_t beg_region, size_t end_region) const;
+
   void clear();
   void clear_range(size_t beg_region, size_t end_region);
   void clear_range(HeapWord* beg, HeapWord* end) {
@@ -465,6 +479,11 @@ public:
 private:
   bool initialize_block_data();
   bool initialize_region_data(size_t region_size);
+  // Set the destination_count of cur_region, which holds words live words
+  // that are copied to dest_addr, and the source_region of the destination
+  // region(s) it is the first to be copied to.
+  void summarize_region(const SplitInfo& split_info, size_t cur_region,
+                        HeapWord* dest_addr, size_t words);
   PSVirtualSpace* create_vspace(size_t count, size_t element_size);
 
 private:
@@ -1054,6 +1073,13 @@ class PSParallelCompact : AllStatic {
   // non-empty.
   static void fill_dense_prefix_end(SpaceId id);
 
+  // Summarize [source_beg, source_end), which must fit entirely into
+  // [target_beg, target_end).  Large ranges are summarized in parallel.
+  static void summarize_fitting(SplitInfo& split_info,
+                                HeapWord* source_beg, HeapWord* source_end,
+                                HeapWord* target_beg, HeapWord* target_end,
+                                HeapWord** target_next);
+
   static void summarize_spaces_quick();
   static void summarize_space(SpaceId id, bool maximum_compaction);
   static void summary_phase(ParCompactionManager* cm, bool maximum_compaction);
@@ -1071,16 +1097,23 @@ class PSParallelCompact : AllStatic {
   static void prepare_region_draining_tasks(GCTaskQueue* q,
                                             uint parallel_gc_threads);
 
-  // Add dense prefix update tasks to the task queue.
-  static void enqueue_dense_prefix_tasks(GCTaskQueue* q,
-                                         uint parallel_gc_threads);
+  // Add the dense prefixes to the claimer, split into chunks that the
+  // compaction workers claim when they have no regions to fill.
+  static void prepare_dense_prefix_claimer(DensePrefixClaimer* claimer,
+                                           uint parallel_gc_threads);
 
   // Add region stealing tasks to the task queue.
   static void enqueue_region_stealing_tasks(
                                        GCTaskQueue* q,
                                        ParallelTaskTerminator* terminator_ptr,
+                                       DensePrefixClaimer* dense_prefix,
+                                       CompactionWorkerStats* stats,
                                        uint parallel_gc_threads);
 
+  // Log the work done by each compaction worker.
+  static void log_compaction_worker_stats(const CompactionWorkerStats* stats,
+                                          uint num_workers);
+
   // If objects are left in eden after a collection, try to move the boundary
   // and absorb them into the old gen.  Returns true if eden was emptied.
   static bool absorb_live_data_from_eden(PSAdaptiveSizePolicy* size_policy,
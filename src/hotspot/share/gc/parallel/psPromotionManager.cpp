@@ -86,6 +86,7 @@ void PSPromotionManager::initialize() {
   _preserved_marks_set->init(promotion_manager_num);
   for (uint i = 0; i < promotion_manager_num; i += 1) {
     _manager_array[i].register_preserved_marks(_preserved_marks_set->get(i));
+    _manager_array[i]._index = i;
   }
 }
 
@@ -217,6 +218,7 @@ PSPromotionManager::PSPromotionManager() {
   _min_array_size_for_chunking = 3 * _array_chunk_size / 2;
 
   _preserved_marks = NULL;
+  _index = 0;
 
   reset();
 }
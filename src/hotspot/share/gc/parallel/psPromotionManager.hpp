@@ -88,6 +88,10 @@ class PSPromotionManager {
   PreservedMarks*                     _preserved_marks;
   PromotionFailedInfo                 _promotion_failed_info;
 
+  // Index into the manager array, also used as the string
+  // deduplication queue for candidates copied by this manager.
+  uint                                _index;
+
   // Accessors
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
@@ -31,6 +31,7 @@
 #include "gc/parallel/psPromotionLAB.inline.hpp"
 #include "gc/parallel/psPromotionManager.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "logging/log.hpp"
 #include "oops/access.inline.hpp"
@@ -226,6 +227,10 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
         assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
       }
 
+      if (StringDedup::is_enabled()) {
+        StringDedup::enqueue_from_young_copy(!new_obj_is_tenured, _index, new_obj);
+      }
+
       // Do the size comparison first with new_obj_size, which we
       // already have. Hopefully, only a few objects are larger than
       // _min_array_size_for_chunking, and most of them will be arrays.
@@ -45,6 +45,7 @@
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
@@ -110,6 +111,24 @@ public:
   virtual void do_oop(narrowOop* p) { PSKeepAliveClosure::do_oop_work(p); }
 };
 
+// String deduplication candidates are queued as they are copied, so the queue
+// refers to objects copied to to-space by this scavenge.  Those are live
+// although, unlike the rest of the young generation, they are not forwarded.
+class PSStringDedupIsAliveClosure: public BoolObjectClosure {
+ private:
+  MutableSpace* _to_space;
+
+ public:
+  PSStringDedupIsAliveClosure() {
+    _to_space = ParallelScavengeHeap::heap()->young_gen()->to_space();
+  }
+
+  bool do_object_b(oop p) {
+    return _to_space->contains(p) ||
+           !PSScavenge::is_obj_in_young(p) || p->is_forwarded();
+  }
+};
+
 class PSEvacuateFollowersClosure: public VoidClosure {
  private:
   PSPromotionManager* _promotion_manager;
@@ -437,6 +456,15 @@ bool PSScavenge::invoke_no_policy() {
       StringTable::unlink_or_oops_do(&_is_alive_closure, &root_closure);
     }
 
+    if (StringDedup::is_enabled()) {
+      GCTraceTime(Debug, gc, phases) tm("String Deduplication", &_gc_timer);
+      // Unlink dead deduplication candidates and update the remaining ones.
+      // The keep alive closure skips the candidates already in to-space.
+      PSStringDedupIsAliveClosure dedup_is_alive;
+      PSKeepAliveClosure dedup_keep_alive(promotion_manager);
+      StringDedup::unlink_or_oops_do(&dedup_is_alive, &dedup_keep_alive, true /* allow_resize_and_rehash */);
+    }
+
     // Verify that usage of root_closure didn't copy any objects.
     assert(promotion_manager->stacks_empty(),"stacks should be empty at this point");
 
@@ -43,6 +43,7 @@
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/space.inline.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "logging/log.hpp"
@@ -73,6 +74,10 @@ bool DefNewGeneration::IsAliveClosure::do_object_b(oop p) {
   return (HeapWord*)p >= _young_gen->reserved().end() || p->is_forwarded();
 }
 
+bool DefNewGeneration::StringDedupIsAliveClosure::do_object_b(oop p) {
+  return _young_gen->to()->is_in_reserved(p) || _is_alive->do_object_b(p);
+}
+
 DefNewGeneration::KeepAliveClosure::
 KeepAliveClosure(ScanWeakRefClosure* cl) : _cl(cl) {
   _rs = GenCollectedHeap::heap()->rem_set();
@@ -633,6 +638,11 @@ void DefNewGeneration::collect(bool   full,
 
   WeakProcessor::weak_oops_do(&is_alive, &keep_alive);
 
+  if (StringDedup::is_enabled()) {
+    StringDedupIsAliveClosure dedup_is_alive(this, &is_alive);
+    StringDedup::unlink_or_oops_do(&dedup_is_alive, &keep_alive, true /* allow_resize_and_rehash */);
+  }
+
   // Verify that the usage of keep_alive didn't copy any objects.
   assert(heap->no_allocs_since_save_marks(), "save marks have not been newly set.");
 
@@ -751,6 +761,7 @@ oop DefNewGeneration::copy_to_survivor_space(oop old) {
   }
 
   // Otherwise try allocating obj tenured
+  const bool to_young = obj != NULL;
   if (obj == NULL) {
     obj = _old_gen->promote(old, s);
     if (obj == NULL) {
@@ -770,6 +781,11 @@ oop DefNewGeneration::copy_to_survivor_space(oop old) {
     age_table()->add(obj, s);
   }
 
+  if (StringDedup::is_enabled()) {
+    // Collection is done by the VM thread, which uses the first queue.
+    StringDedup::enqueue_from_young_copy(to_young, 0, obj);
+  }
+
   // Done, insert forward pointer to obj in this header
   old->forward_to(obj);
 
@@ -158,6 +158,20 @@ protected:
     bool do_object_b(oop p);
   };
 
+  // String deduplication candidates are queued as they are copied, so the
+  // queue refers to objects copied to to-space by this collection.  Those
+  // are live although, unlike the rest of the young generation, they are
+  // not forwarded.
+  class StringDedupIsAliveClosure: public BoolObjectClosure {
+    DefNewGeneration* _young_gen;
+    IsAliveClosure*   _is_alive;
+  public:
+    StringDedupIsAliveClosure(DefNewGeneration* young_gen,
+                              IsAliveClosure* is_alive) :
+      _young_gen(young_gen), _is_alive(is_alive) {}
+    bool do_object_b(oop p);
+  };
+
   class KeepAliveClosure: public OopClosure {
   protected:
     ScanWeakRefClosure* _cl;
@@ -43,6 +43,7 @@
 #include "gc/shared/referencePolicy.hpp"
 #include "gc/shared/referenceProcessorPhaseTimes.hpp"
 #include "gc/shared/space.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/weakProcessor.hpp"
 #include "oops/instanceRefKlass.hpp"
@@ -244,6 +245,12 @@ void GenMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
     StringTable::unlink(&is_alive);
   }
 
+  if (StringDedup::is_enabled()) {
+    GCTraceTime(Debug, gc, phases) t("Scrub String Deduplication", gc_timer());
+    // Delete dead deduplication candidates and table entries.
+    StringDedup::unlink_or_oops_do(&is_alive, NULL, false /* allow_resize_and_rehash */);
+  }
+
   {
     GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", gc_timer());
     // Clean up unreferenced symbols in symbol table.
@@ -309,6 +316,9 @@ void GenMarkSweep::mark_sweep_phase3() {
   }
 
   gch->gen_process_weak_roots(&adjust_pointer_closure);
+  if (StringDedup::is_enabled()) {
+    StringDedup::oops_do(&adjust_pointer_closure);
+  }
 
   adjust_marks();
   GenAdjustPointersClosure blk;
@@ -23,10 +23,14 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "gc/serial/defNewGeneration.inline.hpp"
 #include "gc/serial/serialHeap.hpp"
 #include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/genMemoryPools.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
 #include "services/memoryManager.hpp"
 
 SerialHeap* SerialHeap::heap() {
@@ -48,6 +52,16 @@ SerialHeap::SerialHeap(GenCollectorPolicy* policy) :
   _old_manager = new GCMemoryManager("MarkSweepCompact", "end of major GC");
 }
 
+jint SerialHeap::initialize() {
+  jint status = GenCollectedHeap::initialize();
+  if (status != JNI_OK) return status;
+
+  // Initialize string deduplication
+  StringDedup::initialize();
+
+  return JNI_OK;
+}
+
 void SerialHeap::initialize_serviceability() {
 
   DefNewGeneration* young = young_gen();
@@ -90,3 +104,51 @@ GrowableArray<MemoryPool*> SerialHeap::memory_pools() {
   memory_pools.append(_old_pool);
   return memory_pools;
 }
+
+void SerialHeap::stop() {
+  if (StringDedup::is_enabled()) {
+    StringDedup::stop();
+  }
+}
+
+// The deduplication thread is the only concurrent thread of the Serial
+// collector, and it joins the suspendible thread set.
+void SerialHeap::safepoint_synchronize_begin() {
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
+}
+
+void SerialHeap::safepoint_synchronize_end() {
+  if (StringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
+}
+
+void SerialHeap::print_gc_threads_on(outputStream* st) const {
+  if (StringDedup::is_enabled()) {
+    StringDedup::print_worker_threads_on(st);
+  }
+}
+
+void SerialHeap::gc_threads_do(ThreadClosure* tc) const {
+  if (StringDedup::is_enabled()) {
+    StringDedup::threads_do(tc);
+  }
+}
+
+void SerialHeap::deduplicate_string(oop str) {
+  assert(java_lang_String::is_instance(str), "invariant");
+  if (StringDedup::is_enabled()) {
+    StringDedup::deduplicate(str);
+  }
+}
+
+void SerialHeap::verify(VerifyOption option) {
+  GenCollectedHeap::verify(option);
+
+  if (StringDedup::is_enabled()) {
+    log_debug(gc, verify)("StrDedup");
+    StringDedup::verify();
+  }
+}
@@ -48,6 +48,8 @@ public:
 
   SerialHeap(GenCollectorPolicy* policy);
 
+  virtual jint initialize();
+
   virtual Name kind() const {
     return CollectedHeap::Serial;
   }
@@ -59,6 +61,16 @@ public:
   virtual GrowableArray<GCMemoryManager*> memory_managers();
   virtual GrowableArray<MemoryPool*> memory_pools();
 
+  virtual void stop();
+  virtual void safepoint_synchronize_begin();
+  virtual void safepoint_synchronize_end();
+
+  virtual void print_gc_threads_on(outputStream* st) const;
+  virtual void gc_threads_do(ThreadClosure* tc) const;
+
+  virtual void deduplicate_string(oop str);
+  virtual void verify(VerifyOption option);
+
   // override
   virtual bool is_in_closed_subset(const void* p) const {
     return is_in(p);
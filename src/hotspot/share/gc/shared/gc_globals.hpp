@@ -307,6 +307,11 @@
           "Per-thread chunk size for parallel memory pre-touch.")           \
           range(1, SIZE_MAX / 2)                                            \
                                                                             \
+  product(bool, AlwaysPreTouchInBackground, false,                          \
+          "With AlwaysPreTouch, pre-touch the initial heap from "           \
+          "background threads while the application starts instead "        \
+          "of before. Only supported by G1 and Parallel GC.")               \
+                                                                            \
   /* where does the range max value of (max_jint - 1) come from? */         \
   product(size_t, MarkStackSizeMax, NOT_LP64(4*M) LP64_ONLY(512*M),         \
           "Maximum size of marking stack")                                  \
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/heapPretoucher.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
+#include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/align.hpp"
+
+// Worker thread of a HeapPretoucher. Exits and deletes itself once there is
+// no more memory to touch.
+class HeapPretouchThread : public NamedThread {
+  HeapPretoucher* _pretoucher;
+
+public:
+  HeapPretouchThread(HeapPretoucher* pretoucher, uint id) : NamedThread(), _pretoucher(pretoucher) {
+    set_name("Heap Pretouch#%u", id);
+  }
+
+  virtual void run() {
+    initialize_named_thread();
+    _pretoucher->work();
+    _pretoucher->worker_done();
+    delete this;
+  }
+};
+
+// Amount of memory workers touch between checks for safepoints.
+static const size_t TouchStepSize = 4 * M;
+
+HeapPretoucher::HeapPretoucher(size_t chunk_size, size_t page_size) :
+  _num_ranges(0),
+  _chunk_size(align_up(chunk_size, page_size)),
+  _page_size(page_size),
+  _claimed(NULL),
+  _num_claimed(0),
+  _next_chunk(0),
+  _aborted(false),
+  _lock(new Monitor(Mutex::leaf, "HeapPretoucher_lock", true, Monitor::_safepoint_check_sometimes)),
+  _num_active_workers(0),
+  _start_time(0.0) {
+  _range_first_chunk[0] = 0;
+}
+
+void HeapPretoucher::add_range(void* start, void* end) {
+  assert(_claimed == NULL, "ranges must be added before starting");
+  guarantee(_num_ranges < MaxRanges, "too many ranges");
+  if (start >= end) {
+    return;
+  }
+  _range_start[_num_ranges] = (char*)start;
+  _range_end[_num_ranges] = (char*)end;
+  size_t chunks = align_up(pointer_delta(end, start, sizeof(char)), _chunk_size) / _chunk_size;
+  _range_first_chunk[_num_ranges + 1] = _range_first_chunk[_num_ranges] + chunks;
+  _num_ranges++;
+}
+
+size_t HeapPretoucher::total_size() const {
+  size_t result = 0;
+  for (uint i = 0; i < _num_ranges; i++) {
+    result += pointer_delta(_range_end[i], _range_start[i], sizeof(char));
+  }
+  return result;
+}
+
+void HeapPretoucher::chunk_bounds(size_t chunk, char** start, char** end) const {
+  assert(chunk < num_chunks(), "chunk " SIZE_FORMAT " out of bounds", chunk);
+  uint i = 0;
+  while (chunk >= _range_first_chunk[i + 1]) {
+    i++;
+  }
+  *start = _range_start[i] + (chunk - _range_first_chunk[i]) * _chunk_size;
+  *end = *start + MIN2(_chunk_size, pointer_delta(_range_end[i], *start, sizeof(char)));
+}
+
+bool HeapPretoucher::claim_chunk(size_t chunk) {
+  if (_claimed[chunk] != 0 || Atomic::cmpxchg((jbyte)1, &_claimed[chunk], (jbyte)0) != 0) {
+    return false;
+  }
+  Atomic::inc(&_num_claimed);
+  return true;
+}
+
+bool HeapPretoucher::touch_memory(char* start, char* end, bool sts_joined) {
+  size_t const step = align_up(TouchStepSize, _page_size);
+  char* cur = start;
+  while (cur < end) {
+    if (sts_joined && SuspendibleThreadSet::should_yield()) {
+      SuspendibleThreadSet::yield();
+    }
+    // The memory may have been uncommitted during the safepoint.
+    if (_aborted) {
+      return false;
+    }
+    char* step_end = cur + MIN2(step, pointer_delta(end, cur, sizeof(char)));
+    os::pretouch_memory(cur, step_end, _page_size);
+    cur = step_end;
+  }
+  return true;
+}
+
+void HeapPretoucher::work() {
+  SuspendibleThreadSetJoiner sts_join;
+  while (!_aborted) {
+    size_t chunk = Atomic::add((size_t)1, &_next_chunk) - 1;
+    if (chunk >= num_chunks()) {
+      break;
+    }
+    if (!claim_chunk(chunk)) {
+      continue;
+    }
+    char* start;
+    char* end;
+    chunk_bounds(chunk, &start, &end);
+    if (!touch_memory(start, end, true /* sts_joined */)) {
+      break;
+    }
+  }
+}
+
+void HeapPretoucher::worker_done() {
+  MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+  assert(_num_active_workers > 0, "must be");
+  if (--_num_active_workers == 0) {
+    double time_ms = (os::elapsedTime() - _start_time) * MILLIUNITS;
+    log_info(gc, heap)("Pre-touching heap %s after %.3fms, " SIZE_FORMAT " of " SIZE_FORMAT " chunks claimed",
+                       _aborted ? "aborted" : "done", time_ms, _num_claimed, num_chunks());
+    _lock->notify_all();
+  }
+}
+
+void HeapPretoucher::start(uint num_workers) {
+  assert(_claimed == NULL, "can only start once");
+  size_t const chunks = num_chunks();
+  if (chunks == 0) {
+    return;
+  }
+  _claimed = NEW_C_HEAP_ARRAY(jbyte, chunks, mtGC);
+  memset((void*)_claimed, 0, chunks * sizeof(jbyte));
+  _start_time = os::elapsedTime();
+
+  num_workers = (uint)MIN2((size_t)MAX2(num_workers, 1u), chunks);
+  log_info(gc, heap)("Pre-touching " SIZE_FORMAT "%s of heap in " SIZE_FORMAT " chunks using %u threads",
+                     byte_size_in_proper_unit(total_size()), proper_unit_for_byte_size(total_size()),
+                     chunks, num_workers);
+
+  uint num_started = 0;
+  for (uint i = 0; i < num_workers; i++) {
+    HeapPretouchThread* thread = new HeapPretouchThread(this, i);
+    if (!os::create_thread(thread, os::cgc_thread)) {
+      delete thread;
+      break;
+    }
+    {
+      MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      _num_active_workers++;
+    }
+    os::start_thread(thread);
+    num_started++;
+  }
+
+  if (num_started == 0) {
+    log_warning(gc)("Could not create heap pre-touch threads, pre-touching in the calling thread");
+    for (uint i = 0; i < _num_ranges; i++) {
+      touch(_range_start[i], _range_end[i]);
+    }
+  }
+}
+
+void HeapPretoucher::wait_until_done() {
+  MutexLocker ml(_lock);
+  while (_num_active_workers > 0) {
+    _lock->wait();
+  }
+}
+
+void HeapPretoucher::touch(void* start, void* end) {
+  if (_claimed == NULL || _aborted || _num_claimed == num_chunks()) {
+    return;
+  }
+  for (uint i = 0; i < _num_ranges; i++) {
+    char* s = MAX2((char*)start, _range_start[i]);
+    char* e = MIN2((char*)end, _range_end[i]);
+    if (s >= e) {
+      continue;
+    }
+    size_t first = _range_first_chunk[i] + pointer_delta(s, _range_start[i], sizeof(char)) / _chunk_size;
+    size_t last = _range_first_chunk[i] + (pointer_delta(e, _range_start[i], sizeof(char)) - 1) / _chunk_size;
+    for (size_t chunk = first; chunk <= last; chunk++) {
+      if (claim_chunk(chunk)) {
+        char* chunk_start;
+        char* chunk_end;
+        chunk_bounds(chunk, &chunk_start, &chunk_end);
+        touch_memory(chunk_start, chunk_end, false /* sts_joined */);
+      }
+    }
+  }
+}
+
+void HeapPretoucher::abort() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  _aborted = true;
+}
+
+void HeapPretoucher::stop() {
+  _aborted = true;
+  wait_until_done();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_SHARED_HEAPPRETOUCHER_HPP
+#define SHARE_VM_GC_SHARED_HEAPPRETOUCHER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class Monitor;
+
+// Pre-touches the committed parts of the heap with a pool of worker threads
+// that exit once all memory has been touched.
+//
+// The memory is split into chunks that are claimed in address order by the
+// workers. Allocating threads may claim and touch the chunks they are about
+// to use themselves so that they do not have to wait for the workers to get
+// there. Pre-touching does not change memory contents, so the workers can
+// keep going while the application already uses the heap.
+//
+// The workers take part in the suspendible thread set. Before memory covered
+// by the pretoucher is uncommitted, abort() must be called at a safepoint.
+class HeapPretoucher : public CHeapObj<mtGC> {
+  friend class HeapPretouchThread;
+
+  static const uint MaxRanges = 2;
+
+  char*  _range_start[MaxRanges];
+  char*  _range_end[MaxRanges];
+  // Index of the first chunk of each range, plus the total number of chunks.
+  size_t _range_first_chunk[MaxRanges + 1];
+  uint   _num_ranges;
+
+  const size_t _chunk_size;
+  const size_t _page_size;
+
+  // One entry per chunk, set by the thread that claimed the chunk.
+  volatile jbyte* _claimed;
+  volatile size_t _num_claimed;
+  // Next chunk for the workers to look at.
+  volatile size_t _next_chunk;
+  volatile bool   _aborted;
+
+  // Protects _num_active_workers.
+  Monitor* _lock;
+  uint     _num_active_workers;
+  double   _start_time;
+
+  size_t num_chunks() const { return _range_first_chunk[_num_ranges]; }
+
+  void chunk_bounds(size_t chunk, char** start, char** end) const;
+  bool claim_chunk(size_t chunk);
+  // Touches the given memory, yielding to safepoints in between if
+  // sts_joined. Returns false if pre-touching has been aborted.
+  bool touch_memory(char* start, char* end, bool sts_joined);
+
+  void work();
+  void worker_done();
+
+public:
+  HeapPretoucher(size_t chunk_size, size_t page_size);
+
+  // Adds [start, end) to the memory to pre-touch. Must be called before start().
+  void add_range(void* start, void* end);
+
+  size_t total_size() const;
+
+  // Starts the given number of workers, limited by the number of chunks.
+  void start(uint num_workers);
+  // Waits until all workers have finished.
+  void wait_until_done();
+
+  // Pre-touches the chunks overlapping [start, end) that have not been
+  // claimed yet in the calling thread.
+  void touch(void* start, void* end);
+
+  // Stops pre-touching; memory not touched yet remains untouched.
+  void abort();
+  // Aborts and waits for the workers to finish.
+  void stop();
+};
+
+#endif // SHARE_VM_GC_SHARED_HEAPPRETOUCHER_HPP
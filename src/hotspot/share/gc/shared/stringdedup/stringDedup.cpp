@@ -23,14 +23,49 @@
  */
 #include "precompiled.hpp"
 
-#include "gc/shared/stringdedup/stringDedup.hpp"
-#include "gc/shared/stringdedup/stringDedupQueue.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "gc/shared/stringdedup/stringDedup.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupQueue.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupSTWQueue.hpp"
+#include "gc/shared/stringdedup/stringDedupStat.hpp"
 #include "gc/shared/stringdedup/stringDedupTable.hpp"
 #include "gc/shared/stringdedup/stringDedupThread.hpp"
 #include "memory/iterator.hpp"
+#include "oops/oop.inline.hpp"
 
 bool StringDedup::_enabled = false;
 
+void StringDedup::initialize() {
+  assert(UseParallelGC || UseSerialGC, "String deduplication available with Parallel and Serial GC");
+  initialize_impl<StringDedupSTWQueue, StringDedupStat>();
+}
+
+bool StringDedup::is_candidate_from_young_copy(bool to_young, oop obj) {
+  if (java_lang_String::is_instance_inlined(obj)) {
+    if (to_young && obj->age() == StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being copied from young to survivor and
+      // just reached the deduplication age threshold.
+      return true;
+    }
+    if (!to_young && obj->age() < StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being promoted to old but has not reached
+      // the deduplication age threshold, i.e. has not previously been a
+      // candidate during its life in the young generation.
+      return true;
+    }
+  }
+
+  // Not a candidate
+  return false;
+}
+
+void StringDedup::enqueue_from_young_copy(bool to_young, uint queue, oop java_string) {
+  assert(is_enabled(), "String deduplication not enabled");
+  if (is_candidate_from_young_copy(to_young, java_string)) {
+    StringDedupQueue::push(queue, java_string);
+  }
+}
+
 void StringDedup::gc_prologue(bool resize_and_rehash_table) {
   assert(is_enabled(), "String deduplication not enabled");
   StringDedupQueue::gc_prologue();
@@ -61,6 +96,23 @@ void StringDedup::parallel_unlink(StringDedupUnlinkOrOopsDoClosure* unlink, uint
   StringDedupTable::unlink_or_oops_do(unlink, worker_id);
 }
 
+void StringDedup::oops_do(OopClosure* keep_alive) {
+  assert(is_enabled(), "String deduplication not enabled");
+  unlink_or_oops_do(NULL, keep_alive, true /* allow_resize_and_rehash */);
+}
+
+void StringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
+                                    OopClosure* keep_alive,
+                                    bool allow_resize_and_rehash) {
+  assert(is_enabled(), "String deduplication not enabled");
+  gc_prologue(allow_resize_and_rehash);
+  {
+    StringDedupUnlinkOrOopsDoClosure cl(is_alive, keep_alive);
+    parallel_unlink(&cl, 0 /* worker_id */);
+  }
+  gc_epilogue();
+}
+
 void StringDedup::threads_do(ThreadClosure* tc) {
   assert(is_enabled(), "String deduplication not enabled");
   tc->do_thread(StringDedupThread::thread());
@@ -69,6 +69,8 @@
 #include "memory/allocation.hpp"
 #include "runtime/thread.hpp"
 
+class BoolObjectClosure;
+class OopClosure;
 class ThreadClosure;
 
 //
@@ -79,12 +81,28 @@ private:
   // Single state for checking if string deduplication is enabled.
   static bool _enabled;
 
+  // Candidate selection policy for objects copied out of the young
+  // generation, returns true if the given object is candidate for
+  // string deduplication.
+  static bool is_candidate_from_young_copy(bool to_young, oop obj);
+
 public:
   // Returns true if string deduplication is enabled.
   static bool is_enabled() {
     return _enabled;
   }
 
+  // Initialize string deduplication for the stop-the-world generational
+  // collectors (Parallel and Serial), which select candidates while
+  // copying objects out of the young generation.
+  static void initialize();
+
+  // Enqueues a String that was just copied out of the young generation,
+  // either to a survivor space (to_young) or to the old generation, if it
+  // passes the age based candidate selection policy. The queue should be
+  // unique to the calling GC thread.
+  static void enqueue_from_young_copy(bool to_young, uint queue, oop java_string);
+
   // Stop the deduplication thread.
   static void stop();
 
@@ -94,6 +112,12 @@ public:
 
   static void parallel_unlink(StringDedupUnlinkOrOopsDoClosure* unlink, uint worker_id);
 
+  // Single threaded unlink_or_oops_do() of the deduplication queue and
+  // table, for collectors that process weak roots in the VM thread.
+  static void oops_do(OopClosure* keep_alive);
+  static void unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_alive,
+                                bool allow_resize_and_rehash);
+
   static void threads_do(ThreadClosure* tc);
   static void print_worker_threads_on(outputStream* st);
   static void verify();
@@ -24,54 +24,55 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.inline.hpp"
-#include "gc/g1/g1CollectedHeap.hpp"
-#include "gc/g1/g1StringDedup.hpp"
-#include "gc/g1/g1StringDedupQueue.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "gc/shared/stringdedup/stringDedupSTWQueue.hpp"
 #include "logging/log.hpp"
+#include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "utilities/stack.inline.hpp"
 
-const size_t        G1StringDedupQueue::_max_size = 1000000; // Max number of elements per queue
-const size_t        G1StringDedupQueue::_max_cache_size = 0; // Max cache size per queue
+const size_t        StringDedupSTWQueue::_max_size = 1000000; // Max number of elements per queue
+const size_t        StringDedupSTWQueue::_max_cache_size = 0; // Max cache size per queue
 
-G1StringDedupQueue::G1StringDedupQueue() :
+StringDedupSTWQueue::StringDedupSTWQueue() :
   _cursor(0),
   _cancel(false),
   _empty(true),
   _dropped(0) {
-  _nqueues = ParallelGCThreads;
-  _queues = NEW_C_HEAP_ARRAY(G1StringDedupWorkerQueue, _nqueues, mtGC);
+  _nqueues = ParallelGCThreads + 1;
+  _queues = NEW_C_HEAP_ARRAY(StringDedupWorkerQueue, _nqueues, mtGC);
   for (size_t i = 0; i < _nqueues; i++) {
-    new (_queues + i) G1StringDedupWorkerQueue(G1StringDedupWorkerQueue::default_segment_size(), _max_cache_size, _max_size);
+    new (_queues + i) StringDedupWorkerQueue(StringDedupWorkerQueue::default_segment_size(), _max_cache_size, _max_size);
   }
 }
 
-G1StringDedupQueue::~G1StringDedupQueue() {
+StringDedupSTWQueue::~StringDedupSTWQueue() {
   ShouldNotReachHere();
 }
 
-void G1StringDedupQueue::wait_impl() {
+void StringDedupSTWQueue::wait_impl() {
   MonitorLockerEx ml(StringDedupQueue_lock, Mutex::_no_safepoint_check_flag);
   while (_empty && !_cancel) {
     ml.wait(Mutex::_no_safepoint_check_flag);
   }
 }
 
-void G1StringDedupQueue::cancel_wait_impl() {
+void StringDedupSTWQueue::cancel_wait_impl() {
   MonitorLockerEx ml(StringDedupQueue_lock, Mutex::_no_safepoint_check_flag);
   _cancel = true;
   ml.notify();
 }
 
-void G1StringDedupQueue::push_impl(uint worker_id, oop java_string) {
+void StringDedupSTWQueue::push_impl(uint worker_id, oop java_string) {
   assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint");
   assert(worker_id < _nqueues, "Invalid queue");
 
   // Push and notify waiter
-  G1StringDedupWorkerQueue& worker_queue = _queues[worker_id];
+  StringDedupWorkerQueue& worker_queue = _queues[worker_id];
   if (!worker_queue.is_full()) {
     worker_queue.push(java_string);
     if (_empty) {
@@ -88,14 +89,14 @@ void G1StringDedupQueue::push_impl(uint worker_id, oop java_string) {
   }
 }
 
-oop G1StringDedupQueue::pop_impl() {
+oop StringDedupSTWQueue::pop_impl() {
   assert(!SafepointSynchronize::is_at_safepoint(), "Must not be at safepoint");
   NoSafepointVerifier nsv;
 
   // Try all queues before giving up
   for (size_t tries = 0; tries < _nqueues; tries++) {
     // The cursor indicates where we left of last time
-    G1StringDedupWorkerQueue* queue = &_queues[_cursor];
+    StringDedupWorkerQueue* queue = &_queues[_cursor];
     while (!queue->is_empty()) {
       oop obj = queue->pop();
       // The oop we pop can be NULL if it was marked
@@ -115,7 +116,7 @@ oop G1StringDedupQueue::pop_impl() {
   return NULL;
 }
 
-void G1StringDedupQueue::unlink_or_oops_do_impl(StringDedupUnlinkOrOopsDoClosure* cl, size_t queue) {
+void StringDedupSTWQueue::unlink_or_oops_do_impl(StringDedupUnlinkOrOopsDoClosure* cl, size_t queue) {
   assert(queue < _nqueues, "Invalid queue");
   StackIterator<oop, mtGC> iter(_queues[queue]);
   while (!iter.is_empty()) {
@@ -131,18 +132,18 @@ void G1StringDedupQueue::unlink_or_oops_do_impl(StringDedupUnlinkOrOopsDoClosure
   }
 }
 
-void G1StringDedupQueue::print_statistics_impl() {
+void StringDedupSTWQueue::print_statistics_impl() {
   log_debug(gc, stringdedup)("  Queue");
   log_debug(gc, stringdedup)("    Dropped: " UINTX_FORMAT, _dropped);
 }
 
-void G1StringDedupQueue::verify_impl() {
+void StringDedupSTWQueue::verify_impl() {
   for (size_t i = 0; i < _nqueues; i++) {
     StackIterator<oop, mtGC> iter(_queues[i]);
     while (!iter.is_empty()) {
       oop obj = iter.next();
       if (obj != NULL) {
-        guarantee(G1CollectedHeap::heap()->is_in_reserved(obj), "Object must be on the heap");
+        guarantee(Universe::heap()->is_in_reserved(obj), "Object must be on the heap");
         guarantee(!obj->is_forwarded(), "Object must not be forwarded");
         guarantee(java_lang_String::is_instance(obj), "Object must be a String");
       }
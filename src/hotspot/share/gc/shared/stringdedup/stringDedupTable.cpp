@@ -122,8 +122,10 @@ public:
   void delete_overflowed();
 };
 
+// The Serial collector may run without any parallel GC threads, but the
+// VM thread still needs a list when it unlinks entries.
 StringDedupEntryCache::StringDedupEntryCache(size_t max_size) :
-  _nlists(ParallelGCThreads),
+  _nlists(MAX2(ParallelGCThreads, 1U)),
   _max_list_length(0),
   _cached(PaddedArray<StringDedupEntryList, mtGC>::create_unfreeable((uint)_nlists)),
   _overflowed(PaddedArray<StringDedupEntryList, mtGC>::create_unfreeable((uint)_nlists)) {
@@ -27,14 +27,17 @@
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/metaspaceShared.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/signature.hpp"
+#include "utilities/resourceHash.hpp"
 
 class OopMapCacheEntry: private InterpreterOopMap {
   friend class InterpreterOopMap;
   friend class OopMapForCacheEntry;
+  friend class ArchivedOopMapGenerator;
   friend class OopMapCache;
   friend class VerifyClosure;
 
@@ -46,6 +49,8 @@ class OopMapCacheEntry: private InterpreterOopMap {
   void fill(const methodHandle& method, int bci);
   // fills the bit mask for native calls
   void fill_for_native(const methodHandle& method);
+  // fills the bit mask from the CDS archive, if it has a map for (method, bci)
+  bool fill_from_archive(const methodHandle& method, int bci) NOT_CDS_RETURN_(false);
   void set_mask(CellTypeState* vars, CellTypeState* stack, int stack_top);
 
   // Deallocate bit masks and initialize fields
@@ -329,6 +334,8 @@ void OopMapCacheEntry::fill(const methodHandle& method, int bci) {
     // Native method activations have oops only among the parameters and one
     // extra oop following the parameters (the mirror for static native methods).
     fill_for_native(method);
+  } else if (fill_from_archive(method, bci)) {
+    log_debug(interpreter, oopmap)("- found in archive");
   } else {
     EXCEPTION_MARK;
     OopMapForCacheEntry gen(method, bci, this);
@@ -600,3 +607,259 @@ void OopMapCache::compute_one_oop_map(const methodHandle& method, int bci, Inter
   entry->resource_copy(tmp);
   FREE_C_HEAP_ARRAY(OopMapCacheEntry, tmp);
 }
+
+#if INCLUDE_CDS
+
+// Oop maps precomputed when dumping the CDS archive, for the bytecodes of
+// archived methods where an interpreted frame is most likely to be inspected:
+// call sites, where every caller frame of a GC or stack walk stops, and the
+// allocation and locking bytecodes that commonly block the top frame. The
+// methods are sorted by address and the entries of each method by bci, so a
+// lookup costs two binary searches instead of an abstract interpretation.
+
+struct ArchivedOopMapMethod {
+  Method* _method;
+  u4      _first_entry;  // index of the first entry in _archived_entries
+  u4      _entry_count;
+};
+
+struct ArchivedOopMapEntry {
+  u2      _bci;
+  u2      _expression_stack_size;
+  u4      _mask_index;   // index of the first mask word in _archived_masks
+};
+
+static Array<ArchivedOopMapMethod>* _archived_methods = NULL;
+static Array<ArchivedOopMapEntry>*  _archived_entries = NULL;
+static Array<uintptr_t>*            _archived_masks   = NULL;
+
+// Maps single word masks to their index in the mask array. Outlives the
+// ResourceMark of each generator pass, so it is allocated on the C heap.
+typedef ResourceHashtable<uintptr_t, u4,
+                          primitive_hash<uintptr_t>, primitive_equals<uintptr_t>,
+                          1024, ResourceObj::C_HEAP, mtClass> SingleWordMaskTable;
+
+static bool is_archived_gc_point(Bytecodes::Code code) {
+  switch (code) {
+    case Bytecodes::_invokevirtual:
+    case Bytecodes::_invokespecial:
+    case Bytecodes::_invokestatic:
+    case Bytecodes::_invokeinterface:
+    case Bytecodes::_invokedynamic:
+    case Bytecodes::_new:
+    case Bytecodes::_newarray:
+    case Bytecodes::_anewarray:
+    case Bytecodes::_multianewarray:
+    case Bytecodes::_monitorenter:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Computes the oop maps of all archived GC points of a method in a single
+// abstract interpretation pass.
+class ArchivedOopMapGenerator: public GenerateOopMap {
+  OopMapCacheEntry*                    _tmp;
+  GrowableArray<ArchivedOopMapEntry>*  _entries;
+  GrowableArray<uintptr_t>*            _masks;
+  SingleWordMaskTable*                 _single_word_masks;
+
+  virtual bool report_results() const     { return true; }
+  virtual bool report_init_vars() const   { return false; }
+  virtual bool allow_rewrites() const     { return false; }
+  // Methods that fail verification are left to the runtime generator.
+  virtual bool error_is_fatal() const     { return false; }
+  virtual bool possible_gc_point          (BytecodeStream *bcs) { return is_archived_gc_point(bcs->code()); }
+  virtual void fill_stackmap_prolog       (int nof_gc_points)   {}
+  virtual void fill_stackmap_epilog       ()                    {}
+  virtual void fill_init_vars             (GrowableArray<intptr_t> *init_vars) {}
+  virtual void fill_stackmap_for_opcodes  (BytecodeStream *bcs,
+                                           CellTypeState* vars,
+                                           CellTypeState* stack,
+                                           int stack_top);
+
+ public:
+  ArchivedOopMapGenerator(const methodHandle& method, OopMapCacheEntry* tmp,
+                          GrowableArray<ArchivedOopMapEntry>* entries,
+                          GrowableArray<uintptr_t>* masks,
+                          SingleWordMaskTable* single_word_masks) :
+    GenerateOopMap(method), _tmp(tmp), _entries(entries), _masks(masks),
+    _single_word_masks(single_word_masks) {}
+
+  bool failed() { return got_error(); }
+};
+
+void ArchivedOopMapGenerator::fill_stackmap_for_opcodes(BytecodeStream *bcs,
+                                                        CellTypeState* vars,
+                                                        CellTypeState* stack,
+                                                        int stack_top) {
+  if (!possible_gc_point(bcs)) {
+    return;
+  }
+  _tmp->flush();
+  _tmp->set_method(method());
+  _tmp->set_bci(bcs->bci());
+  _tmp->set_mask(vars, stack, stack_top);
+
+  ArchivedOopMapEntry e;
+  e._bci = (u2)bcs->bci();
+  e._expression_stack_size = (u2)stack_top;
+  int words = (int)_tmp->mask_word_size();
+  u4* shared = (words == 1) ? _single_word_masks->get(_tmp->bit_mask()[0]) : NULL;
+  if (shared != NULL) {
+    // Most single word masks are repeated many times across methods.
+    e._mask_index = *shared;
+  } else {
+    e._mask_index = (u4)_masks->length();
+    for (int i = 0; i < words; i++) {
+      _masks->append(_tmp->bit_mask()[i]);
+    }
+    if (words == 1) {
+      _single_word_masks->put(_tmp->bit_mask()[0], e._mask_index);
+    }
+  }
+  _entries->append(e);
+}
+
+static int compare_method_address(Method** a, Method** b) {
+  if (*a == *b) return 0;
+  return (address)*a < (address)*b ? -1 : 1;
+}
+
+void OopMapCache::archive_oop_maps() {
+  assert(DumpSharedSpaces, "dump time only");
+  if (!ArchiveInterpreterOopMaps) {
+    return;
+  }
+
+  Thread* THREAD = Thread::current();
+  ResourceMark rm(THREAD);
+  GrowableArray<Method*> methods;
+  GrowableArray<Klass*>* klasses = MetaspaceShared::collected_klasses();
+  for (int i = 0; i < klasses->length(); i++) {
+    Klass* k = klasses->at(i);
+    // Methods of classes that are linked at run time may still be rewritten.
+    if (k->is_instance_klass() && InstanceKlass::cast(k)->is_linked()) {
+      Array<Method*>* ik_methods = InstanceKlass::cast(k)->methods();
+      for (int j = 0; j < ik_methods->length(); j++) {
+        Method* m = ik_methods->at(j);
+        // Methods with jsr subroutines are left to the runtime generator,
+        // which may have to rewrite them.
+        if (!m->is_native() && !m->is_abstract() && m->code_size() > 0 && !m->has_jsrs()) {
+          methods.append(m);
+        }
+      }
+    }
+  }
+  methods.sort(compare_method_address);
+
+  // The per-method generator passes run under their own ResourceMark, so
+  // the results are collected on the C heap.
+  GrowableArray<ArchivedOopMapMethod>* records =
+    new (ResourceObj::C_HEAP, mtClass) GrowableArray<ArchivedOopMapMethod>(methods.length(), true, mtClass);
+  GrowableArray<ArchivedOopMapEntry>* entries =
+    new (ResourceObj::C_HEAP, mtClass) GrowableArray<ArchivedOopMapEntry>(methods.length() * 4, true, mtClass);
+  GrowableArray<uintptr_t>* masks =
+    new (ResourceObj::C_HEAP, mtClass) GrowableArray<uintptr_t>(1024, true, mtClass);
+  SingleWordMaskTable single_word_masks;
+  OopMapCacheEntry* tmp = NEW_C_HEAP_ARRAY(OopMapCacheEntry, 1, mtClass);
+  tmp->initialize();
+
+  for (int i = 0; i < methods.length(); i++) {
+    ResourceMark rm2(THREAD);
+    methodHandle mh(THREAD, methods.at(i));
+    int first = entries->length();
+    ArchivedOopMapGenerator gen(mh, tmp, entries, masks, &single_word_masks);
+    gen.compute_map(CATCH);
+    if (gen.failed()) {
+      // Drop the entries of the failed pass.  Its mask words stay behind,
+      // since other methods may already share them.
+      log_info(cds)("Skipped interpreter oop maps of %s", mh->name_and_sig_as_C_string());
+      entries->trunc_to(first);
+      continue;
+    }
+    if (entries->length() > first) {
+      ArchivedOopMapMethod r;
+      r._method = mh();
+      r._first_entry = (u4)first;
+      r._entry_count = (u4)(entries->length() - first);
+      records->append(r);
+    }
+  }
+  tmp->flush();
+  FREE_C_HEAP_ARRAY(OopMapCacheEntry, tmp);
+
+  _archived_methods = MetaspaceShared::new_ro_array<ArchivedOopMapMethod>(records->length());
+  for (int i = 0; i < records->length(); i++) {
+    _archived_methods->at_put(i, records->at(i));
+  }
+  _archived_entries = MetaspaceShared::new_ro_array<ArchivedOopMapEntry>(entries->length());
+  for (int i = 0; i < entries->length(); i++) {
+    _archived_entries->at_put(i, entries->at(i));
+  }
+  _archived_masks = MetaspaceShared::new_ro_array<uintptr_t>(masks->length());
+  for (int i = 0; i < masks->length(); i++) {
+    _archived_masks->at_put(i, masks->at(i));
+  }
+  tty->print_cr("Number of archived interpreter oop maps %d (%d methods, %d mask words)",
+                entries->length(), records->length(), masks->length());
+
+  delete records;
+  delete entries;
+  delete masks;
+}
+
+void OopMapCache::serialize_archived_oop_maps(SerializeClosure* soc) {
+  soc->do_ptr((void**)&_archived_methods);
+  soc->do_ptr((void**)&_archived_entries);
+  soc->do_ptr((void**)&_archived_masks);
+}
+
+static const ArchivedOopMapEntry* find_archived_oop_map(Method* method, int bci) {
+  int lo = 0;
+  int hi = _archived_methods->length() - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) >> 1;
+    const ArchivedOopMapMethod* r = _archived_methods->adr_at(mid);
+    if (r->_method == method) {
+      int elo = r->_first_entry;
+      int ehi = r->_first_entry + r->_entry_count - 1;
+      while (elo <= ehi) {
+        int emid = (elo + ehi) >> 1;
+        const ArchivedOopMapEntry* e = _archived_entries->adr_at(emid);
+        if (e->_bci == bci) {
+          return e;
+        } else if (e->_bci < bci) {
+          elo = emid + 1;
+        } else {
+          ehi = emid - 1;
+        }
+      }
+      return NULL;
+    } else if ((address)r->_method < (address)method) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return NULL;
+}
+
+bool OopMapCacheEntry::fill_from_archive(const methodHandle& method, int bci) {
+  if (_archived_methods == NULL || !method->is_shared()) {
+    return false;
+  }
+  const ArchivedOopMapEntry* e = find_archived_oop_map(method(), bci);
+  if (e == NULL) {
+    return false;
+  }
+  set_mask_size((method->max_locals() + e->_expression_stack_size) * bits_per_entry);
+  set_expression_stack_size(e->_expression_stack_size);
+  allocate_bit_mask();
+  memcpy((void*)bit_mask(), (void*)_archived_masks->adr_at(e->_mask_index),
+         mask_word_size() * BytesPerWord);
+  return true;
+}
+
+#endif // INCLUDE_CDS
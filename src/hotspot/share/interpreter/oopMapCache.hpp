@@ -28,6 +28,8 @@
 #include "oops/generateOopMap.hpp"
 #include "runtime/mutex.hpp"
 
+class SerializeClosure;
+
 // A Cache for storing (method, bci) -> oopMap.
 // The memory management system uses the cache when locating object
 // references in an interpreted frame.
@@ -174,6 +176,12 @@ class OopMapCache : public CHeapObj<mtClass> {
   // Compute an oop map without updating the cache or grabbing any locks (for debugging)
   static void compute_one_oop_map(const methodHandle& method, int bci, InterpreterOopMap* entry);
   static void cleanup_old_entries();
+
+  // Oop maps precomputed for archived methods when dumping the CDS archive.
+  // Both lookup() and compute_one_oop_map() use them before falling back to
+  // computing the map.
+  static void archive_oop_maps() NOT_CDS_RETURN;
+  static void serialize_archived_oop_maps(SerializeClosure* soc) NOT_CDS_RETURN;
 };
 
 #endif // SHARE_VM_INTERPRETER_OOPMAPCACHE_HPP
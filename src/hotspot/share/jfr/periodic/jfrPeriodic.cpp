@@ -49,6 +49,7 @@
 #include "runtime/arguments.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/nativeCallStatistics.hpp"
 #include "runtime/os.hpp"
 #include "runtime/os_perf.hpp"
 #include "runtime/thread.inline.hpp"
@@ -426,6 +427,12 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   }
 }
 
+TRACE_REQUEST_FUNC(NativeMethodStatistics) {
+  if (JNICallStatistics) {
+    NativeCallStatistics::post_events();
+  }
+}
+
 /**
  *  PhysicalMemory event represents:
  *
@@ -119,6 +119,7 @@ enum MemoryType {
   mtThreadStack,
   mtCode,              // memory for generated code
   mtGC,                // memory for GC
+  mtGCCardSet,         // memory for GC card set (remembered sets)
   mtCompiler,          // memory for compiler
   mtInternal,          // memory used by VM, but does not belong to
                        // any of above categories, and not used for
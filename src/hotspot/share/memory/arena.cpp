@@ -31,6 +31,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -179,6 +180,17 @@ class ChunkPoolCleaner : public PeriodicTask {
 //--------------------------------------------------------------------------------------
 // Chunk implementation
 
+// Compiler threads keep default sized chunks in a per-thread cache that is not
+// pruned by the ChunkPoolCleaner, so that repeated compilations do not go
+// through os::malloc and os::free for every chunk.
+static CompilerThread* current_compiler_thread() {
+  Thread* thread = Thread::current_or_null();
+  if (thread != NULL && thread->is_Compiler_thread()) {
+    return (CompilerThread*)thread;
+  }
+  return NULL;
+}
+
 void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode, size_t length) throw() {
   // requested_size is equal to sizeof(Chunk) but in order for the arena
   // allocations to come out aligned as expected the size must be aligned
@@ -187,7 +199,11 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
   switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
+   case Chunk::size: {
+     CompilerThread* thread = current_compiler_thread();
+     void* p = (thread != NULL) ? thread->allocate_cached_chunk() : NULL;
+     return (p != NULL) ? p : ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
+   }
    case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
    case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
    case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
@@ -204,7 +220,13 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
   switch (c->length()) {
-   case Chunk::size:        ChunkPool::large_pool()->free(c); break;
+   case Chunk::size: {
+     CompilerThread* thread = current_compiler_thread();
+     if (thread == NULL || !thread->cache_chunk(c)) {
+       ChunkPool::large_pool()->free(c);
+     }
+     break;
+   }
    case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
    case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
    case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
@@ -331,6 +353,11 @@ void Arena::set_size_in_bytes(size_t size) {
     ssize_t delta = size - size_in_bytes();
     _size_in_bytes = size;
     MemTracker::record_arena_size_change(delta, _flags);
+    // Account the arena memory of compilations
+    CompilerThread* thread = current_compiler_thread();
+    if (thread != NULL) {
+      thread->arena_size_changed(delta);
+    }
   }
 }
 
@@ -844,10 +844,19 @@ bool FileMapInfo::remap_shared_readonly_as_readwrite() {
   }
   size_t used = si->_used;
   size_t size = align_up(used, os::vm_allocation_granularity());
+  char *addr = region_addr(idx);
+  if (os::uses_transparent_huge_pages(mtClassShared)) {
+    // The region has been read into anonymous memory, see read_region().
+    if (!os::protect_memory(addr, size, os::MEM_PROT_RW)) {
+      fail_continue("Unable to make shared readonly space writable.");
+      return false;
+    }
+    si->_read_only = false;
+    return true;
+  }
   if (!open_for_read()) {
     return false;
   }
-  char *addr = region_addr(idx);
   char *base = os::remap_memory(_fd, _full_path, si->_file_offset,
                                 addr, size, false /* !read_only */,
                                 si->_allow_exec);
@@ -879,6 +888,7 @@ ReservedSpace FileMapInfo::reserve_shared_memory() {
   }
   // the reserved virtual memory is for mapping class data sharing archive
   MemTracker::record_virtual_memory_type((address)rs.base(), mtClassShared);
+  os::register_large_page_region(rs.base(), rs.size(), mtClassShared);
 
   return rs;
 }
@@ -900,10 +910,15 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
     si->_read_only = false;
   }
 
-  // map the contents of the CDS archive in this memory
-  char *base = os::map_memory(_fd, _full_path, si->_file_offset,
-                              requested_addr, size, si->_read_only,
-                              si->_allow_exec);
+  char *base;
+  if (os::uses_transparent_huge_pages(mtClassShared)) {
+    base = read_region(i, requested_addr, size);
+  } else {
+    // map the contents of the CDS archive in this memory
+    base = os::map_memory(_fd, _full_path, si->_file_offset,
+                          requested_addr, size, si->_read_only,
+                          si->_allow_exec);
+  }
   if (base == NULL || base != requested_addr) {
     fail_continue("Unable to map %s shared space at required address.", shared_region_name[i]);
     return NULL;
@@ -923,6 +938,26 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
   return base;
 }
 
+// Read a region into anonymous memory within the reserved shared space.
+// Unlike a private file mapping, this memory can be backed by transparent
+// huge pages; the regions are aligned for that when dumping.
+char* FileMapInfo::read_region(int i, char* addr, size_t size) {
+  CDSFileMapRegion* si = space_at(i);
+  if (!os::commit_memory(addr, size, os::large_page_size(), si->_allow_exec)) {
+    return NULL;
+  }
+  if (os::seek_to_file_offset(_fd, si->_file_offset) < 0 ||
+      os::read(_fd, addr, (unsigned int)si->_used) != si->_used) {
+    os::uncommit_memory(addr, size);
+    return NULL;
+  }
+  if (si->_read_only) {
+    os::protect_memory(addr, size, os::MEM_PROT_READ);
+  }
+  log_info(cds)("Read %s region into memory at " INTPTR_FORMAT, shared_region_name[i], p2i(addr));
+  return addr;
+}
+
 address FileMapInfo::decode_start_address(CDSFileMapRegion* spc, bool with_current_oop_encoding_mode) {
   if (with_current_oop_encoding_mode) {
     return (address)CompressedOops::decode_not_null(offset_of_space(spc));
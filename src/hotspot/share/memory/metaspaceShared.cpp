@@ -37,6 +37,7 @@
 #include "code/codeCache.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/bytecodes.hpp"
+#include "interpreter/oopMapCache.hpp"
 #include "logging/log.hpp"
 #include "logging/logMessage.hpp"
 #include "memory/filemap.hpp"
@@ -76,6 +77,7 @@ MetaspaceSharedStats MetaspaceShared::_stats;
 bool MetaspaceShared::_has_error_classes;
 bool MetaspaceShared::_archive_loading_failed = false;
 bool MetaspaceShared::_remapped_readwrite = false;
+Array<Method*>* MetaspaceShared::_adapter_methods = NULL;
 address MetaspaceShared::_cds_i2i_entry_code_buffers = NULL;
 size_t MetaspaceShared::_cds_i2i_entry_code_buffers_size = 0;
 size_t MetaspaceShared::_core_spaces_size = 0;
@@ -186,6 +188,12 @@ public:
 
   void pack(DumpRegion* next = NULL) {
     assert(!is_packed(), "sanity");
+    char* aligned_top = (char*)align_up(_top, MetaspaceShared::core_region_alignment());
+    if (aligned_top > _top) {
+      // Pad the region so that the next one starts at a huge page boundary
+      // and there is still no gap between them.
+      allocate(pointer_delta(aligned_top, _top, sizeof(char)), 1);
+    }
     _end = (char*)align_up(_top, Metaspace::reserve_alignment());
     _is_packed = true;
     if (next != NULL) {
@@ -423,6 +431,15 @@ void MetaspaceShared::commit_shared_space_to(char* newtop) {
                 commit, _shared_vs.actual_committed_size(), _shared_vs.high());
 }
 
+size_t MetaspaceShared::core_region_alignment() {
+  if (os::uses_transparent_huge_pages(mtClassShared)) {
+    // Lets the regions be backed by huge pages when the archive is read
+    // into memory at runtime, see FileMapInfo::map_region().
+    return MAX2(os::large_page_size(), Metaspace::reserve_alignment());
+  }
+  return Metaspace::reserve_alignment();
+}
+
 // Read/write a data stream for restoring/preserving metadata pointers and
 // miscellaneous data from/to the shared archive file.
 
@@ -457,6 +474,14 @@ void MetaspaceShared::serialize(SerializeClosure* soc) {
   InstanceMirrorKlass::serialize_offsets(soc);
   soc->do_tag(--tag);
 
+  // Dump/restore the representative methods of the archived adapters.
+  soc->do_ptr((void**)&_adapter_methods);
+  soc->do_tag(--tag);
+
+  // Dump/restore the precomputed interpreter oop maps.
+  OopMapCache::serialize_archived_oop_maps(soc);
+  soc->do_tag(--tag);
+
   soc->do_tag(666);
 }
 
@@ -674,6 +699,35 @@ void MetaspaceShared::resolve_constants_and_update_constMethods(Thread* THREAD)
   }
 }
 
+// Record one archived method per distinct adapter trampoline. At run time
+// AdapterHandlerLibrary::link_shared_adapters() generates the adapters for
+// these methods, which fills in the trampolines shared by all other archived
+// methods with the same signature fingerprint.
+void MetaspaceShared::collect_adapter_methods() {
+  assert(DumpSharedSpaces, "dump time only");
+  ResourceMark rm;
+  ResourceHashtable<AdapterHandlerEntry**, bool> seen;
+  GrowableArray<Method*> methods;
+  for (int i = 0; i < _global_klass_objects->length(); i++) {
+    Klass* k = _global_klass_objects->at(i);
+    if (k->is_instance_klass()) {
+      Array<Method*>* ik_methods = InstanceKlass::cast(k)->methods();
+      for (int j = 0; j < ik_methods->length(); j++) {
+        Method* m = ik_methods->at(j);
+        if (seen.put(m->constMethod()->adapter_trampoline(), true)) {
+          methods.append(m);
+        }
+      }
+    }
+  }
+
+  _adapter_methods = new_ro_array<Method*>(methods.length());
+  for (int i = 0; i < methods.length(); i++) {
+    _adapter_methods->at_put(i, methods.at(i));
+  }
+  tty->print_cr("Number of shared adapters %d", methods.length());
+}
+
 NOT_PRODUCT(
 static void assert_not_anonymous_class(InstanceKlass* k) {
   assert(!(k->is_anonymous()), "cannot archive anonymous classes");
@@ -1429,6 +1483,9 @@ char* VM_PopulateDumpSharedSpace::dump_read_only_tables() {
   char* table_top = _ro_region.allocate(table_bytes, sizeof(intptr_t));
   SystemDictionary::copy_table(table_top, _ro_region.top());
 
+  MetaspaceShared::collect_adapter_methods();
+  OopMapCache::archive_oop_maps();
+
   // Write the other data to the output array.
   WriteClosure wc(&_ro_region);
   MetaspaceShared::serialize(&wc);
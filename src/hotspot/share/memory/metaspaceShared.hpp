@@ -58,6 +58,7 @@ class MetaspaceShared : AllStatic {
   static bool _has_error_classes;
   static bool _archive_loading_failed;
   static bool _remapped_readwrite;
+  static Array<Method*>* _adapter_methods;
   static address _cds_i2i_entry_code_buffers;
   static size_t  _cds_i2i_entry_code_buffers_size;
   static size_t  _core_spaces_size;
@@ -105,6 +106,8 @@ class MetaspaceShared : AllStatic {
     NOT_CDS(return NULL);
   }
   static void commit_shared_space_to(char* newtop) NOT_CDS_RETURN;
+  // Alignment of the start of the mc, rw, ro and md regions when dumping.
+  static size_t core_region_alignment() NOT_CDS_RETURN_(0);
   static size_t core_spaces_size() {
     assert(DumpSharedSpaces || UseSharedSpaces, "sanity");
     assert(_core_spaces_size != 0, "sanity");
@@ -187,6 +190,12 @@ class MetaspaceShared : AllStatic {
 #endif
   }
 
+  // One archived method for each distinct adapter trampoline in the archive.
+  static void collect_adapter_methods();
+  static Array<Method*>* adapter_methods() {
+    return _adapter_methods;
+  }
+
   static address cds_i2i_entry_code_buffers(size_t total_size);
 
   static address cds_i2i_entry_code_buffers() {
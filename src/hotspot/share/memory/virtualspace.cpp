@@ -634,6 +634,7 @@ ReservedHeapSpace::ReservedHeapSpace(size_t size, size_t alignment, bool large,
 
   if (base() != NULL) {
     MemTracker::record_virtual_memory_type((address)base(), mtJavaHeap);
+    os::register_large_page_region(base(), _size, mtJavaHeap);
   }
 
   if (_fd_for_heap != -1) {
@@ -648,6 +649,9 @@ ReservedCodeSpace::ReservedCodeSpace(size_t r_size,
                                      bool large) :
   ReservedSpace(r_size, rs_align, large, /*executable*/ true) {
   MemTracker::record_virtual_memory_type((address)base(), mtCode);
+  if (base() != NULL) {
+    os::register_large_page_region(base(), size(), mtCode);
+  }
 }
 
 // VirtualSpace
@@ -298,6 +298,10 @@ public:
     assert(*trampoline == NULL, "must be NULL during dump time, to be initialized at run time");
     _adapter_trampoline = trampoline;
   }
+  AdapterHandlerEntry** adapter_trampoline() const {
+    assert(is_shared() || DumpSharedSpaces, "must be");
+    return _adapter_trampoline;
+  }
   void update_adapter_trampoline(AdapterHandlerEntry* adapter) {
     assert(is_shared(), "must be");
     *_adapter_trampoline = adapter;
@@ -2135,7 +2135,7 @@ void GenerateOopMap::compute_map(TRAPS) {
   if (!_got_error && report_results())
      report_result();
 
-  if (_got_error) {
+  if (_got_error && _exception.not_null()) {
     THROW_HANDLE(_exception);
   }
 }
@@ -2158,10 +2158,12 @@ void GenerateOopMap::error_work(const char *format, va_list ap) {
   if (Thread::current()->can_call_java()) {
     _exception = Exceptions::new_exception(Thread::current(),
                   vmSymbols::java_lang_LinkageError(), msg_buffer2);
-  } else {
+  } else if (error_is_fatal()) {
     // We cannot instantiate an exception object from a compiler thread.
     // Exit the VM with a useful error message.
     fatal("%s", msg_buffer2);
+  } else {
+    log_debug(interpreter, oopmap)("%s", msg_buffer2);
   }
 }
 
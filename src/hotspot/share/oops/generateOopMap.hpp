@@ -494,6 +494,9 @@ class GenerateOopMap {
   virtual bool allow_rewrites             () const                        { return false; }
   virtual bool report_results             () const                        { return true;  }
   virtual bool report_init_vars           () const                        { return true;  }
+  // Whether an error is fatal in a thread that cannot create the exception.
+  // Otherwise compute_map returns with got_error() set.
+  virtual bool error_is_fatal             () const                        { return true;  }
   virtual bool possible_gc_point          (BytecodeStream *bcs)           { ShouldNotReachHere(); return false; }
   virtual void fill_stackmap_prolog       (int nof_gc_points)             { ShouldNotReachHere(); }
   virtual void fill_stackmap_epilog       ()                              { ShouldNotReachHere(); }
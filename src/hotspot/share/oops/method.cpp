@@ -1016,9 +1016,13 @@ void Method::unlink_method() {
 // AdapterHandlerEntry.
 //
 // _adapter_trampoline points to a fixed location in the RW section of
-// the CDS archive. This location initially contains a NULL pointer. When the
-// first of method A or B is linked, an AdapterHandlerEntry is allocated
-// dynamically, and its c2i/i2c entries are generated.
+// the CDS archive. This location initially contains a NULL pointer. During
+// VM startup, AdapterHandlerLibrary::link_shared_adapters() allocates an
+// AdapterHandlerEntry for one archived method per trampoline (recorded by
+// MetaspaceShared::collect_adapter_methods()) and generates its c2i/i2c
+// entries, so method A or B linked after that finds its adapter already set.
+// A method linked earlier in startup, or with -XX:-LinkSharedAdaptersAtStartup,
+// allocates the AdapterHandlerEntry itself when it is linked.
 //
 // _i2i_entry and _from_interpreted_entry initially points to the same
 // (fixed) location in the CODE section of the CDS archive. This contains
@@ -29,6 +29,7 @@
 #include "opto/optoreg.hpp"
 #include "opto/output.hpp"
 #include "opto/runtime.hpp"
+#include "runtime/stubRoutines.hpp"
 #include "utilities/macros.hpp"
 
 
@@ -76,6 +77,9 @@ bool C2Compiler::init_c2_runtime() {
 
   Compile::pd_compiler2_init();
 
+  // Generate the intrinsic stubs left out of StubRoutines::initialize2().
+  StubRoutines::initialize_compiler_stubs();
+
   CompilerThread* thread = CompilerThread::current();
 
   HandleMark handle_mark(thread);
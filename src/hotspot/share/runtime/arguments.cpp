@@ -4056,6 +4056,25 @@ jint Arguments::apply_ergo() {
     log_info(ergo)("ThreadLocalHandshakes %s", ThreadLocalHandshakes ? "enabled." : "disabled.");
   }
 
+#ifndef AMD64
+  // Only the x86_64 fast_unlock waits for the monitor deflation thread to
+  // back out instead of giving up succession.
+  if (AsyncDeflateIdleMonitors) {
+    if (!FLAG_IS_DEFAULT(AsyncDeflateIdleMonitors)) {
+      warning("AsyncDeflateIdleMonitors is not supported on this platform; ignoring AsyncDeflateIdleMonitors flag.");
+    }
+    FLAG_SET_ERGO(bool, AsyncDeflateIdleMonitors, false);
+  }
+#endif
+
+  // The monitor deflation thread finds idle monitors on the in-use lists.
+  if (AsyncDeflateIdleMonitors && !MonitorInUseLists) {
+    if (!FLAG_IS_DEFAULT(AsyncDeflateIdleMonitors)) {
+      warning("AsyncDeflateIdleMonitors requires MonitorInUseLists; ignoring AsyncDeflateIdleMonitors flag.");
+    }
+    FLAG_SET_ERGO(bool, AsyncDeflateIdleMonitors, false);
+  }
+
   return JNI_OK;
 }
 
@@ -4072,10 +4091,11 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
-    // all platforms and ParallelGC on Windows will interleave all
-    // of the heap spaces across NUMA nodes.
+    // allocation policy for the eden space. G1 on Linux binds each
+    // heap region to a node and only interleaves its auxiliary data.
+    // Non NUMA-aware collectors such as CMS and Serial-GC on
+    // all platforms and ParallelGC and G1 on other platforms will
+    // interleave all of the heap spaces across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
       FLAG_SET_ERGO(bool, UseNUMAInterleaving, true);
     }
@@ -35,11 +35,14 @@
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/handshake.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/task.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
+#include "utilities/resourceHash.hpp"
 
 
 static bool _biased_locking_enabled = false;
@@ -48,6 +51,85 @@ BiasedLockingCounters BiasedLocking::_counters;
 static GrowableArray<Handle>*  _preserved_oop_stack  = NULL;
 static GrowableArray<markOop>* _preserved_mark_stack = NULL;
 
+// Per-class revocation statistics, collected when
+// PrintBiasedLockingStatistics is enabled. Entries are keyed by class
+// name so that they outlive class unloading.
+enum RevocationKind {
+  SelfRevocation,
+  HandshakeRevocation,
+  SafepointRevocation,
+  BulkRebias,
+  BulkRevocation,
+  NumRevocationKinds
+};
+
+static const char* revocation_kind_names[NumRevocationKinds] = {
+  "self", "handshake", "safepoint", "bulk rebias", "bulk revoke"
+};
+
+class BiasedLockingClassStats {
+ public:
+  uint64_t _count[NumRevocationKinds];
+  // Time the requesting threads waited for the revocations to complete
+  jlong    _wait_ns;
+
+  BiasedLockingClassStats() : _wait_ns(0) {
+    for (int i = 0; i < NumRevocationKinds; i++) {
+      _count[i] = 0;
+    }
+  }
+
+  uint64_t total() const {
+    uint64_t sum = 0;
+    for (int i = 0; i < NumRevocationKinds; i++) {
+      sum += _count[i];
+    }
+    return sum;
+  }
+};
+
+typedef ResourceHashtable<Symbol*, BiasedLockingClassStats,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          256, ResourceObj::C_HEAP, mtInternal> BiasedLockingClassStatsTable;
+
+static BiasedLockingClassStatsTable* _class_stats = NULL;
+
+static void record_revocation(Klass* k, RevocationKind kind, jlong start_ns) {
+  if (!PrintBiasedLockingStatistics) {
+    return;
+  }
+  jlong wait_ns = (start_ns != 0) ? os::javaTimeNanos() - start_ns : 0;
+  MutexLockerEx ml(BiasedLockingStatistics_lock, Mutex::_no_safepoint_check_flag);
+  if (_class_stats == NULL) {
+    _class_stats = new (ResourceObj::C_HEAP, mtInternal) BiasedLockingClassStatsTable();
+  }
+  Symbol* name = k->name();
+  BiasedLockingClassStats* stats = _class_stats->get(name);
+  if (stats == NULL) {
+    name->increment_refcount();
+    _class_stats->put(name, BiasedLockingClassStats());
+    stats = _class_stats->get(name);
+  }
+  stats->_count[kind]++;
+  stats->_wait_ns += wait_ns;
+}
+
+class CollectClassNames : public StackObj {
+  GrowableArray<Symbol*>* _names;
+ public:
+  CollectClassNames(GrowableArray<Symbol*>* names) : _names(names) {}
+  bool do_entry(Symbol* const& name, BiasedLockingClassStats const& stats) {
+    _names->append(name);
+    return true;
+  }
+};
+
+static int compare_class_stats(Symbol** a, Symbol** b) {
+  uint64_t ta = _class_stats->get(*a)->total();
+  uint64_t tb = _class_stats->get(*b)->total();
+  return (ta > tb) ? -1 : ((ta < tb) ? 1 : 0);
+}
+
 static void enable_biased_locking(InstanceKlass* k) {
   k->set_prototype_header(markOopDesc::biased_locking_prototype());
 }
@@ -563,6 +645,76 @@ public:
 };
 
 
+// Revokes the bias of an object while the thread it is biased toward is
+// stopped in a handshake, so that no other thread has to be brought to a
+// safepoint. If the bias changed hands or expired before the handshake
+// ran, the operation is not done and the caller falls back to a safepoint.
+class RevokeOneBias : public HandshakeClosure {
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+  bool _done;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, JavaThread* biased_locker)
+    : HandshakeClosure("RevokeOneBias")
+    , _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0)
+    , _done(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "Wrong thread");
+
+    oop o = _obj();
+    markOop mark = o->mark();
+    if (!mark->has_bias_pattern()) {
+      _done = true;
+      return;
+    }
+
+    markOop prototype = o->klass()->prototype_header();
+    if (!prototype->has_bias_pattern()) {
+      // A bulk revocation for this class happened in the meantime, so the
+      // bias is stale. If the CAS fails another thread has revoked it.
+      o->cas_set_mark(markOopDesc::prototype()->set_age(mark->age()), mark);
+      _status_code = BiasedLocking::BIAS_REVOKED;
+      _done = true;
+      return;
+    }
+
+    if (mark->biased_locker() == _biased_locker &&
+        mark->bias_epoch() == prototype->bias_epoch()) {
+      // The biased thread is the only one that can lock the object
+      // through its bias and it is stopped, and bulk operations cannot
+      // run while we are in the handshake.
+      ResourceMark rm;
+      log_info(biasedlocking)("Revoking bias by walking the stack of the biased thread in a handshake:");
+      _status_code = revoke_bias(o, false, false, _requesting_thread, NULL);
+      _biased_locker->set_cached_monitor_info(NULL);
+      _biased_locker_id = JFR_THREAD_ID(_biased_locker);
+      _done = true;
+    }
+  }
+
+  bool done() const {
+    return _done;
+  }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
+
 class VM_BulkRevokeBias : public VM_RevokeBias {
 private:
   bool _bulk_rebias;
@@ -600,14 +752,17 @@ static void post_self_revocation_event(EventBiasedLockSelfRevocation* event, Kla
   event->commit();
 }
 
-static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, VM_RevokeBias* revoke) {
+static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, traceid biased_locker, bool at_safepoint) {
   assert(event != NULL, "invariant");
   assert(k != NULL, "invariant");
-  assert(revoke != NULL, "invariant");
   assert(event->should_commit(), "invariant");
   event->set_lockClass(k);
-  set_safepoint_id(event);
-  event->set_previousOwner(revoke->biased_locker());
+  if (at_safepoint) {
+    set_safepoint_id(event);
+  } else {
+    event->set_safepointId(0);
+  }
+  event->set_previousOwner(biased_locker);
   event->commit();
 }
 
@@ -709,20 +864,40 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       if (event.should_commit()) {
         post_self_revocation_event(&event, k);
       }
+      record_revocation(k, SelfRevocation, 0);
       return cond;
     } else {
+      jlong start_ns = PrintBiasedLockingStatistics ? os::javaTimeNanos() : 0;
+      JavaThread* biaser = mark->biased_locker();
+      if (BiasedLockingRevokeWithHandshakes && ThreadLocalHandshakes && biaser != NULL) {
+        // Only the thread the object is biased toward has to be stopped
+        // to walk its stack; Handshake::execute returns false if it has
+        // already exited, in which case the safepoint path handles it.
+        EventBiasedLockRevocation event;
+        RevokeOneBias revoke(obj, (JavaThread*) THREAD, biaser);
+        Handshake::execute(&revoke, biaser);
+        if (revoke.done()) {
+          if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
+            post_revocation_event(&event, k, revoke.biased_locker(), false);
+          }
+          record_revocation(k, HandshakeRevocation, start_ns);
+          return revoke.status_code();
+        }
+      }
       EventBiasedLockRevocation event;
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
-        post_revocation_event(&event, k, &revoke);
+        post_revocation_event(&event, k, revoke.biased_locker(), true);
       }
+      record_revocation(k, SafepointRevocation, start_ns);
       return revoke.status_code();
     }
   }
 
   assert((heuristics == HR_BULK_REVOKE) ||
          (heuristics == HR_BULK_REBIAS), "?");
+  jlong start_ns = PrintBiasedLockingStatistics ? os::javaTimeNanos() : 0;
   EventBiasedLockClassRevocation event;
   VM_BulkRevokeBias bulk_revoke(&obj, (JavaThread*) THREAD,
                                 (heuristics == HR_BULK_REBIAS),
@@ -731,6 +906,7 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
   if (event.should_commit()) {
     post_class_revocation_event(&event, obj->klass(), heuristics != HR_BULK_REBIAS);
   }
+  record_revocation(obj->klass(), heuristics == HR_BULK_REBIAS ? BulkRebias : BulkRevocation, start_ns);
   return bulk_revoke.status_code();
 }
 
@@ -740,8 +916,40 @@ void BiasedLocking::revoke(GrowableArray<Handle>* objs) {
   if (objs->length() == 0) {
     return;
   }
-  VM_RevokeBias revoke(objs, JavaThread::current());
-  VMThread::execute(&revoke);
+
+  // The objects are locked in frames being deoptimized or migrated, which
+  // normally belong to the current thread. Revoke the biases toward the
+  // current thread in one pass over our own stack, as for self-revocation
+  // above, and only go to a safepoint for what remains.
+  JavaThread* thread = JavaThread::current();
+  bool needs_safepoint = false;
+  {
+    ResourceMark rm(thread);
+    for (int i = 0; i < objs->length(); i++) {
+      oop obj = (objs->at(i))();
+      markOop mark = obj->mark();
+      if (!mark->has_bias_pattern()) {
+        continue;
+      }
+      markOop prototype_header = obj->klass()->prototype_header();
+      if (!prototype_header->has_bias_pattern() ||
+          prototype_header->bias_epoch() != mark->bias_epoch()) {
+        // Stale bias; if the CAS fails another thread revoked it.
+        obj->cas_set_mark(markOopDesc::prototype()->set_age(mark->age()), mark);
+      } else if (mark->biased_locker() == thread) {
+        revoke_bias(obj, false, false, thread, NULL);
+        record_revocation(obj->klass(), SelfRevocation, 0);
+      } else {
+        needs_safepoint = true;
+      }
+    }
+    thread->set_cached_monitor_info(NULL);
+  }
+
+  if (needs_safepoint) {
+    VM_RevokeBias revoke(objs, thread);
+    VMThread::execute(&revoke);
+  }
 }
 
 
@@ -870,6 +1078,39 @@ int BiasedLockingCounters::slow_path_entry_count() {
   return _total_entry_count - sum;
 }
 
+void BiasedLocking::print_counters() {
+  _counters.print();
+  print_class_statistics(tty);
+}
+
+void BiasedLocking::print_class_statistics(outputStream* st) {
+  MutexLockerEx ml(BiasedLockingStatistics_lock, Mutex::_no_safepoint_check_flag);
+  if (_class_stats == NULL) {
+    return;
+  }
+  ResourceMark rm;
+  GrowableArray<Symbol*>* names = new GrowableArray<Symbol*>(64);
+  CollectClassNames collect(names);
+  _class_stats->iterate(&collect);
+  names->sort(compare_class_stats);
+
+  st->print_cr("# bias revocations per class:");
+  st->print("# %10s", "total");
+  for (int k = 0; k < NumRevocationKinds; k++) {
+    st->print(" %12s", revocation_kind_names[k]);
+  }
+  st->print_cr(" %12s  class", "wait (ms)");
+  for (int i = 0; i < names->length(); i++) {
+    Symbol* name = names->at(i);
+    BiasedLockingClassStats* stats = _class_stats->get(name);
+    st->print("# " UINT64_FORMAT_W(10), stats->total());
+    for (int k = 0; k < NumRevocationKinds; k++) {
+      st->print(" " UINT64_FORMAT_W(12), stats->_count[k]);
+    }
+    st->print_cr(" %12.3f  %s", (double)stats->_wait_ns / NANOSECS_PER_MILLISEC, name->as_C_string());
+  }
+}
+
 void BiasedLockingCounters::print_on(outputStream* st) {
   tty->print_cr("# total entries: %d", _total_entry_count);
   tty->print_cr("# biased lock entries: %d", _biased_lock_entry_count);
@@ -182,7 +182,10 @@ public:
   static void revoke_at_safepoint(Handle obj);
   static void revoke_at_safepoint(GrowableArray<Handle>* objs);
 
-  static void print_counters() { _counters.print(); }
+  // Prints the global counters followed by the per-class revocation
+  // statistics; both are collected with PrintBiasedLockingStatistics
+  static void print_counters();
+  static void print_class_statistics(outputStream* st);
   static BiasedLockingCounters* counters() { return &_counters; }
 
   // These routines are GC-related and should not be called by end
@@ -837,6 +837,7 @@ static JVMFlag flagTable[] = {
                    RUNTIME_PD_PRODUCT_FLAG_STRUCT, \
                    RUNTIME_DIAGNOSTIC_FLAG_STRUCT, \
                    RUNTIME_PD_DIAGNOSTIC_FLAG_STRUCT, \
+                   RUNTIME_EXPERIMENTAL_FLAG_STRUCT, \
                    RUNTIME_NOTPRODUCT_FLAG_STRUCT, \
                    IGNORE_RANGE, \
                    IGNORE_CONSTRAINT, \
@@ -293,6 +293,24 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Use large page memory in metaspace. "                            \
           "Only used if UseLargePages is enabled.")                         \
                                                                             \
+  product(bool, UseTransparentHugePagesForHeap, true,                       \
+          "Back the Java heap with transparent huge pages. "                \
+          "Only used if UseTransparentHugePages is enabled.")               \
+                                                                            \
+  product(bool, UseTransparentHugePagesForCodeCache, true,                  \
+          "Back the code cache with transparent huge pages. "               \
+          "Only used if UseTransparentHugePages is enabled.")               \
+                                                                            \
+  product(bool, UseTransparentHugePagesForClassSpace, false,                \
+          "Back the compressed class space with transparent huge pages. "   \
+          "Only used if UseTransparentHugePages is enabled.")               \
+                                                                            \
+  product(bool, UseTransparentHugePagesForCDSArchive, false,                \
+          "Read the CDS archive into memory backed by transparent huge "    \
+          "pages instead of mapping it, and align the archive regions to "  \
+          "the huge page size when dumping. "                               \
+          "Only used if UseTransparentHugePages is enabled.")               \
+                                                                            \
   product(bool, UseNUMA, false,                                             \
           "Use NUMA if available")                                          \
                                                                             \
@@ -438,9 +456,19 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, UseLegacyJNINameEscaping, false,                            \
           "Use the original JNI name escaping scheme")                      \
                                                                             \
+  diagnostic(bool, JNICallStatistics, false,                                \
+          "Count calls through compiled native wrappers and the time "      \
+          "spent blocking on return from native; reported with the "        \
+          "NativeMethodStatistics JFR event and printed at exit")           \
+                                                                            \
   notproduct(bool, StressCriticalJNINatives, false,                         \
           "Exercise register saving code in critical natives")              \
                                                                             \
+  diagnostic(bool, DelayCompilerStubsGeneration, COMPILER2_PRESENT(true) NOT_COMPILER2(false), \
+          "Generate the intrinsic stubs used only by C2 when the first "    \
+          "C2 compiler thread initializes instead of during VM startup. "   \
+          "Only x86_64 generates these stubs separately")                   \
+                                                                            \
   diagnostic(bool, UseAESIntrinsics, false,                                 \
           "Use intrinsics for AES versions of crypto")                      \
                                                                             \
@@ -858,6 +886,21 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
                                                                             \
   product(bool, MonitorInUseLists, true, "Track Monitors for Deflation")    \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors,                                   \
+          AMD64_ONLY(true) NOT_AMD64(false),                                \
+          "Deflate idle monitors concurrently on the monitor deflation "    \
+          "thread, using handshakes, instead of during safepoint cleanup. " \
+          "Requires MonitorInUseLists. Only supported on x86_64")           \
+                                                                            \
+  diagnostic(intx, AsyncDeflationInterval, 250,                             \
+          "Interval in ms at which the monitor deflation thread checks "    \
+          "whether idle monitors should be deflated")                       \
+          range(1, max_jint)                                                \
+                                                                            \
+  product(intx, MonitorCacheSize, 4096,                                     \
+          "Maximum number of free monitors cached per thread")              \
+          range(32, max_jint)                                               \
+                                                                            \
   experimental(intx, MonitorUsedDeflationThreshold, 90,                     \
                 "Percentage of used monitors before triggering cleanup "    \
                 "safepoint which deflates monitors (0 is off). "            \
@@ -972,6 +1015,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(bool, PrintBiasedLockingStatistics, false,                     \
           "Print statistics of biased locking in JVM")                      \
                                                                             \
+  product(bool, BiasedLockingRevokeWithHandshakes, true,                    \
+          "Revoke the bias of a single object with a handshake with the "   \
+          "thread it is biased toward instead of a global safepoint")       \
+                                                                            \
   product(intx, BiasedLockingBulkRebiasThreshold, 20,                       \
           "Threshold of number of revocations per type to try to "          \
           "rebias all objects in the heap of that type")                    \
@@ -1158,6 +1205,23 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
              "Reduce the number of parallel compiler threads when they "    \
              "are not used")                                                \
                                                                             \
+  product(uintx, CompilerThreadCPUShare, 50,                                \
+          "Percentage of the active processors (as limited by the "         \
+          "container CPU quota) that C1 and C2 compiler threads together "  \
+          "may occupy when UseDynamicNumberOfCompilerThreads is on. At "    \
+          "least one thread per compiler is always kept")                   \
+          range(1, 100)                                                     \
+                                                                            \
+  product(size_t, CompilerArenaLimit, 0,                                    \
+          "Maximum arena memory in bytes a single compilation may use. "    \
+          "A compilation above the limit bails out and the method is not "  \
+          "compiled at that tier again. 0 means no limit")                  \
+                                                                            \
+  product(size_t, CompilerArenaPoolSize, 4*M,                               \
+          "Bytes of arena chunks each compiler thread keeps for reuse by "  \
+          "its next compilations. The chunks are freed when the thread "    \
+          "has been idle for a while")                                      \
+                                                                            \
   diagnostic(bool, TraceCompilerThreads, false,                             \
              "Trace creation and removal of compiler threads")              \
                                                                             \
@@ -1657,6 +1721,12 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
   NOT_LP64(range(0, max_intx))                                              \
                                                                             \
+  product(intx, SafepointSyncProfileInterval, 0,                            \
+          "Sample where threads that delay safepoint synchronization are "  \
+          "every this many milliseconds while synchronizing "               \
+          "(0 means never)")                                                \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, NmethodSweepActivity, 10,                                   \
           "Removes cold nmethods from code cache if > 0. Higher values "    \
           "result in more aggressive sweeping")                             \
@@ -1956,6 +2026,18 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Size of code heap with non-nmethods (in bytes)")                 \
           range(os::vm_page_size(), max_uintx)                              \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of code heap with hot tier 4 methods (in bytes). The "      \
+          "sweeper recompiles the most invoked methods into this heap to "  \
+          "improve iTLB and instruction cache locality. 0 disables it. "    \
+          "Requires SegmentedCodeCache and TieredCompilation")              \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(intx, HotCodeClusteringInterval, 30000,                           \
+          "Minimum time (in ms) between two passes of the sweeper that "    \
+          "select methods for the hot code heap")                           \
+          range(100, max_jint)                                              \
+                                                                            \
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
           range(32*K, max_uintx)                                            \
@@ -1976,6 +2058,14 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Non-segmented code cache: X[%] of the total code cache")         \
           range(0, 100)                                                     \
                                                                             \
+  product(uintx, CodeCacheSweeperThreads, 1,                                \
+          "Number of threads that sweep the code cache in parallel")        \
+          range(1, 64)                                                      \
+                                                                            \
+  diagnostic(uintx, CodeCacheSweepChunkSize, 64,                            \
+          "Number of compiled methods a sweeper thread claims at a time")   \
+          range(1, 65536)                                                   \
+                                                                            \
   /* AOT parameters */                                                      \
   experimental(bool, UseAOT, false,                                         \
           "Use AOT compiled files")                                         \
@@ -2065,6 +2155,19 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, DumpReplayDataOnError, true,                                \
           "Record replay data for crashing compiler threads")               \
                                                                             \
+  product(ccstr, ReplayCorpusFile, NULL,                                    \
+          "Record the replay data of every successful compilation in this " \
+          "file to build a replay corpus (%p replaced with pid)")           \
+                                                                            \
+  product(uintx, ReplayCorpusWindow, 0,                                     \
+          "Only record compilations that finish within the first X ms "     \
+          "after VM start in ReplayCorpusFile, 0 records all of them")      \
+                                                                            \
+  develop(bool, ReplayCorpus, false,                                        \
+          "Replay all compilations of a replay corpus in ReplayDataFile, "  \
+          "skip entries that cannot be replayed and report compile time "   \
+          "and memory per compiler")                                        \
+                                                                            \
   product(bool, CICompilerCountPerCPU, false,                               \
           "1 compiler thread for log(N CPUs)")                              \
                                                                             \
@@ -2485,6 +2588,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, RequireSharedSpaces, false,                                 \
           "Require shared spaces for metadata")                             \
                                                                             \
+  diagnostic(bool, LinkSharedAdaptersAtStartup, true,                       \
+          "Generate the adapters of all archived method signatures in "     \
+          "one batch at startup instead of when each method is linked")     \
+                                                                            \
   product(bool, DumpSharedSpaces, false,                                    \
           "Special mode: JVM reads a class list, loads classes, builds "    \
           "shared spaces, and dumps the shared spaces to a file to be "     \
@@ -2514,6 +2621,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Support pre-initializing and preserving selected classes and "   \
           "individual static fields during static CDS dump time.")          \
                                                                             \
+  product(bool, ArchiveInterpreterOopMaps, true,                            \
+          "Precompute the interpreter oop maps of the call, allocation "   \
+          "and monitorenter sites of archived methods during static CDS "  \
+          "dump time")                                                      \
+                                                                            \
   product(bool, PrintSharedArchiveAndExit, false,                           \
           "Print shared archive file contents")                             \
                                                                             \
@@ -2832,6 +2944,7 @@ RUNTIME_OS_FLAGS(DECLARE_DEVELOPER_FLAG, \
                  DECLARE_PD_PRODUCT_FLAG, \
                  DECLARE_DIAGNOSTIC_FLAG, \
                  DECLARE_PD_DIAGNOSTIC_FLAG, \
+                 DECLARE_EXPERIMENTAL_FLAG, \
                  DECLARE_NOTPRODUCT_FLAG, \
                  IGNORE_RANGE, \
                  IGNORE_CONSTRAINT, \
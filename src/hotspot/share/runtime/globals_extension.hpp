@@ -113,6 +113,7 @@ typedef enum {
                   RUNTIME_PD_PRODUCT_FLAG_MEMBER, \
                   RUNTIME_DIAGNOSTIC_FLAG_MEMBER, \
                   RUNTIME_PD_DIAGNOSTIC_FLAG_MEMBER, \
+                  RUNTIME_EXPERIMENTAL_FLAG_MEMBER, \
                   RUNTIME_NOTPRODUCT_FLAG_MEMBER, \
                   IGNORE_RANGE, \
                   IGNORE_CONSTRAINT, \
@@ -242,6 +243,7 @@ typedef enum {
                   RUNTIME_PD_PRODUCT_FLAG_MEMBER_WITH_TYPE,
                   RUNTIME_DIAGNOSTIC_FLAG_MEMBER_WITH_TYPE,
                   RUNTIME_PD_DIAGNOSTIC_FLAG_MEMBER_WITH_TYPE,
+                  RUNTIME_EXPERIMENTAL_FLAG_MEMBER_WITH_TYPE,
                   RUNTIME_NOTPRODUCT_FLAG_MEMBER_WITH_TYPE,
                   IGNORE_RANGE,
                   IGNORE_CONSTRAINT,
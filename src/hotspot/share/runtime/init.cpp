@@ -142,6 +142,7 @@ jint init_globals() {
     return JNI_ERR;
   }
   stubRoutines_init2(); // note: StubRoutines need 2-phase init
+  AdapterHandlerLibrary::link_shared_adapters(); // after stubRoutines_init2, for VerifyAdapterCalls
   MethodHandles::generate_adapters();
 
 #if INCLUDE_NMT
@@ -61,6 +61,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/memprofiler.hpp"
+#include "runtime/nativeCallStatistics.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/sweeper.hpp"
@@ -375,6 +376,10 @@ void print_statistics() {
     BiasedLocking::print_counters();
   }
 
+  if (JNICallStatistics) {
+    NativeCallStatistics::print_on(tty);
+  }
+
   // Native memory tracking data
   if (PrintNMTStatistics) {
     MemTracker::final_report(tty);
@@ -418,6 +423,10 @@ void print_statistics() {
     BiasedLocking::print_counters();
   }
 
+  if (JNICallStatistics) {
+    NativeCallStatistics::print_on(tty);
+  }
+
   // Native memory tracking data
   if (PrintNMTStatistics) {
     MemTracker::final_report(tty);
@@ -515,6 +524,13 @@ void before_exit(JavaThread* thread) {
     }
   }
 
+  // Print how much of the heap and other spaces is backed by large pages.
+  LogTarget(Info, pagesize) pagesize_log;
+  if (pagesize_log.is_enabled()) {
+    LogStream ls(pagesize_log);
+    os::print_large_page_coverage(&ls);
+  }
+
   if (PrintBytecodeHistogram) {
     BytecodeHistogram::print();
   }
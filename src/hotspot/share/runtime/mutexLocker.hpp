@@ -70,6 +70,8 @@ extern Monitor* CGCPhaseManager_lock;            // a lock to protect a concurre
 extern Monitor* VMOperationQueue_lock;           // a lock on queue of vm_operations waiting to execute
 extern Monitor* VMOperationRequest_lock;         // a lock on Threads waiting for a vm_operation to terminate
 extern Monitor* Safepoint_lock;                  // a lock used by the safepoint abstraction
+extern Mutex*   SafepointSyncProfile_lock;       // a lock on the safepoint sync profile
+extern Mutex*   BiasedLockingStatistics_lock;    // a lock on the per-class biased locking statistics
 extern Monitor* Threads_lock;                    // a lock on the Threads table of active Java threads
                                                  // (also used by Safepoints too to block threads creation/destruction)
 extern Mutex*   NonJavaThreadsList_lock;         // a lock on the NonJavaThreads list
@@ -129,6 +131,7 @@ extern Monitor* RootRegionScan_lock;             // used to notify that the CM t
 
 extern Mutex*   Management_lock;                 // a lock used to serialize JVM management
 extern Monitor* Service_lock;                    // a lock used for service thread operation
+extern Monitor* MonitorDeflation_lock;           // a lock used for monitor deflation thread operation
 extern Monitor* PeriodicTask_lock;               // protects the periodic task structure
 extern Mutex*   ThreadIdTableCreate_lock;        // Used by ThreadIdTable to lazily create the thread id table
 extern Monitor* RedefineClasses_lock;            // locks classes from parallel redefinition
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/nativeCallStatistics.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/ostream.hpp"
+
+NativeCallCounters* volatile NativeCallStatistics::_head = NULL;
+
+NativeCallCounters::NativeCallCounters(const char* name, bool leaf, NativeCallCounters* next) :
+  _next(next),
+  _name(os::strdup(name, mtInternal)),
+  _leaf(leaf),
+  _calls(0),
+  _slow_transitions(0),
+  _slow_transition_ns(0) {
+}
+
+NativeCallCounters* NativeCallStatistics::counters_for(const methodHandle& method, bool leaf) {
+  assert_lock_strong(AdapterHandlerLibrary_lock);
+  ResourceMark rm;
+  const char* name = method->name_and_sig_as_C_string();
+  for (NativeCallCounters* c = _head; c != NULL; c = c->_next) {
+    if (strcmp(c->_name, name) == 0) {
+      c->_leaf = leaf;
+      return c;
+    }
+  }
+  // Readers walk the list without the lock
+  NativeCallCounters* c = new NativeCallCounters(name, leaf, _head);
+  OrderAccess::release_store(&_head, c);
+  return c;
+}
+
+void NativeCallStatistics::check_special_condition_for_native_trans(JavaThread* thread, NativeCallCounters* counters) {
+  jlong start = os::javaTimeNanos();
+  JavaThread::check_special_condition_for_native_trans(thread);
+  Atomic::inc(&counters->_slow_transitions);
+  Atomic::add(os::javaTimeNanos() - start, &counters->_slow_transition_ns);
+}
+
+void NativeCallStatistics::post_events() {
+  for (NativeCallCounters* c = OrderAccess::load_acquire(&_head); c != NULL; c = c->_next) {
+    if (c->_calls == 0) {
+      continue;
+    }
+    EventNativeMethodStatistics event;
+    event.set_method(c->_name);
+    event.set_leaf(c->_leaf);
+    event.set_calls(c->_calls);
+    event.set_slowTransitions(c->_slow_transitions);
+    event.set_slowTransitionTime(c->_slow_transition_ns);
+    event.commit();
+  }
+}
+
+void NativeCallStatistics::print_on(outputStream* st) {
+  st->print_cr("Native method call statistics:");
+  st->print_cr("%14s %10s %14s  %s", "calls", "slow ret", "slow ret (ms)", "method");
+  for (NativeCallCounters* c = OrderAccess::load_acquire(&_head); c != NULL; c = c->_next) {
+    st->print_cr(INT64_FORMAT_W(14) " " INT64_FORMAT_W(10) " %14.3f  %s%s",
+                 c->_calls, c->_slow_transitions,
+                 (double)c->_slow_transition_ns / NANOSECS_PER_MILLISEC,
+                 c->_name, c->_leaf ? " (leaf)" : "");
+  }
+}
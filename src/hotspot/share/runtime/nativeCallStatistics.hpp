@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_NATIVECALLSTATISTICS_HPP
+#define SHARE_VM_RUNTIME_NATIVECALLSTATISTICS_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class JavaThread;
+class methodHandle;
+class outputStream;
+
+// Per-native counters maintained by the compiled native wrappers
+// (-XX:+JNICallStatistics). The counters are keyed by method name so that
+// a wrapper regenerated after deoptimization reuses the same entry, and
+// so that they outlive class unloading.
+class NativeCallCounters : public CHeapObj<mtInternal> {
+  friend class NativeCallStatistics;
+ private:
+  NativeCallCounters* _next;
+  char*               _name;
+  bool                _leaf;
+  // Updated without atomics by the wrapper, so approximate
+  volatile jlong      _calls;
+  // Returns from native that had to block for a safepoint or suspension
+  volatile jlong      _slow_transitions;
+  volatile jlong      _slow_transition_ns;
+
+ public:
+  NativeCallCounters(const char* name, bool leaf, NativeCallCounters* next);
+
+  address calls_addr() { return (address)&_calls; }
+};
+
+class NativeCallStatistics : AllStatic {
+ private:
+  static NativeCallCounters* volatile _head;
+
+ public:
+  // Find or create the counters for a native wrapper being generated.
+  // Called with the AdapterHandlerLibrary_lock held.
+  static NativeCallCounters* counters_for(const methodHandle& method, bool leaf);
+
+  // Slow path of the return from native: blocks for a pending safepoint or
+  // suspension as JavaThread::check_special_condition_for_native_trans
+  // does, and accounts the time to the native.
+  static void check_special_condition_for_native_trans(JavaThread* thread, NativeCallCounters* counters);
+
+  // Post a NativeMethodStatistics JFR event per native.
+  static void post_events();
+
+  static void print_on(outputStream* st);
+};
+
+#endif // SHARE_VM_RUNTIME_NATIVECALLSTATISTICS_HPP
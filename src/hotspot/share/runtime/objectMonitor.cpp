@@ -262,7 +262,7 @@ void ObjectMonitor::operator delete[] (void *p) {
 // -----------------------------------------------------------------------------
 // Enter support
 
-void ObjectMonitor::enter(TRAPS) {
+bool ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD;
@@ -272,13 +272,13 @@ void ObjectMonitor::enter(TRAPS) {
     // Either ASSERT _recursions == 0 or explicitly set _recursions = 0.
     assert(_recursions == 0, "invariant");
     assert(_owner == Self, "invariant");
-    return;
+    return true;
   }
 
   if (cur == Self) {
     // TODO-FIXME: check for integer overflow!  BUGID 6557169.
     _recursions++;
-    return;
+    return true;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -287,7 +287,7 @@ void ObjectMonitor::enter(TRAPS) {
     // Commute owner from a thread-specific on-stack BasicLockObject address to
     // a full-fledged "Thread *".
     _owner = Self;
-    return;
+    return true;
   }
 
   // We've encountered genuine contention.
@@ -299,12 +299,12 @@ void ObjectMonitor::enter(TRAPS) {
   // transitions.  The following spin is strictly optional ...
   // Note that if we acquire the monitor from an initial spin
   // we forgo posting JVMTI events and firing DTRACE probes.
-  if (Knob_SpinEarly && TrySpin (Self) > 0) {
+  if (Knob_SpinEarly && cur != DEFLATER_MARKER && TrySpin (Self) > 0) {
     assert(_owner == Self, "invariant");
     assert(_recursions == 0, "invariant");
     assert(((oop)(object()))->mark() == markOopDesc::encode(this), "invariant");
     Self->_Stalled = 0;
-    return;
+    return true;
   }
 
   assert(_owner != Self, "invariant");
@@ -314,11 +314,19 @@ void ObjectMonitor::enter(TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(jt->thread_state() != _thread_blocked, "invariant");
   assert(this->object() != NULL, "invariant");
-  assert(_count >= 0, "invariant");
+  assert(AsyncDeflateIdleMonitors || _count >= 0, "invariant");
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
-  Atomic::inc(&_count);
+  if (Atomic::add(1, &_count) <= 0) {
+    // The monitor deflation thread won the race and has deflated this
+    // monitor. Make sure the object no longer refers to it and let the
+    // caller retry with the object's current mark.
+    Atomic::dec(&_count);
+    install_displaced_markword_in_object();
+    Self->_Stalled = 0;
+    return false;
+  }
 
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(jt);)
   EventJavaMonitorEnter event;
@@ -416,6 +424,47 @@ void ObjectMonitor::enter(TRAPS) {
     event.commit();
   }
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
+  return true;
+}
+
+// Restore the displaced header of an asynchronously deflated monitor to its
+// object. Both the deflating thread and a thread that lost an enter() race
+// against it may do this; the header is immutable at this point because
+// deflation installs a hash code first.
+void ObjectMonitor::install_displaced_markword_in_object() {
+  assert(is_being_async_deflated(), "only for deflated monitors");
+  oop obj = (oop) object();
+  markOop dmw = header();
+  assert(dmw->is_neutral() && dmw->hash() != markOopDesc::no_hash, "invariant");
+  obj->cas_set_mark(dmw, markOopDesc::encode(this));
+}
+
+// Take over a monitor whose deflation the monitor deflation thread has
+// started but not committed. The caller has already incremented _count, so
+// the deflation is bound to fail; the extra increment here is dropped by
+// the deflation thread when it backs out.
+bool ObjectMonitor::try_cancel_async_deflation(Thread * Self) {
+  if (AsyncDeflateIdleMonitors &&
+      Atomic::cmpxchg(Self, &_owner, DEFLATER_MARKER) == DEFLATER_MARKER) {
+    assert(_recursions == 0, "invariant");
+    Atomic::inc(&_count);
+    return true;
+  }
+  return false;
+}
+
+// Reacquire the lock in exit() so that a successor can be woken. Returns
+// false if another thread owns the lock and has therefore taken over the
+// responsibility for succession. The monitor deflation thread never does:
+// it only holds the lock transiently and backs out while threads are
+// queued, so wait for it to let go.
+bool ObjectMonitor::reacquire_for_succession(Thread * Self) {
+  for (;;) {
+    void * own = Atomic::cmpxchg((void*)Self, &_owner, (void*)NULL);
+    if (own == NULL) return true;
+    if (own != DEFLATER_MARKER) return false;
+    SpinPause();
+  }
 }
 
 // Caveat: TryLock() is not necessarily serializing if it returns failure.
@@ -445,7 +494,7 @@ void ObjectMonitor::EnterI(TRAPS) {
   assert(((JavaThread *) Self)->thread_state() == _thread_blocked, "invariant");
 
   // Try the lock - TATAS
-  if (TryLock (Self) > 0) {
+  if (TryLock (Self) > 0 || try_cancel_async_deflation(Self)) {
     assert(_succ != Self, "invariant");
     assert(_owner == Self, "invariant");
     assert(_Responsible != Self, "invariant");
@@ -552,7 +601,7 @@ void ObjectMonitor::EnterI(TRAPS) {
 
   for (;;) {
 
-    if (TryLock(Self) > 0) break;
+    if (TryLock(Self) > 0 || try_cancel_async_deflation(Self)) break;
     assert(_owner != Self, "invariant");
 
     if ((SyncFlags & 2) && _Responsible == NULL) {
@@ -573,7 +622,7 @@ void ObjectMonitor::EnterI(TRAPS) {
       Self->_ParkEvent->park();
     }
 
-    if (TryLock(Self) > 0) break;
+    if (TryLock(Self) > 0 || try_cancel_async_deflation(Self)) break;
 
     // The lock is still contested.
     // Keep a tally of the # of futile wakeups.
@@ -705,6 +754,7 @@ void ObjectMonitor::ReenterI(Thread * Self, ObjectWaiter * SelfNode) {
     assert(_owner != Self, "invariant");
 
     if (TryLock(Self) > 0) break;
+    if (try_cancel_async_deflation(Self)) break;
     if (TrySpin(Self) > 0) break;
 
     TEVENT(Wait Reentry - parking);
@@ -1010,7 +1060,7 @@ void ObjectMonitor::exit(bool not_suspended, TRAPS) {
       // to reacquire the lock the responsibility for ensuring succession
       // falls to the new owner.
       //
-      if (!Atomic::replace_if_null(THREAD, &_owner)) {
+      if (!reacquire_for_succession(Self)) {
         return;
       }
       TEVENT(Exit - Reacquired);
@@ -1035,7 +1085,7 @@ void ObjectMonitor::exit(bool not_suspended, TRAPS) {
         // B.  If the elements forming the EntryList|cxq are TSM
         //     we could simply unpark() the lead thread and return
         //     without having set _succ.
-        if (!Atomic::replace_if_null(THREAD, &_owner)) {
+        if (!reacquire_for_succession(Self)) {
           TEVENT(Inflated exit - reacquired succeeded);
           return;
         }
@@ -1346,16 +1396,18 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->is_Java_thread(), "Must be Java thread!");
   JavaThread *jt = (JavaThread *)THREAD;
 
   guarantee(_owner != Self, "reenter already owner");
-  enter(THREAD);       // enter the monitor
+  if (!enter(THREAD)) {  // enter the monitor
+    return false;
+  }
   guarantee(_recursions == 0, "reenter recursion");
   _recursions = recursions;
-  return;
+  return true;
 }
 
 
@@ -1595,7 +1647,8 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
     assert(_owner != Self, "invariant");
     ObjectWaiter::TStates v = node.TState;
     if (v == ObjectWaiter::TS_RUN) {
-      enter(Self);
+      // _waiters is still non-zero, so the monitor cannot be deflated.
+      guarantee(enter(Self), "a monitor with waiters is never deflated");
     } else {
       guarantee(v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant");
       ReenterI(Self, &node);
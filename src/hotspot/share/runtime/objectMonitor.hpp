@@ -59,6 +59,11 @@ class ObjectWaiter : public StackObj {
   void wait_reenter_end(ObjectMonitor *mon);
 };
 
+// Owner value installed by the monitor deflation thread while it deflates
+// an idle monitor concurrently. See
+// ObjectSynchronizer::deflate_monitor_using_handshakes().
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
 // The ObjectMonitor class implements the heavyweight version of a
 // JavaMonitor. The lightweight BasicLock/stack lock version has been
 // inflated into an ObjectMonitor. This inflation is typically due to
@@ -166,6 +171,8 @@ class ObjectMonitor {
   volatile jint  _count;            // reference count to prevent reclamation/deflation
                                     // at stop-the-world time.  See deflate_idle_monitors().
                                     // _count is approximately |_WaitSet| + |_EntryList|
+                                    // Negative once the monitor has been deflated
+                                    // asynchronously.
  protected:
   ObjectWaiter * volatile _WaitSet; // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
@@ -245,6 +252,11 @@ class ObjectMonitor {
 
   intptr_t  is_entered(Thread* current) const;
 
+  // True once an asynchronous deflation has committed: the object no longer
+  // (or is about to no longer) refer to this monitor.
+  bool      is_being_async_deflated() const                            { return _count < 0; }
+  void      install_displaced_markword_in_object();
+
   void*     owner() const;
   void      set_owner(void* owner);
 
@@ -285,6 +297,16 @@ class ObjectMonitor {
     _recursions    = 0;
   }
 
+  // Make an asynchronously deflated monitor available for reuse, once no
+  // thread can still refer to it.
+  void clear_deflated() {
+    assert(_owner == DEFLATER_MARKER && is_being_async_deflated(), "not deflated");
+    _header = NULL;
+    _object = NULL;
+    _count  = 0;
+    _owner  = NULL;
+  }
+
  public:
 
   void*     object() const;
@@ -297,7 +319,9 @@ class ObjectMonitor {
   static void sanity_checks();  // public for -XX:+ExecuteInternalVMTests
                                 // in PRODUCT for -XX:SyncKnobs=Verbose=1
 
-  void      enter(TRAPS);
+  // Returns false if the monitor was deflated asynchronously before it
+  // could be entered; the caller must inflate the object again and retry.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -305,7 +329,7 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter(ObjectWaiter * waiter);
@@ -317,6 +341,8 @@ class ObjectMonitor {
   void      ReenterI(Thread * Self, ObjectWaiter * SelfNode);
   void      UnlinkAfterAcquire(Thread * Self, ObjectWaiter * SelfNode);
   int       TryLock(Thread * Self);
+  bool      try_cancel_async_deflation(Thread * Self);
+  bool      reacquire_for_succession(Thread * Self);
   int       NotRunnable(Thread * Self, Thread * Owner);
   int       TrySpin(Thread * Self);
   void      ExitEpilog(Thread * Self, ObjectWaiter * Wakee);
@@ -1825,8 +1825,10 @@ bool os::release_memory(char* addr, size_t bytes) {
 }
 
 void os::pretouch_memory(void* start, void* end, size_t page_size) {
-  for (volatile char *p = (char*)start; p < (char*)end; p += page_size) {
-    *p = 0;
+  // Add zero atomically instead of storing, so that memory that is already
+  // in use by other threads keeps its contents.
+  for (char* p = (char*)start; p < (char*)end; p += page_size) {
+    Atomic::add(0, (volatile int*)p);
   }
 }
 
@@ -349,7 +349,8 @@ class os: AllStatic {
   // Touch memory pages that cover the memory range from start to end (exclusive)
   // to make the OS back the memory range with actual memory.
   // Current implementation may not touch the last page if unaligned addresses
-  // are passed.
+  // are passed. The contents of the memory are not changed, so the range may
+  // already be in use concurrently.
   static void   pretouch_memory(void* start, void* end, size_t page_size = vm_page_size());
 
   enum ProtType { MEM_PROT_NONE, MEM_PROT_READ, MEM_PROT_RW, MEM_PROT_RWX };
@@ -408,6 +409,20 @@ class os: AllStatic {
   static bool   can_commit_large_page_memory();
   static bool   can_execute_large_page_memory();
 
+  // Large page policy per memory type. Only transparent huge pages on Linux
+  // have a policy per type; elsewhere these do nothing.
+  //
+  // Registers [addr, addr + bytes) as the reserved memory of the given type
+  // (mtJavaHeap, mtCode, mtClass or mtClassShared), so that memory committed
+  // in it follows the policy for that type.
+  static void   register_large_page_region(char* addr, size_t bytes, MEMFLAGS flag);
+  // Returns whether committed memory of the given type is advised to be
+  // backed by transparent huge pages.
+  static bool   uses_transparent_huge_pages(MEMFLAGS flag);
+  // Prints how much of each registered region is backed by large pages.
+  // Reads /proc files with stdio, so must not be called during error reporting.
+  static void   print_large_page_coverage(outputStream* st);
+
   // OS interface to polling page
   static address get_polling_page()             { return _polling_page; }
   static void    set_polling_page(address page) { _polling_page = page; }
@@ -865,6 +880,9 @@ class os: AllStatic {
   // System loadavg support.  Returns -1 if load average cannot be obtained.
   static int loadavg(double loadavg[], int nelem);
 
+  // Resident set size of the process in bytes, or 0 if it cannot be obtained.
+  static size_t current_rss();
+
   // Hook for os specific jvm options that we don't want to abort on seeing
   static bool obsolete_option(const JavaVMOption *option);
 
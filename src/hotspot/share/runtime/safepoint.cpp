@@ -54,6 +54,7 @@
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
+#include "runtime/safepointSyncProfiler.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -283,6 +284,9 @@ void SafepointSynchronize::begin() {
       if (SafepointTimeout)
         safepoint_limit_time = os::javaTimeNanos() + (jlong)SafepointTimeoutDelay * MICROUNITS;
 
+      const jlong sample_interval = (jlong)SafepointSyncProfileInterval * NANOSECS_PER_MILLISEC;
+      jlong next_sample_time = os::javaTimeNanos() + sample_interval;
+
       // Iterate through all threads until it have been determined how to stop them all at a safepoint
       int steps = 0 ;
       while(still_running > 0) {
@@ -323,6 +327,12 @@ void SafepointSynchronize::begin() {
             print_safepoint_timeout(_spinning_timeout);
           }
 
+          // Record where the threads that hold us up are.
+          if (sample_interval > 0 && next_sample_time < os::javaTimeNanos()) {
+            SafepointSyncProfiler::sample_running_threads(jtiwh.list());
+            next_sample_time = os::javaTimeNanos() + sample_interval;
+          }
+
           // Spin to avoid context switching.
           // There's a tension between allowing the mutators to run (and rendezvous)
           // vs spinning.  As the VM thread spins, wasting cycles, it consumes CPU that
@@ -635,17 +645,32 @@ private:
   ParallelSPCleanupThreadClosure _cleanup_threads_cl;
   uint _num_workers;
   DeflateMonitorCounters* _counters;
+  // Time each worker spent in the per-thread pass, indexed by worker id.
+  jlong* _thread_pass_ns;
 public:
   ParallelSPCleanupTask(uint num_workers, DeflateMonitorCounters* counters) :
     AbstractGangTask("Parallel Safepoint Cleanup"),
     _cleanup_threads_cl(ParallelSPCleanupThreadClosure(counters)),
     _num_workers(num_workers),
     _subtasks(SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS),
-    _counters(counters) {}
+    _counters(counters),
+    _thread_pass_ns(NEW_RESOURCE_ARRAY(jlong, num_workers)) {
+    for (uint i = 0; i < num_workers; i++) {
+      _thread_pass_ns[i] = 0;
+    }
+  }
 
   void work(uint worker_id) {
     // All threads deflate monitors and mark nmethods (if necessary).
-    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+    {
+      EventSafepointCleanupTask event;
+      jlong start = os::javaTimeNanos();
+      Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+      _thread_pass_ns[worker_id] = os::javaTimeNanos() - start;
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, "per-thread cleanup");
+      }
+    }
 
     if (!_subtasks.is_task_claimed(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
       const char* name = "deflating idle monitors";
@@ -724,12 +749,42 @@ public:
     }
     _subtasks.all_tasks_completed(_num_workers);
   }
+
+  // The per-thread pass is shared by all workers, so it is reported as
+  // the slowest and the average worker rather than by TraceTime.
+  void log_thread_pass() const {
+    LogTarget(Info, safepoint, cleanup) lt;
+    if (lt.is_enabled()) {
+      jlong max_ns = 0;
+      jlong sum_ns = 0;
+      for (uint i = 0; i < _num_workers; i++) {
+        max_ns = MAX2(max_ns, _thread_pass_ns[i]);
+        sum_ns += _thread_pass_ns[i];
+      }
+      lt.print("per-thread cleanup, %u workers: max %.7fs, avg %.7fs", _num_workers,
+               (double)max_ns / NANOSECS_PER_SEC,
+               (double)sum_ns / _num_workers / NANOSECS_PER_SEC);
+    }
+  }
 };
 
+// Number of safepoint workers to wake up: the per-thread pass is the only
+// part that splits, so scale with the number of threads. Workers that
+// already exist are also used to run the other subtasks side by side, but
+// no worker is created just for them.
+static uint cleanup_workers_needed(WorkGang* workers) {
+  const uint threads_per_worker = 64;
+  uint needed = MAX2((uint)Threads::number_of_threads() / threads_per_worker, 1u);
+  needed = MAX2(needed, MIN2((uint)SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS,
+                             workers->created_workers()));
+  return MIN2(needed, workers->total_workers());
+}
+
 // Various cleaning tasks that should be done periodically at safepoints.
 void SafepointSynchronize::do_cleanup_tasks() {
 
   TraceTime timer("safepoint cleanup tasks", TRACETIME_LOG(Info, safepoint, cleanup));
+  ResourceMark rm;
 
   // Prepare for monitor deflation.
   DeflateMonitorCounters deflate_counters;
@@ -739,16 +794,23 @@ void SafepointSynchronize::do_cleanup_tasks() {
   assert(heap != NULL, "heap not initialized yet?");
   WorkGang* cleanup_workers = heap->get_safepoint_workers();
   if (cleanup_workers != NULL) {
-    // Parallel cleanup using GC provided thread pool.
-    uint num_cleanup_workers = cleanup_workers->active_workers();
+    // Parallel cleanup using GC provided thread pool. Do not go by the
+    // gang's active workers; the GC may have scaled those down for its own
+    // phases. Only run as many tasks as there are workers, since creating
+    // the missing ones may fail, and restore the GC's setting afterwards.
+    uint gc_active_workers = cleanup_workers->active_workers();
+    uint num_cleanup_workers = cleanup_workers->update_active_workers(cleanup_workers_needed(cleanup_workers));
     ParallelSPCleanupTask cleanup(num_cleanup_workers, &deflate_counters);
     StrongRootsScope srs(num_cleanup_workers);
-    cleanup_workers->run_task(&cleanup);
+    cleanup_workers->run_task(&cleanup, num_cleanup_workers);
+    cleanup.log_thread_pass();
+    cleanup_workers->update_active_workers(gc_active_workers);
   } else {
     // Serial cleanup using VMThread.
     ParallelSPCleanupTask cleanup(1, &deflate_counters);
     StrongRootsScope srs(1);
     cleanup.work(0);
+    cleanup.log_thread_pass();
   }
 
   // Finish monitor deflation.
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "code/codeBlob.hpp"
+#include "code/codeCache.hpp"
+#include "code/compiledMethod.hpp"
+#include "code/pcDesc.hpp"
+#include "code/scopeDesc.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/safepointSyncProfiler.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
+
+unsigned safepoint_sync_location_hash(const char* const& location) {
+  unsigned hash = 0;
+  for (const char* p = location; *p != '\0'; p++) {
+    hash = 31 * hash + (unsigned char)*p;
+  }
+  return hash;
+}
+
+bool safepoint_sync_location_equals(const char* const& a, const char* const& b) {
+  return strcmp(a, b) == 0;
+}
+
+// Sample counts per location. Keys are C-heap copies owned by the table.
+typedef ResourceHashtable<const char*, uint64_t,
+                          safepoint_sync_location_hash, safepoint_sync_location_equals,
+                          1024, ResourceObj::C_HEAP, mtInternal> LocationTable;
+
+// All below are protected by SafepointSyncProfile_lock.
+static LocationTable* _locations = NULL;
+static int            _num_locations = 0;
+static uint64_t       _num_samples = 0;
+static uint64_t       _num_dropped = 0;    // samples beyond MaxLocations
+
+static const int MaxLocations = 4096;
+
+// Captures the top frame of a thread that runs Java code. The thread is
+// suspended while do_task() runs, so only read its stack here; anything
+// that may allocate is done after it has been resumed.
+class SafepointSyncSampler : public os::SuspendedThreadTask {
+  Method* _method;   // interpreted frame
+  int     _bci;
+  address _pc;       // other frames
+ public:
+  SafepointSyncSampler(JavaThread* thread) :
+    os::SuspendedThreadTask(thread), _method(NULL), _bci(-1), _pc(NULL) {}
+
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    JavaThread* jt = (JavaThread*)context.thread();
+    if (jt->thread_state() != _thread_in_Java) {
+      return;
+    }
+    frame fr;
+    if (!jt->pd_get_top_frame_for_profiling(&fr, context.ucontext(), true)) {
+      return;
+    }
+    if (fr.is_interpreted_frame()) {
+      _method = fr.interpreter_frame_method();
+      _bci = _method->validate_bci_from_bcp(fr.interpreter_frame_bcp());
+    } else {
+      _pc = fr.pc();
+    }
+  }
+
+  Method* method() const { return _method; }
+  int bci() const        { return _bci; }
+  address pc() const     { return _pc; }
+};
+
+static void record(const char* location) {
+  MutexLockerEx ml(SafepointSyncProfile_lock, Mutex::_no_safepoint_check_flag);
+  if (_locations == NULL) {
+    _locations = new (ResourceObj::C_HEAP, mtInternal) LocationTable();
+  }
+  _num_samples++;
+  uint64_t* count = _locations->get(location);
+  if (count != NULL) {
+    (*count)++;
+  } else if (_num_locations < MaxLocations) {
+    _locations->put(os::strdup(location, mtInternal), 1);
+    _num_locations++;
+  } else {
+    _num_dropped++;
+  }
+}
+
+// Find the Java method and bci a running thread is at, or describe
+// where it is instead. Returns a resource allocated string.
+static const char* locate(JavaThread* jt, Method** method, int* bci) {
+  JavaThreadState state = jt->thread_state();
+  if (state != _thread_in_Java) {
+    // In the VM or in a transition; there is no stable frame to look at.
+    stringStream ss;
+    ss.print("thread state %s", _get_thread_state_name(state));
+    return ss.as_string();
+  }
+
+  SafepointSyncSampler sampler(jt);
+  sampler.run();
+
+  stringStream ss;
+  if (sampler.method() != NULL) {
+    *method = sampler.method();
+    *bci = sampler.bci();
+    ss.print("%s @ %d (interpreted)", sampler.method()->name_and_sig_as_C_string(), sampler.bci());
+  } else if (sampler.pc() != NULL) {
+    // Keep the sweeper from flushing the blob while we decode it.
+    MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CodeBlob* cb = CodeCache::find_blob_unsafe(sampler.pc());
+    CompiledMethod* cm = (cb != NULL) ? cb->as_compiled_method_or_null() : NULL;
+    if (cm != NULL && cm->is_alive() && cm->pc_desc_near(sampler.pc()) != NULL) {
+      // The nearest debug info past the pc. A thread looping without
+      // safepoint polls is reported at the end of that loop.
+      ScopeDesc* sd = cm->scope_desc_near(sampler.pc());
+      *method = sd->method();
+      *bci = sd->bci();
+      ss.print("%s @ %d (compiled, level %d)", sd->method()->name_and_sig_as_C_string(),
+               sd->bci(), cm->comp_level());
+    } else if (cb != NULL) {
+      ss.print("code blob %s", cb->name());
+    } else {
+      ss.print("unknown code");
+    }
+  } else {
+    ss.print("Java code, frame not walkable");
+  }
+  return ss.as_string();
+}
+
+void SafepointSyncProfiler::sample_running_threads(ThreadsList* list) {
+  assert(Thread::current()->is_VM_thread(), "only the VM thread synchronizes safepoints");
+  // Suspending threads is serialized with the JFR sampler by Threads_lock.
+  assert(Threads_lock->owned_by_self(), "must hold Threads_lock");
+  ResourceMark rm;
+  for (uint i = 0; i < list->length(); i++) {
+    JavaThread* jt = list->thread_at(i);
+    if (!jt->safepoint_state()->is_running()) {
+      continue;
+    }
+
+    Method* method = NULL;
+    int bci = -1;
+    const char* location = locate(jt, &method, &bci);
+    record(location);
+
+    log_debug(safepoint)("Safepoint sync sample: %s at %s", jt->get_thread_name(), location);
+
+    EventSafepointSyncSample event;
+    if (event.should_commit()) {
+      // The counter is bumped once synchronization is done.
+      event.set_safepointId(SafepointSynchronize::safepoint_counter() + 1);
+      event.set_sampledThread(JFR_THREAD_ID(jt));
+      event.set_method(method);
+      event.set_bci(bci);
+      event.set_location(location);
+      event.commit();
+    }
+  }
+}
+
+class SortedLocation {
+ public:
+  const char* _location;
+  uint64_t    _count;
+  SortedLocation() : _location(NULL), _count(0) {}
+  SortedLocation(const char* location, uint64_t count) : _location(location), _count(count) {}
+};
+
+static int compare_by_count(SortedLocation* a, SortedLocation* b) {
+  if (a->_count != b->_count) {
+    return a->_count > b->_count ? -1 : 1;
+  }
+  return strcmp(a->_location, b->_location);
+}
+
+class CollectLocations : public StackObj {
+  GrowableArray<SortedLocation>* _array;
+ public:
+  CollectLocations(GrowableArray<SortedLocation>* array) : _array(array) {}
+  bool do_entry(const char* const& location, const uint64_t& count) {
+    _array->append(SortedLocation(location, count));
+    return true;
+  }
+};
+
+class FreeLocations : public StackObj {
+ public:
+  bool do_entry(const char* const& location, const uint64_t& count) {
+    os::free((void*)location);
+    return true;
+  }
+};
+
+void SafepointSyncProfiler::print_on(outputStream* st, bool reset) {
+  ResourceMark rm;
+  MutexLockerEx ml(SafepointSyncProfile_lock, Mutex::_no_safepoint_check_flag);
+  if (SafepointSyncProfileInterval == 0) {
+    st->print_cr("Safepoint sync profiling is disabled, see -XX:SafepointSyncProfileInterval");
+  }
+  st->print_cr("Samples of threads delaying safepoint synchronization: " UINT64_FORMAT, _num_samples);
+  if (_locations != NULL) {
+    GrowableArray<SortedLocation> sorted(_num_locations);
+    CollectLocations collect(&sorted);
+    _locations->iterate(&collect);
+    sorted.sort(compare_by_count);
+    for (int i = 0; i < sorted.length(); i++) {
+      st->print_cr(UINT64_FORMAT_W(10) "  %s", sorted.at(i)._count, sorted.at(i)._location);
+    }
+  }
+  if (_num_dropped > 0) {
+    st->print_cr(UINT64_FORMAT_W(10) "  (other locations)", _num_dropped);
+  }
+
+  if (reset && _locations != NULL) {
+    FreeLocations free_locations;
+    _locations->iterate(&free_locations);
+    delete _locations;
+    _locations = NULL;
+    _num_locations = 0;
+    _num_samples = 0;
+    _num_dropped = 0;
+  }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_SAFEPOINTSYNCPROFILER_HPP
+#define SHARE_VM_RUNTIME_SAFEPOINTSYNCPROFILER_HPP
+
+#include "memory/allocation.hpp"
+
+class outputStream;
+class ThreadsList;
+
+// Time-to-safepoint profiler (-XX:SafepointSyncProfileInterval).
+//
+// While SafepointSynchronize::begin() waits for threads to reach the
+// safepoint, it periodically samples where the threads that are still
+// running are: the Java method and bci for interpreted and compiled code
+// (for compiled code, the nearest debug info, typically the end of a
+// counted loop without a safepoint poll), the stub name for other code
+// blobs, or the thread state otherwise.
+//
+// Samples are posted as SafepointSyncSample JFR events and counted per
+// location for the VM.safepoint_sync_profile diagnostic command.
+class SafepointSyncProfiler : AllStatic {
+ public:
+  // Sample the threads in list that have not reached the safepoint yet.
+  // Called by the VM thread during safepoint synchronization.
+  static void sample_running_threads(ThreadsList* list);
+
+  // Print the locations sampled so far, most frequent first.
+  static void print_on(outputStream* st, bool reset);
+};
+
+#endif // SHARE_VM_RUNTIME_SAFEPOINTSYNCPROFILER_HPP
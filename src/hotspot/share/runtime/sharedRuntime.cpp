@@ -35,6 +35,7 @@
 #include "code/vtableStubs.hpp"
 #include "compiler/abstractCompiler.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/compilerOracle.hpp"
 #include "compiler/disassembler.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/gcLocker.inline.hpp"
@@ -65,6 +66,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/timerTrace.hpp"
 #include "runtime/vframe.inline.hpp"
 #include "runtime/vframeArray.hpp"
 #include "utilities/copy.hpp"
@@ -2611,6 +2613,35 @@ AdapterHandlerEntry* AdapterHandlerLibrary::get_adapter(const methodHandle& meth
   return entry;
 }
 
+#if INCLUDE_CDS
+// Generate the adapters for all signatures used by archived methods, and fill in
+// their shared trampolines, once StubRoutines::code2() exists; adapters
+// generated before that lack the VerifyAdapterCalls checks and are not
+// registered. Shared methods linked afterwards find their adapter already set
+// in Method::link_method() and never take AdapterHandlerLibrary_lock or run
+// the assembler. The few linked earlier get theirs the usual way, and the
+// batch then finds those adapters in the table.
+void AdapterHandlerLibrary::link_shared_adapters() {
+  Array<Method*>* methods = MetaspaceShared::adapter_methods();
+  if (!UseSharedSpaces || !LinkSharedAdaptersAtStartup || methods == NULL) {
+    return;
+  }
+  assert(StubRoutines::code2() != NULL, "adapters must contain all checks");
+  TraceTime timer("Shared adapters", TRACETIME_LOG(Info, startuptime));
+  Thread* thread = Thread::current();
+  int linked = 0;
+  for (; linked < methods->length(); linked++) {
+    methodHandle mh(thread, methods->at(linked));
+    if (get_adapter(mh) == NULL) {
+      // Out of CodeCache space. The remaining shared methods generate their
+      // adapters when they are linked, which reports the failure.
+      break;
+    }
+  }
+  log_info(cds)("Linked %d of %d shared adapters", linked, methods->length());
+}
+#endif // INCLUDE_CDS
+
 AdapterHandlerEntry* AdapterHandlerLibrary::get_adapter0(const methodHandle& method) {
   // Use customized signature handler.  Need to lock around updates to
   // the AdapterHandlerTable (it is not safe for concurrent readers
@@ -2806,6 +2837,33 @@ bool AdapterHandlerEntry::compare_code(unsigned char* buffer, int length) {
 #endif
 
 
+// A leaf native is called with the thread still in _thread_in_Java: the
+// wrapper skips the transition to native and back, the safepoint and
+// suspend checks on return, and so the thread cannot reach a safepoint
+// until the native returns. Such a native must be short, must not block
+// and must not use its JNIEnv or touch Java objects. Natives that need
+// the monitor or handle slow paths are never called this way.
+bool SharedRuntime::is_leaf_native(const methodHandle& method) {
+  if (method->is_method_handle_intrinsic() || method->is_synchronized()) {
+    return false;
+  }
+  BasicType ret_type = method->result_type();
+  if (ret_type == T_OBJECT || ret_type == T_ARRAY) {
+    return false;
+  }
+  return CompilerOracle::should_use_leaf_transition(method);
+}
+
+// The JNI functions change the thread state to _thread_in_vm and back to
+// _thread_in_native, so a leaf native that called back through its JNIEnv
+// returns in _thread_in_native. Continuing in Java code in that state
+// would let a safepoint run while the thread mutates oops.
+void SharedRuntime::leaf_native_state_error(JavaThread* thread, Method* method) {
+  ResourceMark rm;
+  fatal("Leaf native %s returned in thread state %d, leaf natives must not use their JNIEnv",
+        method->name_and_sig_as_C_string(), thread->thread_state());
+}
+
 /**
  * Create a native wrapper for this native method.  The wrapper converts the
  * Java-compiled calling convention to the native convention, handles
@@ -492,6 +492,13 @@ class SharedRuntime: AllStatic {
   // Block before entering a JNI critical method
   static void block_for_jni_critical(JavaThread* thread);
 
+  // True if the native wrapper should call method without leaving
+  // _thread_in_Java (-XX:CompileCommand=leafnative,<pattern>)
+  static bool is_leaf_native(const methodHandle& method);
+  // Called by the native wrapper when a leaf native did not return in
+  // _thread_in_Java because it called back through its JNIEnv
+  static void leaf_native_state_error(JavaThread* thread, Method* method);
+
 #if INCLUDE_SHENANDOAHGC
   // Pin/Unpin object
   static oopDesc* pin_object(JavaThread* thread, oopDesc* obj);
@@ -716,6 +723,7 @@ class AdapterHandlerLibrary: public AllStatic {
                                         address i2c_entry, address c2i_entry, address c2i_unverified_entry);
   static void create_native_wrapper(const methodHandle& method);
   static AdapterHandlerEntry* get_adapter(const methodHandle& method);
+  static void link_shared_adapters() NOT_CDS_RETURN;
 
   static void print_handler(const CodeBlob* b) { print_handler_on(tty, b); }
   static void print_handler_on(outputStream* st, const CodeBlob* b);
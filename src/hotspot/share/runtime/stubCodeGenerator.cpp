@@ -29,6 +29,7 @@
 #include "compiler/disassembler.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/forte.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 
 
@@ -37,8 +38,23 @@
 StubCodeDesc* StubCodeDesc::_list = NULL;
 bool          StubCodeDesc::_frozen = false;
 
+StubCodeDesc::StubCodeDesc(const char* group, const char* name, address begin, address end) {
+  assert(!_frozen, "no modifications allowed");
+  assert(name != NULL, "no name specified");
+  _next           = _list;
+  _group          = group;
+  _name           = name;
+  _begin          = begin;
+  _end            = end;
+  OrderAccess::release_store(&_list, this);
+}
+
+StubCodeDesc* StubCodeDesc::first() {
+  return OrderAccess::load_acquire(&_list);
+}
+
 StubCodeDesc* StubCodeDesc::desc_for(address pc) {
-  StubCodeDesc* p = _list;
+  StubCodeDesc* p = first();
   while (p != NULL && !p->contains(pc)) {
     p = p->_next;
   }
@@ -56,6 +72,11 @@ void StubCodeDesc::freeze() {
   _frozen = true;
 }
 
+void StubCodeDesc::unfreeze() {
+  assert(_frozen, "repeated unfreeze operation");
+  _frozen = false;
+}
+
 void StubCodeDesc::print_on(outputStream* st) const {
   st->print("%s", group());
   st->print("::");
@@ -62,24 +62,19 @@ class StubCodeDesc: public CHeapObj<mtCode> {
   friend class StubCodeGenerator;
 
  public:
-  static StubCodeDesc* first() { return _list; }
+  static StubCodeDesc* first();
   static StubCodeDesc* next(StubCodeDesc* desc)  { return desc->_next; }
 
   static StubCodeDesc* desc_for(address pc);     // returns the code descriptor for the code containing pc or NULL
   static const char*   name_for(address pc);     // returns the name of the code containing pc or NULL
 
-  StubCodeDesc(const char* group, const char* name, address begin, address end = NULL) {
-    assert(!_frozen, "no modifications allowed");
-    assert(name != NULL, "no name specified");
-    _next           = _list;
-    _group          = group;
-    _name           = name;
-    _begin          = begin;
-    _end            = end;
-    _list           = this;
-  };
+  StubCodeDesc(const char* group, const char* name, address begin, address end = NULL);
 
   static void freeze();
+  // Allows the stubs that a compiler thread generates after startup to be
+  // registered. The descriptors are published with release semantics so
+  // that concurrent readers of the list see them fully initialized.
+  static void unfreeze();
 
   const char* group() const                      { return _group; }
   const char* name() const                       { return _name; }
@@ -30,6 +30,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "utilities/align.hpp"
 #include "utilities/copy.hpp"
@@ -46,6 +47,7 @@
 
 BufferBlob* StubRoutines::_code1                                = NULL;
 BufferBlob* StubRoutines::_code2                                = NULL;
+BufferBlob* StubRoutines::_code3                                = NULL;
 
 address StubRoutines::_call_stub_return_address                 = NULL;
 address StubRoutines::_call_stub_entry                          = NULL;
@@ -182,8 +184,13 @@ address StubRoutines::_safefetchN_continuation_pc        = NULL;
 // Note: to break cycle with universe initialization, stubs are generated in two phases.
 // The first one generates stubs needed during universe init (e.g., _handle_must_compile_first_entry).
 // The second phase includes all other stubs (which may depend on universe being initialized.)
+// With DelayCompilerStubsGeneration, the intrinsic stubs that only C2 calls are left out of
+// the second phase and generated by the first C2 compiler thread, off the startup path.
 
 extern void StubGenerator_generate(CodeBuffer* code, bool all); // only interface to generators
+#if defined(AMD64) && defined(COMPILER2)
+extern void StubGenerator_generate_compiler_stubs(CodeBuffer* code);
+#endif
 
 void StubRoutines::initialize1() {
   if (_code1 == NULL) {
@@ -372,6 +379,28 @@ void StubRoutines::initialize2() {
 #endif
 }
 
+void StubRoutines::initialize_compiler_stubs() {
+#if defined(AMD64) && defined(COMPILER2)
+  if (DelayCompilerStubsGeneration && _code3 == NULL) {
+    ResourceMark rm;
+    TraceTime timer("StubRoutines generation 3", TRACETIME_LOG(Info, startuptime));
+    // The delayed stubs are a subset of what the second phase generates when
+    // nothing is delayed, so code_size2 is always large enough.
+    _code3 = BufferBlob::create("StubRoutines (3)", code_size2);
+    if (_code3 == NULL) {
+      vm_exit_out_of_memory(code_size2, OOM_MALLOC_ERROR, "CodeCache: no room for StubRoutines (3)");
+    }
+    CodeBuffer buffer(_code3);
+    // The stub list was frozen at the end of startup. Only this thread adds
+    // to it now, and the new descriptors are published safely for threads
+    // that look up stub names concurrently.
+    StubCodeDesc::unfreeze();
+    StubGenerator_generate_compiler_stubs(&buffer);
+    StubCodeDesc::freeze();
+    assert(buffer.insts_remaining() > 200, "increase code_size2");
+  }
+#endif
+}
 
 void stubRoutines_init1() { StubRoutines::initialize1(); }
 void stubRoutines_init2() { StubRoutines::initialize2(); }
@@ -122,6 +122,7 @@ class StubRoutines: AllStatic {
 
   static BufferBlob* _code1;                               // code buffer for initial routines
   static BufferBlob* _code2;                               // code buffer for all other routines
+  static BufferBlob* _code3;                               // code buffer for delayed compiler intrinsic routines
 
   // Leaf routines which implement arraycopy and their addresses
   // arraycopy operands aligned on element type boundary
@@ -233,17 +234,20 @@ class StubRoutines: AllStatic {
   // Initialization/Testing
   static void    initialize1();                            // must happen before universe::genesis
   static void    initialize2();                            // must happen after  universe::genesis
+  static void    initialize_compiler_stubs();              // called by the first C2 compiler thread
 
   static bool is_stub_code(address addr)                   { return contains(addr); }
 
   static bool contains(address addr) {
     return
       (_code1 != NULL && _code1->blob_contains(addr)) ||
-      (_code2 != NULL && _code2->blob_contains(addr)) ;
+      (_code2 != NULL && _code2->blob_contains(addr)) ||
+      (_code3 != NULL && _code3->blob_contains(addr)) ;
   }
 
   static RuntimeBlob* code1() { return _code1; }
   static RuntimeBlob* code2() { return _code2; }
+  static RuntimeBlob* code3() { return _code3; }
 
   // Debugging
   static jint    verify_oop_count()                        { return _verify_oop_count; }
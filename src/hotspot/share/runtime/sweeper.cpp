@@ -138,7 +138,37 @@ void NMethodSweeper::init_sweeper_log() {
 #define SWEEP(nm)
 #endif
 
-CompiledMethodIterator NMethodSweeper::_current;               // Current compiled method
+// Progress of the current sweep in one code heap. '_next' is the next compiled
+// method of the heap that has not been claimed by a sweeper thread yet, or NULL
+// once the whole heap has been claimed.
+struct SweepCursor {
+  CodeHeap*       _heap;
+  CompiledMethod* _next;
+};
+
+// Work done by one sweeper thread during a sweep
+struct SweepCounts {
+  int _swept;
+  int _flushed;
+  int _flushed_c2;
+  int _zombified;
+  int _freed_memory;
+
+  SweepCounts() : _swept(0), _flushed(0), _flushed_c2(0), _zombified(0), _freed_memory(0) {}
+
+  void add(const SweepCounts& other) {
+    _swept        += other._swept;
+    _flushed      += other._flushed;
+    _flushed_c2   += other._flushed_c2;
+    _zombified    += other._zombified;
+    _freed_memory += other._freed_memory;
+  }
+};
+
+SweepCursor* NMethodSweeper::_cursors                  = NULL; // Per code heap progress of the current sweep
+int      NMethodSweeper::_cursor_count                 = 0;    // Number of entries in _cursors
+int      NMethodSweeper::_chunks_in_progress           = 0;    // Nof. claimed chunks that are not processed yet
+Ticks    NMethodSweeper::_traversal_start;                     // Time of the stack scan that started the current pass
 long     NMethodSweeper::_traversals                   = 0;    // Stack scan count, also sweep ID.
 long     NMethodSweeper::_total_nof_code_cache_sweeps  = 0;    // Total number of full sweeps of the code cache
 long     NMethodSweeper::_time_counter                 = 0;    // Virtual time used to periodically invoke sweeper
@@ -151,6 +181,7 @@ volatile int  NMethodSweeper::_bytes_changed           = 0;    // Counts the tot
                                                                //   1) alive       -> not_entrant
                                                                //   2) not_entrant -> zombie
 int    NMethodSweeper::_hotness_counter_reset_val       = 0;
+jlong  NMethodSweeper::_last_hot_code_clustering        = 0;    // Time (in ms) of the last hot code clustering pass
 
 long   NMethodSweeper::_total_nof_methods_reclaimed     = 0;   // Accumulated nof methods flushed
 long   NMethodSweeper::_total_nof_c2_methods_reclaimed  = 0;   // Accumulated nof methods flushed
@@ -162,6 +193,18 @@ Tickspan NMethodSweeper::_peak_sweep_fraction_time;            // Peak time swee
 
 Monitor* NMethodSweeper::_stat_lock = new Monitor(Mutex::special, "Sweeper::Statistics", true, Monitor::_safepoint_check_sometimes);
 
+Monitor* NMethodSweeper::_helper_lock = new Monitor(Mutex::special, "Sweeper::Helpers", true, Monitor::_safepoint_check_never);
+volatile int NMethodSweeper::_started_threads          = 0;    // Nof. sweeper threads started, the first one is the primary
+int      NMethodSweeper::_registered_helpers           = 0;    // Nof. helper threads that are waiting for work
+int      NMethodSweeper::_active_helpers               = 0;    // Nof. helper threads still sweeping the current pass
+int      NMethodSweeper::_helper_sweep_id              = 0;    // Incremented for every sweep the helpers join
+SweepCounts* NMethodSweeper::_helper_counts            = NULL; // Accumulated counts of the helpers for the current sweep
+
+PerfCounter*  NMethodSweeper::_perf_swept_methods      = NULL;
+PerfCounter*  NMethodSweeper::_perf_flushed_bytes      = NULL;
+PerfCounter*  NMethodSweeper::_perf_sweep_time         = NULL;
+PerfVariable* NMethodSweeper::_perf_sweep_lag          = NULL;
+
 class MarkActivationClosure: public CodeBlobClosure {
 public:
   virtual void do_code_blob(CodeBlob* cb) {
@@ -193,8 +236,95 @@ int NMethodSweeper::hotness_counter_reset_val() {
   }
   return _hotness_counter_reset_val;
 }
+
+void NMethodSweeper::create_perf_counters(TRAPS) {
+  _perf_swept_methods = PerfDataManager::create_counter(SUN_CI, "sweptMethods",
+                                                        PerfData::U_Events, CHECK);
+  _perf_flushed_bytes = PerfDataManager::create_counter(SUN_CI, "sweepFlushedBytes",
+                                                        PerfData::U_Bytes, CHECK);
+  _perf_sweep_time    = PerfDataManager::create_counter(SUN_CI, "sweepTime",
+                                                        PerfData::U_Ticks, CHECK);
+  _perf_sweep_lag     = PerfDataManager::create_variable(SUN_CI, "sweepLag",
+                                                         PerfData::U_Ticks, CHECK);
+}
+
 bool NMethodSweeper::wait_for_stack_scanning() {
-  return _current.end();
+  // Claimed chunks must be processed before the next pass can start
+  return cursors_at_end() && _chunks_in_progress == 0;
+}
+
+/**
+ * Returns the first compiled method in 'heap' that follows 'cb',
+ * or the first compiled method of the heap if 'cb' is NULL.
+ */
+CompiledMethod* NMethodSweeper::next_compiled_method(CodeHeap* heap, CodeBlob* cb) {
+  cb = (cb == NULL) ? CodeCache::first_blob(heap) : CodeCache::next_blob(heap, cb);
+  while (cb != NULL && !cb->is_compiled()) {
+    cb = CodeCache::next_blob(heap, cb);
+  }
+  return (CompiledMethod*)cb;
+}
+
+static double heap_occupancy(CodeHeap* heap) {
+  return (double)heap->allocated_capacity() / (double)MAX2(heap->max_capacity(), (size_t)1);
+}
+
+/**
+ * Positions the cursors at the first compiled method of each code heap. The
+ * fullest heaps are swept first, since that is where reclaimed space is
+ * needed most.
+ */
+void NMethodSweeper::reset_cursors() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
+  const GrowableArray<CodeHeap*>* heaps = CodeCache::compiled_heaps();
+  if (_cursors == NULL || _cursor_count != heaps->length()) {
+    FREE_C_HEAP_ARRAY(SweepCursor, _cursors);
+    _cursor_count = heaps->length();
+    _cursors = NEW_C_HEAP_ARRAY(SweepCursor, _cursor_count, mtCode);
+  }
+  for (int i = 0; i < _cursor_count; i++) {
+    // Insertion sort by decreasing occupancy, there are only a few heaps
+    CodeHeap* heap = heaps->at(i);
+    double occupancy = heap_occupancy(heap);
+    int j = i;
+    for (; j > 0 && heap_occupancy(_cursors[j - 1]._heap) < occupancy; j--) {
+      _cursors[j] = _cursors[j - 1];
+    }
+    _cursors[j]._heap = heap;
+    _cursors[j]._next = next_compiled_method(heap, NULL);
+  }
+}
+
+bool NMethodSweeper::cursors_at_end() {
+  for (int i = 0; i < _cursor_count; i++) {
+    if (_cursors[i]._next != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Claims up to 'max_length' compiled methods for the calling sweeper thread.
+ * The cursors are advanced past the claimed methods while the CodeCache_lock
+ * is held, so that no other sweeper thread can see them. Returns the number
+ * of claimed compiled methods.
+ */
+int NMethodSweeper::claim_chunk(CompiledMethod** chunk, int max_length) {
+  assert_lock_strong(CodeCache_lock);
+  int length = 0;
+  for (int i = 0; i < _cursor_count && length < max_length; i++) {
+    SweepCursor* cursor = &_cursors[i];
+    while (cursor->_next != NULL && length < max_length) {
+      chunk[length++] = cursor->_next;
+      cursor->_next = next_compiled_method(cursor->_heap, cursor->_next);
+    }
+  }
+  if (length > 0) {
+    _chunks_in_progress++;
+    _seen += length;
+  }
+  return length;
 }
 
 /**
@@ -221,11 +351,15 @@ CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
   _time_counter++;
 
   // Check for restart
-  if (_current.method() != NULL) {
-    if (_current.method()->is_nmethod()) {
-      assert(CodeCache::find_blob_unsafe(_current.method()) == _current.method(), "Sweeper nmethod cached state invalid");
-    } else if (_current.method()->is_aot()) {
-      assert(CodeCache::find_blob_unsafe(_current.method()->code_begin()) == _current.method(), "Sweeper AOT method cached state invalid");
+  for (int i = 0; i < _cursor_count; i++) {
+    CompiledMethod* cm = _cursors[i]._next;
+    if (cm == NULL) {
+      continue;
+    }
+    if (cm->is_nmethod()) {
+      assert(CodeCache::find_blob_unsafe(cm) == cm, "Sweeper nmethod cached state invalid");
+    } else if (cm->is_aot()) {
+      assert(CodeCache::find_blob_unsafe(cm->code_begin()) == cm, "Sweeper AOT method cached state invalid");
     } else {
       ShouldNotReachHere();
     }
@@ -233,10 +367,9 @@ CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
 
   if (wait_for_stack_scanning()) {
     _seen = 0;
-    _current = CompiledMethodIterator();
-    // Initialize to first nmethod
-    _current.next();
+    reset_cursors();
     _traversals += 1;
+    _traversal_start = Ticks::now();
     _total_time_this_sweep = Tickspan();
 
     if (PrintMethodFlushing) {
@@ -265,18 +398,85 @@ void NMethodSweeper::do_stack_scanning() {
 }
 
 void NMethodSweeper::sweeper_loop() {
+  if (Atomic::add(1, &_started_threads) > 1) {
+    // Additional sweeper threads only help the primary one
+    sweeper_helper_loop();
+    return;
+  }
   bool timeout;
+  // With a hot code heap, wake up periodically to select hot methods for it
+  const long wait_time = CodeCache::heap_available(CodeBlobType::MethodHot) ?
+                         HotCodeClusteringInterval : 60*60*24 * 1000;
   while (true) {
     {
       ThreadBlockInVM tbivm(JavaThread::current());
       MutexLockerEx waiter(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-      const long wait_time = 60*60*24 * 1000;
       timeout = CodeCache_lock->wait(Mutex::_no_safepoint_check_flag, wait_time);
     }
     if (!timeout) {
       possibly_sweep();
     }
+    possibly_cluster_hot_code();
+  }
+}
+
+/**
+ * Loop of the helper sweeper threads. A helper waits until the primary sweeper
+ * thread starts a sweep, claims chunks of compiled methods until the code cache
+ * has been claimed completely, and reports its counts back to the primary.
+ */
+void NMethodSweeper::sweeper_helper_loop() {
+  JavaThread* thread = JavaThread::current();
+  int sweep_id;
+  {
+    MutexLockerEx ml(_helper_lock, Mutex::_no_safepoint_check_flag);
+    _registered_helpers++;
+    sweep_id = _helper_sweep_id;
+  }
+  while (true) {
+    {
+      ThreadBlockInVM tbivm(thread);
+      MonitorLockerEx ml(_helper_lock, Mutex::_no_safepoint_check_flag);
+      while (_helper_sweep_id == sweep_id) {
+        ml.wait(Mutex::_no_safepoint_check_flag);
+      }
+      sweep_id = _helper_sweep_id;
+    }
+    SweepCounts counts;
+    sweep_chunks(&counts);
+    {
+      MonitorLockerEx ml(_helper_lock, Mutex::_no_safepoint_check_flag);
+      _helper_counts->add(counts);
+      if (--_active_helpers == 0) {
+        ml.notify_all();
+      }
+    }
+  }
+}
+
+/**
+ * Wakes up the registered helper sweeper threads for the current sweep and
+ * returns their number.
+ */
+int NMethodSweeper::start_helpers(SweepCounts* helper_counts) {
+  MonitorLockerEx ml(_helper_lock, Mutex::_no_safepoint_check_flag);
+  assert(_active_helpers == 0, "previous sweep must be finished");
+  _active_helpers = _registered_helpers;
+  if (_active_helpers > 0) {
+    _helper_counts = helper_counts;
+    _helper_sweep_id++;
+    ml.notify_all();
   }
+  return _active_helpers;
+}
+
+void NMethodSweeper::wait_for_helpers() {
+  ThreadBlockInVM tbivm(JavaThread::current());
+  MonitorLockerEx ml(_helper_lock, Mutex::_no_safepoint_check_flag);
+  while (_active_helpers > 0) {
+    ml.wait(Mutex::_no_safepoint_check_flag);
+  }
+  _helper_counts = NULL;
 }
 
 /**
@@ -410,13 +610,109 @@ void NMethodSweeper::possibly_sweep() {
   }
 }
 
+struct HotCodeCandidate {
+  Method* _method;
+  int     _invocation_count;
+  int     _size;
+};
+
+static int compare_hot_code_candidates(HotCodeCandidate* a, HotCodeCandidate* b) {
+  // Sort by decreasing invocation count
+  if (a->_invocation_count > b->_invocation_count) return -1;
+  if (a->_invocation_count < b->_invocation_count) return 1;
+  return 0;
+}
+
+/**
+ * Clusters hot code for iTLB and instruction cache locality. Tier 4 nmethods
+ * end up scattered over the non-profiled code heap in allocation order. This
+ * pass ranks the methods with tier 4 code outside the hot code heap by their
+ * invocation counters and requests a recompilation for the hottest ones that
+ * still fit into the hot code heap. The new nmethod is allocated there (see
+ * nmethod::operator new) and replaces the old one when it is installed, which
+ * then gets flushed like any other not-entrant nmethod.
+ */
+void NMethodSweeper::possibly_cluster_hot_code() {
+  if (!CodeCache::heap_available(CodeBlobType::MethodHot) || !CompileBroker::should_compile_new_jobs()) {
+    return;
+  }
+  jlong now = os::javaTimeMillis();
+  if (now - _last_hot_code_clustering < HotCodeClusteringInterval) {
+    return;
+  }
+  _last_hot_code_clustering = now;
+
+  JavaThread* thread = JavaThread::current();
+  assert(thread->thread_state() == _thread_in_vm, "must run in vm mode");
+  assert(_active_helpers == 0, "no nmethods may be flushed concurrently");
+  ResourceMark rm(thread);
+  HandleMark hm(thread);
+  GrowableArray<HotCodeCandidate>* candidates = new GrowableArray<HotCodeCandidate>();
+  GrowableArray<Handle>* holders = new GrowableArray<Handle>();
+  size_t available;
+  {
+    MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    available = CodeCache::unallocated_capacity(CodeBlobType::MethodHot);
+    NMethodIterator iter;
+    while (iter.next_alive()) {
+      nmethod* nm = iter.method();
+      Method* m = nm->method();
+      if (m == NULL || !nm->is_in_use() || nm->is_osr_method() || nm->is_native_method() ||
+          nm->comp_level() != CompLevel_full_optimization || m->code() != nm ||
+          m->is_method_handle_intrinsic() || m->queued_for_compilation() ||
+          CodeCache::get_code_blob_type(nm) == CodeBlobType::MethodHot) {
+        continue;
+      }
+      int count = m->invocation_count();
+      if (count < Tier4InvocationThreshold) {
+        continue;
+      }
+      HotCodeCandidate c;
+      c._method = m;
+      c._invocation_count = count;
+      c._size = nm->size();
+      candidates->append(c);
+    }
+    candidates->sort(compare_hot_code_candidates);
+
+    // Keep the hottest candidates that fit into the hot code heap
+    int selected = 0;
+    for (int i = 0; i < candidates->length(); i++) {
+      HotCodeCandidate c = candidates->at(i);
+      if ((size_t)c._size > available) {
+        continue;
+      }
+      available -= c._size;
+      candidates->at_put(selected++, c);
+      // Keep the holder alive so that the method cannot be unloaded before the
+      // request is queued. The method itself cannot be deallocated by class
+      // redefinition while its nmethod is alive. Nmethods are only flushed
+      // during a sweep, and all sweeps are started by the primary sweeper
+      // thread, which also runs this pass, and end only after the helper
+      // threads are done (see wait_for_helpers()).
+      holders->append(Handle(thread, c._method->method_holder()->klass_holder()));
+    }
+    candidates->trunc_to(selected);
+  }
+
+  for (int i = 0; i < candidates->length(); i++) {
+    methodHandle mh(thread, candidates->at(i)._method);
+    CompileBroker::compile_hot_method(mh, thread);
+  }
+  log_debug(codecache, sweep)("Hot code clustering: requested %d recompilations, "
+                              SIZE_FORMAT "K left in hot code heap",
+                              candidates->length(), available / K);
+}
+
 static void post_sweep_event(EventSweepCodeCache* event,
                              const Ticks& start,
                              const Ticks& end,
                              s4 traversals,
                              int swept,
                              int flushed,
-                             int zombified) {
+                             int zombified,
+                             int workers,
+                             const Tickspan& lag) {
   assert(event != NULL, "invariant");
   assert(event->should_commit(), "invariant");
   event->set_starttime(start);
@@ -425,101 +721,131 @@ static void post_sweep_event(EventSweepCodeCache* event,
   event->set_sweptCount(swept);
   event->set_flushedCount(flushed);
   event->set_zombifiedCount(zombified);
+  event->set_workerCount(workers);
+  event->set_sweepLag(lag);
   event->commit();
 }
 
+void NMethodSweeper::sweep_compiled_method(CompiledMethod* cm, SweepCounts* counts) {
+  // Save information before potentially flushing the nmethod
+  // Only flushing nmethods so size only matters for them.
+  int size = cm->is_nmethod() ? ((nmethod*)cm)->total_size() : 0;
+  bool is_c2_method = cm->is_compiled_by_c2();
+  bool is_osr = cm->is_osr_method();
+  int compile_id = cm->compile_id();
+  intptr_t address = p2i(cm);
+  const char* state_before = cm->state();
+  const char* state_after = "";
+
+  counts->_swept++;
+  MethodStateChange type = process_compiled_method(cm);
+  switch (type) {
+    case Flushed:
+      state_after = "flushed";
+      counts->_freed_memory += size;
+      counts->_flushed++;
+      if (is_c2_method) {
+        counts->_flushed_c2++;
+      }
+      break;
+    case MadeZombie:
+      state_after = "made zombie";
+      counts->_zombified++;
+      break;
+    case None:
+      break;
+    default:
+     ShouldNotReachHere();
+  }
+  if (PrintMethodFlushing && Verbose && type != None) {
+    tty->print_cr("### %s nmethod %3d/" PTR_FORMAT " (%s) %s", is_osr ? "osr" : "", compile_id, address, state_before, state_after);
+  }
+}
+
+/**
+ * Claims and processes chunks of compiled methods until all cursors are at
+ * the end. Called by the primary and the helper sweeper threads.
+ */
+void NMethodSweeper::sweep_chunks(SweepCounts* counts) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "should not be in safepoint when we get here");
+  assert(!CodeCache_lock->owned_by_self(), "just checking");
+  ResourceMark rm;
+  const int max_length = (int)CodeCacheSweepChunkSize;
+  CompiledMethod** chunk = NEW_RESOURCE_ARRAY(CompiledMethod*, max_length);
+
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  int length;
+  while ((length = claim_chunk(chunk, max_length)) > 0) {
+    for (int i = 0; i < length; i++) {
+      // Now ready to process nmethod and give up CodeCache_lock. Other blobs
+      // can be deleted by other threads but nmethods are only reclaimed by
+      // the sweeper thread that claimed them.
+      {
+        MutexUnlockerEx mul(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+        sweep_compiled_method(chunk[i], counts);
+      }
+      handle_safepoint_request();
+    }
+    _chunks_in_progress--;
+  }
+}
+
 void NMethodSweeper::sweep_code_cache() {
   ResourceMark rm;
   Ticks sweep_start_counter = Ticks::now();
 
   log_debug(codecache, sweep, start)("CodeCache flushing");
 
-  int flushed_count                = 0;
-  int zombified_count              = 0;
-  int flushed_c2_count     = 0;
-
   if (PrintMethodFlushing && Verbose) {
     tty->print_cr("### Sweep at %d out of %d", _seen, CodeCache::nmethod_count());
   }
 
-  int swept_count = 0;
   assert(!SafepointSynchronize::is_at_safepoint(), "should not be in safepoint when we get here");
   assert(!CodeCache_lock->owned_by_self(), "just checking");
 
-  int freed_memory = 0;
-  {
-    MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  SweepCounts counts;
+  SweepCounts helper_counts;
+  const int workers = 1 + start_helpers(&helper_counts);
+  sweep_chunks(&counts);
+  wait_for_helpers();
+  counts.add(helper_counts);
 
-    while (!_current.end()) {
-      swept_count++;
-      // Since we will give up the CodeCache_lock, always skip ahead
-      // to the next nmethod.  Other blobs can be deleted by other
-      // threads but nmethods are only reclaimed by the sweeper.
-      CompiledMethod* nm = _current.method();
-      _current.next();
-
-      // Now ready to process nmethod and give up CodeCache_lock
-      {
-        MutexUnlockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-        // Save information before potentially flushing the nmethod
-        // Only flushing nmethods so size only matters for them.
-        int size = nm->is_nmethod() ? ((nmethod*)nm)->total_size() : 0;
-        bool is_c2_method = nm->is_compiled_by_c2();
-        bool is_osr = nm->is_osr_method();
-        int compile_id = nm->compile_id();
-        intptr_t address = p2i(nm);
-        const char* state_before = nm->state();
-        const char* state_after = "";
-
-        MethodStateChange type = process_compiled_method(nm);
-        switch (type) {
-          case Flushed:
-            state_after = "flushed";
-            freed_memory += size;
-            ++flushed_count;
-            if (is_c2_method) {
-              ++flushed_c2_count;
-            }
-            break;
-          case MadeZombie:
-            state_after = "made zombie";
-            ++zombified_count;
-            break;
-          case None:
-            break;
-          default:
-           ShouldNotReachHere();
-        }
-        if (PrintMethodFlushing && Verbose && type != None) {
-          tty->print_cr("### %s nmethod %3d/" PTR_FORMAT " (%s) %s", is_osr ? "osr" : "", compile_id, address, state_before, state_after);
-        }
-      }
-
-      _seen++;
-      handle_safepoint_request();
-    }
-  }
-
-  assert(_current.end(), "must have scanned the whole cache");
+  assert(wait_for_stack_scanning(), "must have scanned the whole cache");
 
   const Ticks sweep_end_counter = Ticks::now();
   const Tickspan sweep_time = sweep_end_counter - sweep_start_counter;
+  // Time the swept compiled methods waited since the stack scan of this pass
+  const Tickspan sweep_lag = counts._swept > 0 ? sweep_end_counter - _traversal_start : Tickspan();
+  const int freed_memory = counts._freed_memory;
   {
     MutexLockerEx mu(_stat_lock, Mutex::_no_safepoint_check_flag);
     _total_time_sweeping  += sweep_time;
     _total_time_this_sweep += sweep_time;
     _peak_sweep_fraction_time = MAX2(sweep_time, _peak_sweep_fraction_time);
     _total_flushed_size += freed_memory;
-    _total_nof_methods_reclaimed += flushed_count;
-    _total_nof_c2_methods_reclaimed += flushed_c2_count;
+    _total_nof_methods_reclaimed += counts._flushed;
+    _total_nof_c2_methods_reclaimed += counts._flushed_c2;
     _peak_sweep_time = MAX2(_peak_sweep_time, _total_time_this_sweep);
   }
 
+  if (UsePerfData) {
+    _perf_swept_methods->inc(counts._swept);
+    _perf_flushed_bytes->inc(freed_memory);
+    _perf_sweep_time->inc(sweep_time.value());
+    _perf_sweep_lag->set_value(sweep_lag.value());
+  }
+
   EventSweepCodeCache event(UNTIMED);
   if (event.should_commit()) {
-    post_sweep_event(&event, sweep_start_counter, sweep_end_counter, (s4)_traversals, swept_count, flushed_count, zombified_count);
+    post_sweep_event(&event, sweep_start_counter, sweep_end_counter, (s4)_traversals,
+                     counts._swept, counts._flushed, counts._zombified,
+                     workers, sweep_lag);
   }
 
+  log_debug(codecache, sweep)("Swept %d compiled methods (%d flushed, %d made zombie) in %.3fms, lag %.3fms",
+                              counts._swept, counts._flushed, counts._zombified,
+                              sweep_time.seconds() * MILLIUNITS, sweep_lag.seconds() * MILLIUNITS);
+
 #ifdef ASSERT
   if(PrintMethodFlushing) {
     tty->print_cr("### sweeper:      sweep time(" JLONG_FORMAT "): ", sweep_time.value());
@@ -28,9 +28,12 @@
 class WhiteBox;
 
 #include "code/codeCache.hpp"
+#include "runtime/perfData.hpp"
 #include "utilities/ticks.hpp"
 
 class CodeBlobClosure;
+struct SweepCounts;
+struct SweepCursor;
 
 // An NmethodSweeper is an incremental cleaner for:
 //    - cleanup inline caches
@@ -56,6 +59,11 @@ class CodeBlobClosure;
 //     cleared. After that, the nmethod can be evicted from the code cache. Each nmethod's
 //     state change happens during separate sweeps. It may take at least 3 sweeps before an
 //     nmethod's space is freed.
+//
+// Each code heap has its own progress cursor. The heaps are swept fullest first and
+// sweeper threads claim chunks of CodeCacheSweepChunkSize compiled methods at a time,
+// so that additional sweeper threads (CodeCacheSweeperThreads) can help the primary
+// sweeper thread with large code caches.
 
 class NMethodSweeper : public AllStatic {
  private:
@@ -68,8 +76,11 @@ class NMethodSweeper : public AllStatic {
   static long      _total_nof_code_cache_sweeps;  // Total number of full sweeps of the code cache
   static long      _time_counter;                 // Virtual time used to periodically invoke sweeper
   static long      _last_sweep;                   // Value of _time_counter when the last sweep happened
-  static CompiledMethodIterator _current;         // Current compiled method
+  static SweepCursor* _cursors;                  // Per code heap progress of the current sweep, fullest heap first
+  static int       _cursor_count;                 // Number of entries in _cursors
+  static int       _chunks_in_progress;           // Nof. claimed chunks that are not processed yet
   static int       _seen;                         // Nof. nmethod we have currently processed in current pass of CodeCache
+  static Ticks     _traversal_start;              // Time of the stack scan that started the current pass
 
   static volatile int  _sweep_started;            // Flag to control conc sweeper
   static volatile bool _should_sweep;             // Indicates if we should invoke the sweeper
@@ -82,6 +93,7 @@ class NMethodSweeper : public AllStatic {
   static long      _total_nof_c2_methods_reclaimed; // Accumulated nof C2-compiled methods flushed
   static size_t    _total_flushed_size;             // Total size of flushed methods
   static int       _hotness_counter_reset_val;
+  static jlong     _last_hot_code_clustering;       // Time (in ms) of the last hot code clustering pass
 
   static Tickspan  _total_time_sweeping;          // Accumulated time sweeping
   static Tickspan  _total_time_this_sweep;        // Total time this sweep
@@ -90,7 +102,31 @@ class NMethodSweeper : public AllStatic {
 
   static Monitor*  _stat_lock;
 
+  // Coordination of the helper sweeper threads
+  static Monitor*  _helper_lock;
+  static volatile int _started_threads;           // Nof. sweeper threads started, the first one is the primary
+  static int       _registered_helpers;           // Nof. helper threads that are waiting for work
+  static int       _active_helpers;               // Nof. helper threads still sweeping the current pass
+  static int       _helper_sweep_id;              // Incremented for every sweep the helpers join
+  static SweepCounts* _helper_counts;             // Accumulated counts of the helpers for the current sweep
+
+  // Performance counters
+  static PerfCounter*  _perf_swept_methods;
+  static PerfCounter*  _perf_flushed_bytes;
+  static PerfCounter*  _perf_sweep_time;
+  static PerfVariable* _perf_sweep_lag;
+
   static MethodStateChange process_compiled_method(CompiledMethod *nm);
+  static void sweep_compiled_method(CompiledMethod* cm, SweepCounts* counts);
+
+  static CompiledMethod* next_compiled_method(CodeHeap* heap, CodeBlob* cb);
+  static void reset_cursors();
+  static bool cursors_at_end();
+  static int  claim_chunk(CompiledMethod** chunk, int max_length);
+  static void sweep_chunks(SweepCounts* counts);
+  static int  start_helpers(SweepCounts* helper_counts);
+  static void wait_for_helpers();
+  static void sweeper_helper_loop();
 
   static void init_sweeper_log() NOT_DEBUG_RETURN;
   static bool wait_for_stack_scanning();
@@ -98,6 +134,7 @@ class NMethodSweeper : public AllStatic {
   static void handle_safepoint_request();
   static void do_stack_scanning();
   static void possibly_sweep();
+  static void possibly_cluster_hot_code();
  public:
   static long traversal_count()              { return _traversals; }
   static int  total_nof_methods_reclaimed()  { return _total_nof_methods_reclaimed; }
@@ -119,6 +156,7 @@ class NMethodSweeper : public AllStatic {
   static void sweeper_loop();
   static void notify(int code_blob_type);  // Possibly start the sweeper thread.
   static void force_sweep();
+  static void create_perf_counters(TRAPS);
 
   static int hotness_counter_reset_val();
   static void report_state_change(nmethod* nm);
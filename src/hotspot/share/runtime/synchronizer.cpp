@@ -35,6 +35,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
@@ -127,6 +128,9 @@ static volatile intptr_t gListLock = 0;      // protects global monitor lists
 static volatile int gMonitorFreeCount  = 0;  // # on gFreeList
 static volatile int gMonitorPopulation = 0;  // # Extant -- in circulation
 
+volatile bool ObjectSynchronizer::_async_deflation_requested = false;
+jlong ObjectSynchronizer::_last_async_deflation_time_ns = 0;
+
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
 
@@ -362,9 +366,15 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD,
-                              obj(),
-                              inflate_cause_monitor_enter)->enter(THREAD);
+  // An idle monitor may be deflated concurrently; inflate again if so.
+  for (;;) {
+    ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
+                                                         obj(),
+                                                         inflate_cause_monitor_enter);
+    if (monitor->enter(THREAD)) {
+      return;
+    }
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -409,11 +419,14 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
-                                                       obj(),
-                                                       inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  for (;;) {
+    ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
+                                                         obj(),
+                                                         inflate_cause_vm_internal);
+    if (monitor->reenter(recursion, THREAD)) {
+      return;
+    }
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -426,7 +439,12 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  for (;;) {
+    ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter);
+    if (monitor->enter(THREAD)) {
+      break;
+    }
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -941,7 +959,7 @@ void ObjectSynchronizer::monitors_iterate(MonitorClosure* closure) {
     for (int i = _BLOCKSIZE - 1; i > 0; i--) {
       ObjectMonitor* mid = (ObjectMonitor *)(block + i);
       oop object = (oop)mid->object();
-      if (object != NULL) {
+      if (object != NULL && !mid->is_being_async_deflated()) {
         closure->do_monitor(mid);
       }
     }
@@ -967,6 +985,10 @@ static bool monitors_used_above_threshold() {
 }
 
 bool ObjectSynchronizer::is_cleanup_needed() {
+  if (AsyncDeflateIdleMonitors) {
+    // The MonitorDeflationThread takes care of it.
+    return false;
+  }
   if (MonitorUsedDeflationThreshold > 0) {
     return monitors_used_above_threshold();
   }
@@ -1063,6 +1085,11 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // No safepoint needed, the MonitorDeflationThread picks this up.
+      ObjectSynchronizer::set_async_deflation_requested();
+      return;
+    }
     if (ObjectMonitor::Knob_Verbose) {
       tty->print_cr("INFO: Monitor scavenge - Induced STW @%s (%d)",
                     Whence, ForceMonitorScavenge) ;
@@ -1102,8 +1129,8 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
   // and list coherency traffic, but also tends to increase the
   // number of objectMonitors in circulation as well as the STW
   // scavenge costs.  As usual, we lean toward time in space-time
-  // tradeoffs.
-  const int MAXPRIVATE = 1024;
+  // tradeoffs.  See MonitorCacheSize.
+  const int MAXPRIVATE = MonitorCacheSize;
   for (;;) {
     ObjectMonitor * m;
 
@@ -1730,7 +1757,11 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
     // a separate pass. See deflate_thread_local_monitors().
 
     // For moribund threads, scan gOmInUseList
-    if (gOmInUseList) {
+    if (AsyncDeflateIdleMonitors) {
+      // Deflated by the MonitorDeflationThread, only count.
+      counters->nInCirculation += gOmInUseCount;
+      counters->nInuse += gOmInUseCount;
+    } else if (gOmInUseList) {
       counters->nInCirculation += gOmInUseCount;
       int deflated_count = deflate_monitor_list((ObjectMonitor **)&gOmInUseList, &freeHeadp, &freeTailp);
       gOmInUseCount -= deflated_count;
@@ -1796,7 +1827,10 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
   ForceMonitorScavenge = 0;    // Reset
 
   OM_PERFDATA_OP(Deflations, inc(counters->nScavenged));
-  OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+  if (!AsyncDeflateIdleMonitors) {
+    // Otherwise the safepoint does not see the thread-local lists.
+    OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+  }
 
   // TODO: Add objectMonitor leak detection.
   // Audit/inventory the objectMonitors -- make sure they're all accounted for.
@@ -1807,6 +1841,10 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   if (!MonitorInUseLists) return;
+  if (AsyncDeflateIdleMonitors && thread->is_Java_thread()) {
+    // Deflated by the MonitorDeflationThread using handshakes.
+    return;
+  }
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -1836,6 +1874,243 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
   Thread::muxRelease(&gListLock);
 }
 
+// Concurrent deflation of idle monitors (AsyncDeflateIdleMonitors)
+//
+// The MonitorDeflationThread deflates idle monitors while the mutators
+// keep running, so safepoint cleanup time no longer grows with the number
+// of monitors in circulation. Deflating a monitor takes three steps:
+//
+// 1. Claim it by installing DEFLATER_MARKER as its owner. A thread that
+//    enters the monitor in the meantime bumps _count and takes the marker
+//    over (ObjectMonitor::try_cancel_async_deflation()), which makes the
+//    deflation fail.
+// 2. Commit by swinging _count from 0 to -max_jint. A thread that bumps
+//    _count after that sees a non-positive value, restores the object's
+//    header itself and inflates again. The header carries a hash code by
+//    then, so it cannot change under a concurrent hashCode().
+// 3. Restore the header in the object.
+//
+// A deflated monitor can still be referenced by a thread that read the
+// object's mark before step 3, so it only goes back to the free list after
+// a second handshake with all threads.
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (_async_deflation_requested) {
+    return true;
+  }
+  if (MonitorUsedDeflationThreshold > 0 && monitors_used_above_threshold()) {
+    return true;
+  }
+  // Deflate as often as the safepoint cleanup would have.
+  return GuaranteedSafepointInterval > 0 &&
+         gMonitorPopulation > gMonitorFreeCount &&
+         os::javaTimeNanos() - _last_async_deflation_time_ns >
+           (jlong)GuaranteedSafepointInterval * NANOSECS_PER_MILLISEC;
+}
+
+// Deflate a single monitor if not in-use, concurrently with its users.
+// Return true if deflated, false if in-use
+bool ObjectSynchronizer::deflate_monitor_using_handshakes(ObjectMonitor* mid,
+                                                          ObjectMonitor** freeHeadp,
+                                                          ObjectMonitor** freeTailp) {
+  oop obj = (oop) mid->object();
+  if (obj == NULL || mid->is_busy()) {
+    return false;
+  }
+  if (Atomic::cmpxchg(DEFLATER_MARKER, &mid->_owner, (void*)NULL) != NULL) {
+    return false;
+  }
+
+  if (mid->_waiters == 0) {
+    // Make the header immutable before it goes back to the object.
+    markOop dmw = mid->header();
+    while (dmw->hash() == markOopDesc::no_hash) {
+      markOop hashed = dmw->copy_set_hash(get_next_hash(Thread::current(), obj));
+      markOop test = Atomic::cmpxchg(hashed, mid->header_addr(), dmw);
+      dmw = (test == dmw) ? hashed : test;
+    }
+    assert(dmw->is_neutral(), "invariant");
+
+    if (Atomic::cmpxchg(-max_jint, &mid->_count, (jint)0) == 0) {
+      TEVENT(deflate_idle_monitors - async scavenge);
+      if (log_is_enabled(Debug, monitorinflation)) {
+        if (obj->is_instance()) {
+          ResourceMark rm;
+          log_debug(monitorinflation)("Deflating object " INTPTR_FORMAT " , "
+                                      "mark " INTPTR_FORMAT " , type %s (async)",
+                                      p2i(obj), p2i(dmw),
+                                      obj->klass()->external_name());
+        }
+      }
+      mid->install_displaced_markword_in_object();
+
+      // Move the monitor to the working free list defined by freeHeadp,
+      // freeTailp. It keeps DEFLATER_MARKER as owner until it is recycled.
+      if (*freeHeadp == NULL) *freeHeadp = mid;
+      if (*freeTailp != NULL) {
+        ObjectMonitor * prevtail = *freeTailp;
+        assert(prevtail->FreeNext == NULL, "cleaned up deflated?");
+        prevtail->FreeNext = mid;
+      }
+      *freeTailp = mid;
+      return true;
+    }
+  }
+
+  // The monitor is in use after all, back out.
+  if (Atomic::cmpxchg((void*)NULL, &mid->_owner, DEFLATER_MARKER) != DEFLATER_MARKER) {
+    // An entering thread took the marker over and bumped _count once more
+    // on our behalf.
+    Atomic::dec(&mid->_count);
+  }
+  return false;
+}
+
+// Walk a given monitor list, and deflate idle monitors concurrently.
+// The caller makes sure the list itself is not modified concurrently.
+int ObjectSynchronizer::deflate_monitor_list_using_handshakes(ObjectMonitor** listHeadp,
+                                                              ObjectMonitor** freeHeadp,
+                                                              ObjectMonitor** freeTailp) {
+  ObjectMonitor* mid;
+  ObjectMonitor* next;
+  ObjectMonitor* cur_mid_in_use = NULL;
+  int deflated_count = 0;
+
+  for (mid = *listHeadp; mid != NULL;) {
+    if (deflate_monitor_using_handshakes(mid, freeHeadp, freeTailp)) {
+      if (mid == *listHeadp) {
+        *listHeadp = mid->FreeNext;
+      } else if (cur_mid_in_use != NULL) {
+        cur_mid_in_use->FreeNext = mid->FreeNext;
+      }
+      next = mid->FreeNext;
+      mid->FreeNext = NULL;  // This mid is current tail in the freeHeadp list
+      mid = next;
+      deflated_count++;
+    } else {
+      cur_mid_in_use = mid;
+      mid = mid->FreeNext;
+    }
+  }
+  return deflated_count;
+}
+
+// Deflates the in-use list of each thread it visits and collects the
+// deflated monitors, which are not reusable yet.
+class DeflateThreadLocalMonitorsClosure : public HandshakeClosure {
+  ObjectMonitor* _deflated_head;
+  ObjectMonitor* _deflated_tail;
+  int _in_circulation;
+  int _deflated;
+
+ public:
+  DeflateThreadLocalMonitorsClosure() :
+    HandshakeClosure("DeflateIdleMonitors"),
+    _deflated_head(NULL), _deflated_tail(NULL),
+    _in_circulation(0), _deflated(0) {}
+
+  ObjectMonitor* deflated_head() const { return _deflated_head; }
+  int in_circulation() const           { return _in_circulation; }
+  int deflated() const                 { return _deflated; }
+
+  // Caller holds gListLock.
+  void add(ObjectMonitor* head, ObjectMonitor* tail, int in_circulation, int deflated) {
+    _in_circulation += in_circulation;
+    if (head != NULL) {
+      assert(tail != NULL && tail->FreeNext == NULL, "invariant");
+      tail->FreeNext = _deflated_head;
+      _deflated_head = head;
+      if (_deflated_tail == NULL) _deflated_tail = tail;
+      _deflated += deflated;
+    }
+  }
+
+  void do_thread(Thread* thread) {
+    ObjectMonitor* freeHeadp = NULL;
+    ObjectMonitor* freeTailp = NULL;
+    int in_circulation = thread->omInUseCount;
+    int deflated_count =
+      ObjectSynchronizer::deflate_monitor_list_using_handshakes(thread->omInUseList_addr(),
+                                                                &freeHeadp, &freeTailp);
+    thread->omInUseCount -= deflated_count;
+    if (ObjectMonitor::Knob_VerifyInUse) {
+      ObjectSynchronizer::verifyInUse(thread);
+    }
+
+    Thread::muxAcquire(&gListLock, "async deflation");
+    add(freeHeadp, freeTailp, in_circulation, deflated_count);
+    Thread::muxRelease(&gListLock);
+  }
+};
+
+// A handshake that only makes sure no thread is still between reading an
+// object's mark and entering its (deflated) monitor.
+class DeflationSyncHandshakeClosure : public HandshakeClosure {
+ public:
+  DeflationSyncHandshakeClosure() : HandshakeClosure("DeflationSync") {}
+  void do_thread(Thread* thread) {}
+};
+
+void ObjectSynchronizer::deflate_idle_monitors_using_handshakes(JavaThread* self) {
+  assert(AsyncDeflateIdleMonitors && MonitorInUseLists, "invariant");
+  assert(self->thread_state() == _thread_in_vm, "invariant");
+  jlong start = os::javaTimeNanos();
+
+  // Deflate the lists of the live threads; each thread is stopped while
+  // its own list is processed, so the list does not change underneath.
+  DeflateThreadLocalMonitorsClosure deflate_cl;
+  Handshake::execute(&deflate_cl);
+
+  // Deflate the list of the moribund threads.
+  {
+    ObjectMonitor* freeHeadp = NULL;
+    ObjectMonitor* freeTailp = NULL;
+    Thread::muxAcquire(&gListLock, "async deflation");
+    int in_circulation = gOmInUseCount;
+    int deflated_count = deflate_monitor_list_using_handshakes((ObjectMonitor**)&gOmInUseList,
+                                                               &freeHeadp, &freeTailp);
+    gOmInUseCount -= deflated_count;
+    deflate_cl.add(freeHeadp, freeTailp, in_circulation, deflated_count);
+    Thread::muxRelease(&gListLock);
+  }
+
+  int deflated = deflate_cl.deflated();
+  if (deflated > 0) {
+    DeflationSyncHandshakeClosure sync_cl;
+    Handshake::execute(&sync_cl);
+
+    ObjectMonitor* tail = NULL;
+    for (ObjectMonitor* mid = deflate_cl.deflated_head(); mid != NULL; mid = mid->FreeNext) {
+      mid->clear_deflated();
+      mid->Recycle();
+      tail = mid;
+    }
+
+    Thread::muxAcquire(&gListLock, "async deflation");
+    tail->FreeNext = gFreeList;
+    gFreeList = deflate_cl.deflated_head();
+    gMonitorFreeCount += deflated;
+    Thread::muxRelease(&gListLock);
+  }
+
+  OM_PERFDATA_OP(Deflations, inc(deflated));
+  OM_PERFDATA_OP(MonExtant, set_value(deflate_cl.in_circulation()));
+
+  jlong end = os::javaTimeNanos();
+  log_info(monitorinflation)("Async deflation: InCirc=%d Scavenged=%d "
+                             "pop=%d free=%d, %.3f ms",
+                             deflate_cl.in_circulation(), deflated,
+                             gMonitorPopulation, gMonitorFreeCount,
+                             (double)(end - start) / NANOSECS_PER_MILLISEC);
+
+  _last_async_deflation_time_ns = end;
+  _async_deflation_requested = false;
+  ForceMonitorScavenge = 0;
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
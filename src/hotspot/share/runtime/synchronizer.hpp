@@ -148,6 +148,19 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** freeHeadp,
                               ObjectMonitor** freeTailp);
   static bool is_cleanup_needed();
+
+  // Deflation of idle monitors by the MonitorDeflationThread, concurrently
+  // with the mutators (AsyncDeflateIdleMonitors).
+  static bool is_async_deflation_needed();
+  static void set_async_deflation_requested()     { _async_deflation_requested = true; }
+  static void deflate_idle_monitors_using_handshakes(JavaThread* self);
+  static int  deflate_monitor_list_using_handshakes(ObjectMonitor** listheadp,
+                                                    ObjectMonitor** freeHeadp,
+                                                    ObjectMonitor** freeTailp);
+  static bool deflate_monitor_using_handshakes(ObjectMonitor* mid,
+                                               ObjectMonitor** freeHeadp,
+                                               ObjectMonitor** freeTailp);
+
   static void oops_do(OopClosure* f);
   // Process oops in thread local used monitors
   static void thread_local_used_oops_do(Thread* thread, OopClosure* f);
@@ -169,6 +182,10 @@ class ObjectSynchronizer : AllStatic {
   static ObjectMonitor * volatile gOmInUseList;
   // count of entries in gOmInUseList
   static int gOmInUseCount;
+  // set by MonitorBound and other triggers of an asynchronous deflation
+  static volatile bool _async_deflation_requested;
+  // time stamp of the last asynchronous deflation
+  static jlong _last_async_deflation_time_ns;
 
   // Process oops in all monitors
   static void global_oops_do(OopClosure* f);
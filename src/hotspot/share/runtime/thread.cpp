@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "ci/ciEnv.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
@@ -79,6 +80,7 @@
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/jniPeriodicChecker.hpp"
 #include "runtime/memprofiler.hpp"
+#include "runtime/monitorDeflationThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/orderAccess.hpp"
@@ -3394,6 +3396,12 @@ CompilerThread::CompilerThread(CompileQueue* queue,
   _counters = counters;
   _buffer_blob = NULL;
   _compiler = NULL;
+  _arena_bytes = 0;
+  _arena_peak = 0;
+  _arena_limit = 0;
+  _arena_limit_hit = false;
+  _chunk_cache = NULL;
+  _chunk_cache_count = 0;
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
@@ -3406,6 +3414,54 @@ CompilerThread::CompilerThread(CompileQueue* queue,
 CompilerThread::~CompilerThread() {
   // Delete objects which were allocated on heap.
   delete _counters;
+  release_cached_chunks();
+}
+
+void CompilerThread::arena_size_changed(ssize_t delta) {
+  _arena_bytes += delta;
+  if (_arena_bytes > 0 && (size_t)_arena_bytes > _arena_peak) {
+    _arena_peak = (size_t)_arena_bytes;
+    if (_arena_limit > 0 && _arena_peak > _arena_limit && !_arena_limit_hit && _env != NULL) {
+      // The compiler bails out at its next failure check. Only record the
+      // reason here since we may be in the middle of an arena allocation.
+      _arena_limit_hit = true;
+      _env->record_failure("hit arena memory limit");
+    }
+  }
+}
+
+void* CompilerThread::allocate_cached_chunk() {
+  Chunk* chunk = _chunk_cache;
+  if (chunk != NULL) {
+    _chunk_cache = chunk->next();
+    _chunk_cache_count--;
+  }
+  return chunk;
+}
+
+void CompilerThread::release_cached_chunks() {
+  if (_chunk_cache == NULL) {
+    return;
+  }
+  // Release the cached chunks directly, deleting them would cache them again
+  ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
+  while (_chunk_cache != NULL) {
+    Chunk* next = _chunk_cache->next();
+    os::free(_chunk_cache);
+    _chunk_cache = next;
+  }
+  _chunk_cache_count = 0;
+}
+
+bool CompilerThread::cache_chunk(Chunk* chunk) {
+  assert(chunk->length() == Chunk::size, "only default sized chunks are cached");
+  if ((_chunk_cache_count + 1) * (Chunk::size + Chunk::aligned_overhead_size()) > CompilerArenaPoolSize) {
+    return false;
+  }
+  chunk->set_next(_chunk_cache);
+  _chunk_cache = chunk;
+  _chunk_cache_count++;
+  return true;
 }
 
 bool CompilerThread::can_call_java() const {
@@ -3908,6 +3964,11 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // and other cleanups.  Needs to start before the compilers start posting events.
   ServiceThread::initialize();
 
+  // Start the thread that deflates idle monitors outside of safepoints.
+  if (AsyncDeflateIdleMonitors) {
+    MonitorDeflationThread::initialize();
+  }
+
   // initialize compiler(s)
 #if defined(COMPILER1) || COMPILER2_OR_JVMCI
 #if INCLUDE_JVMCI
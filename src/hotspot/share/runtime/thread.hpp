@@ -70,6 +70,7 @@ class ConcurrentLocksDump;
 class ParkEvent;
 class Parker;
 
+class Chunk;
 class ciEnv;
 class CompileThread;
 class CompileLog;
@@ -912,6 +913,8 @@ class CompilerThread;
 
 typedef void (*ThreadFunction)(JavaThread*, TRAPS);
 
+const char* _get_thread_state_name(JavaThreadState _thread_state);
+
 class JavaThread: public Thread {
   friend class VMStructs;
   friend class JVMCIVMStructs;
@@ -2088,6 +2091,16 @@ class CompilerThread : public JavaThread {
   AbstractCompiler*     _compiler;
   TimeStamp             _idle_time;
 
+  // Arena memory used by the current compilation, see Arena::set_size_in_bytes()
+  ssize_t               _arena_bytes;
+  size_t                _arena_peak;
+  size_t                _arena_limit;   // Bail out above this size, 0 means no limit
+  bool                  _arena_limit_hit;
+
+  // Arena chunks kept for reuse by the next compilations, see CompilerArenaPoolSize
+  Chunk*                _chunk_cache;
+  size_t                _chunk_cache_count;
+
  public:
 
   static CompilerThread* current();
@@ -2128,6 +2141,23 @@ class CompilerThread : public JavaThread {
     return TimeHelper::counter_to_millis(_idle_time.ticks_since_update());
   }
 
+  // Arena memory accounting of the current compilation
+  void   start_arena_accounting(size_t limit) {
+    _arena_bytes = 0;
+    _arena_peak = 0;
+    _arena_limit = limit;
+    _arena_limit_hit = false;
+  }
+  void   arena_size_changed(ssize_t delta);
+  size_t arena_peak() const                      { return _arena_peak; }
+  bool   arena_limit_hit() const                 { return _arena_limit_hit; }
+
+  // Cache of Chunk::size arena chunks
+  void*  allocate_cached_chunk();
+  bool   cache_chunk(Chunk* chunk);
+  // Frees the cached chunks, called when the thread has been idle for a while
+  void   release_cached_chunks();
+
 #ifndef PRODUCT
  private:
   IdealGraphPrinter *_ideal_graph_printer;
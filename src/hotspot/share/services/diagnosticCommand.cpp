@@ -40,6 +40,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepointSyncProfiler.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -108,6 +109,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SafepointSyncProfileDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
 
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesPrintDCmd>(full_export, true, false));
@@ -1107,3 +1109,24 @@ void DebugOnCmdStartDCmd::execute(DCmdSource source, TRAPS) {
   }
 }
 #endif // INCLUDE_JVMTI
+
+SafepointSyncProfileDCmd::SafepointSyncProfileDCmd(outputStream* output, bool heap) :
+                                       DCmdWithParser(output, heap),
+  _reset("-reset", "Clear the profile after printing it", "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void SafepointSyncProfileDCmd::execute(DCmdSource source, TRAPS) {
+  SafepointSyncProfiler::print_on(output(), _reset.value());
+}
+
+int SafepointSyncProfileDCmd::num_arguments() {
+  ResourceMark rm;
+  SafepointSyncProfileDCmd* dcmd = new SafepointSyncProfileDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
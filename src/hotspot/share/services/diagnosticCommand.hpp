@@ -442,6 +442,30 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class SafepointSyncProfileDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  SafepointSyncProfileDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "VM.safepoint_sync_profile";
+  }
+  static const char* description() {
+    return "Print where threads were found while they delayed safepoint synchronization "
+           "(see -XX:SafepointSyncProfileInterval).";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 // See also: thread_dump in attachListener.cpp
 class ThreadDumpDCmd : public DCmdWithParser {
 protected:
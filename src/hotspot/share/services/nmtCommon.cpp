@@ -32,6 +32,7 @@ const char* NMTUtil::_memory_type_names[] = {
   "Thread Stack",
   "Code",
   "GC",
+  "GC Card Set",
   "Compiler",
   "Internal",
   "Other",
@@ -1177,6 +1177,12 @@ void VMError::print_vm_info(outputStream* st) {
   os::print_os_info(st);
   st->cr();
 
+  // STEP("printing large page coverage")
+
+  // Not part of print_os_info(): reading smaps is neither async-signal-safe
+  // nor fast enough for error reporting.
+  os::print_large_page_coverage(st);
+
   // STEP("printing CPU info")
 
   os::print_cpu_info(st, buf, sizeof(buf));
@@ -33,3 +33,11 @@ TEST_VM(G1Analytics, is_initialized) {
   ASSERT_EQ(a.recent_avg_pause_time_ratio(), 0.0);
   ASSERT_EQ(a.last_pause_time_ratio(), 0.0);
 }
+
+TEST_VM(G1Analytics, dirtied_buffers_rate) {
+  G1Predictions p(0.888888);
+  G1Analytics a(&p);
+  ASSERT_EQ(a.predict_dirtied_buffers_rate_ms(), 0.0);
+  a.report_dirtied_buffers_rate_ms(2.0);
+  ASSERT_GT(a.predict_dirtied_buffers_rate_ms(), 0.0);
+}
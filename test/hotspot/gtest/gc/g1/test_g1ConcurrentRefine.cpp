@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/dirtyCardQueue.hpp"
+#include "gc/g1/g1ConcurrentRefine.hpp"
+#include "runtime/mutex.hpp"
+#include "unittest.hpp"
+
+TEST_VM(G1ConcurrentRefine, predicted_green_zone) {
+  // Within a factor of two of the current zone, the model is followed.
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(100, 5.0, 0.05, 10.0), 200u);
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(100, 5.0, 0.08, 10.0), 125u);
+  // Growth and shrinkage are limited to a factor of two per pause.
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(10, 5.0, 0.01, 10.0), 21u);
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(100, 0.5, 1.0, 1.0), 50u);
+  // The zone does not grow while update_rs exceeds its goal.
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(100, 20.0, 0.05, 10.0), 100u);
+  ASSERT_EQ(G1ConcurrentRefine::calc_predicted_green_zone(100, 20.0, 0.2, 10.0), 50u);
+}
+
+TEST_VM(G1ConcurrentRefine, wanted_threads) {
+  const uint max_threads = G1ConcurrentRefine::max_num_threads();
+  // At least one thread is always wanted.
+  ASSERT_EQ(G1ConcurrentRefine::calc_wanted_threads(0.1, 4, 0.0), 1u);
+  // 4 workers at 0.1ms per buffer: one thread refines a buffer in 0.4ms,
+  // so 5 buffers per ms take two threads.
+  ASSERT_EQ(G1ConcurrentRefine::calc_wanted_threads(0.1, 4, 5.0), MAX2(MIN2(2u, max_threads), 1u));
+  // Never more than there are refinement threads.
+  ASSERT_EQ(G1ConcurrentRefine::calc_wanted_threads(0.1, 4, 1.0e6), MAX2(max_threads, 1u));
+}
+
+TEST_VM(G1ConcurrentRefine, idle_notify) {
+  Monitor cbl_mon(Mutex::leaf, "TestCbl_mon", true, Monitor::_safepoint_check_never);
+  Mutex fl_lock(Mutex::leaf, "TestFl_lock", true, Monitor::_safepoint_check_never);
+  Mutex shared_lock(Mutex::leaf, "TestShared_lock", true, Monitor::_safepoint_check_never);
+
+  DirtyCardQueueSet dcqs(true /* notify_when_complete */);
+  dcqs.initialize(&cbl_mon, &fl_lock, 0 /* process_completed_threshold */,
+                  0 /* max_completed_queue */, &shared_lock, NULL);
+
+  // Without completed buffers neither a zero threshold nor an unbounded
+  // queue wakes the primary refinement thread.
+  ASSERT_EQ(dcqs.completed_buffers_num(), 0u);
+  dcqs.notify_if_necessary();
+  ASSERT_FALSE(dcqs.process_completed_buffers());
+
+  dcqs.set_max_completed_queue(10);
+  dcqs.notify_if_necessary();
+  ASSERT_FALSE(dcqs.process_completed_buffers());
+}
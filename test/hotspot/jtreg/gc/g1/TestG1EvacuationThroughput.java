@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestG1EvacuationThroughput
+ * @key gc
+ * @requires vm.gc.G1
+ * @summary Test that young GCs copy an object graph of small objects, object
+ *          arrays and primitive arrays intact, with each evacuation batch size.
+ * @library /test/lib
+ * @modules java.management
+ * @build sun.hotspot.WhiteBox
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseG1GC -Xms128m -Xmx128m -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -Xlog:gc TestG1EvacuationThroughput 4 16
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:G1EvacuationBatchSize=1
+ *                   -XX:+UseG1GC -Xms128m -Xmx128m -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -Xlog:gc TestG1EvacuationThroughput 4 16
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UnlockExperimentalVMOptions -XX:G1EvacuationBatchSize=16
+ *                   -XX:+UseG1GC -Xms128m -Xmx128m -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -Xlog:gc TestG1EvacuationThroughput 4 16
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryUsage;
+import java.util.ArrayDeque;
+import java.util.Map;
+import java.util.Random;
+
+import com.sun.management.GarbageCollectorMXBean;
+import com.sun.management.GcInfo;
+import sun.hotspot.WhiteBox;
+
+// Builds a graph of small objects, object arrays and primitive arrays in eden
+// and checks that it is intact after each of several young GCs, which first
+// copy it to the survivor spaces and then within them.  Also reports the
+// pause time per GB copied; run with more iterations and a larger graph (and
+// heap) to use it as a benchmark:
+//   TestG1EvacuationThroughput <iterations> <graph size in MB>
+public class TestG1EvacuationThroughput {
+    private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+    // Young GCs per graph.  Stays below MaxTenuringThreshold.
+    private static final int GCS_PER_GRAPH = 3;
+
+    static class Node {
+        Node next;
+        Object payload;
+        int value;
+    }
+
+    private static Object graph;
+
+    private static Object buildGraph(long bytes, Random random) {
+        Object[] roots = new Object[1024];
+        long allocated = 0;
+        int index = 0;
+        while (allocated < bytes) {
+            switch (random.nextInt(4)) {
+            case 0: {
+                // Linked list of small objects.
+                Node head = null;
+                for (int i = 0; i < 256; i++) {
+                    Node n = new Node();
+                    n.next = head;
+                    n.value = random.nextInt();
+                    head = n;
+                }
+                roots[index] = head;
+                allocated += 256 * 24;
+                break;
+            }
+            case 1: {
+                // Large object array, scanned in chunks.
+                Object[] array = new Object[4096];
+                for (int i = 0; i < array.length; i++) {
+                    Node n = new Node();
+                    n.value = random.nextInt();
+                    array[i] = n;
+                }
+                roots[index] = array;
+                allocated += 4096 * (4 + 24);
+                break;
+            }
+            case 2: {
+                // Primitive arrays of varying size, copied in bulk.
+                byte[] array = new byte[16 + random.nextInt(64 * 1024)];
+                random.nextBytes(array);
+                roots[index] = array;
+                allocated += array.length;
+                break;
+            }
+            default: {
+                Node n = new Node();
+                long[] payload = new long[1 + random.nextInt(1024)];
+                for (int i = 0; i < payload.length; i++) {
+                    payload[i] = random.nextLong();
+                }
+                n.payload = payload;
+                n.value = random.nextInt();
+                roots[index] = n;
+                allocated += 24 + payload.length * 8;
+                break;
+            }
+            }
+            index = (index + 1) % roots.length;
+            if (index == 0) {
+                Object[] next = new Object[1024];
+                next[0] = roots;
+                roots = next;
+                index = 1;
+            }
+        }
+        return roots;
+    }
+
+    // Walks the whole graph and combines every field and array element.
+    private static long checksum(Object root) {
+        long sum = 0;
+        long objects = 0;
+        ArrayDeque<Object> stack = new ArrayDeque<>();
+        stack.push(root);
+        while (!stack.isEmpty()) {
+            Object o = stack.pop();
+            objects++;
+            if (o instanceof Node) {
+                Node n = (Node)o;
+                sum = sum * 31 + n.value;
+                if (n.next != null) {
+                    stack.push(n.next);
+                }
+                if (n.payload != null) {
+                    stack.push(n.payload);
+                }
+            } else if (o instanceof Object[]) {
+                Object[] array = (Object[])o;
+                sum = sum * 31 + array.length;
+                for (Object element : array) {
+                    if (element != null) {
+                        stack.push(element);
+                    }
+                }
+            } else if (o instanceof byte[]) {
+                for (byte b : (byte[])o) {
+                    sum = sum * 31 + b;
+                }
+            } else if (o instanceof long[]) {
+                for (long l : (long[])o) {
+                    sum = sum * 31 + l;
+                }
+            } else {
+                throw new RuntimeException("Unexpected object in graph: " + o.getClass());
+            }
+        }
+        return sum * 31 + objects;
+    }
+
+    private static long usedAfter(Map<String, MemoryUsage> usage, String pool) {
+        MemoryUsage u = usage.get(pool);
+        return u == null ? 0 : u.getUsed();
+    }
+
+    public static void main(String[] args) throws Exception {
+        int iterations = args.length > 0 ? Integer.parseInt(args[0]) : 4;
+        long graphBytes = (args.length > 1 ? Long.parseLong(args[1]) : 16) * 1024 * 1024;
+
+        GarbageCollectorMXBean young = null;
+        for (java.lang.management.GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans()) {
+            if (bean.getName().equals("G1 Young Generation")) {
+                young = (GarbageCollectorMXBean)bean;
+            }
+        }
+        if (young == null) {
+            throw new RuntimeException("G1 Young Generation collector not found");
+        }
+
+        Random random = new Random(42);
+        long totalCopied = 0;
+        long totalMillis = 0;
+        for (int i = 0; i < iterations; i++) {
+            graph = null;
+            // Start from an empty eden so that the graph is all that survives.
+            WB.youngGC();
+            graph = buildGraph(graphBytes, random);
+            long expected = checksum(graph);
+
+            for (int gc = 0; gc < GCS_PER_GRAPH; gc++) {
+                WB.youngGC();
+
+                long actual = checksum(graph);
+                if (actual != expected) {
+                    throw new RuntimeException("Graph changed by young GC " + gc + " of iteration " + i +
+                                               ": checksum " + actual + ", expected " + expected);
+                }
+
+                GcInfo info = young.getLastGcInfo();
+                long copied = usedAfter(info.getMemoryUsageAfterGc(), "G1 Survivor Space") +
+                              Math.max(0, usedAfter(info.getMemoryUsageAfterGc(), "G1 Old Gen") -
+                                          usedAfter(info.getMemoryUsageBeforeGc(), "G1 Old Gen"));
+                System.out.println("Iteration " + i + ", GC " + gc + ": copied " + (copied / 1024) + "K in " +
+                                   info.getDuration() + "ms");
+                // Skip the first iteration as warmup.
+                if (i > 0) {
+                    totalCopied += copied;
+                    totalMillis += info.getDuration();
+                }
+            }
+        }
+        if (totalCopied > 0) {
+            double gb = totalCopied / (1024.0 * 1024.0 * 1024.0);
+            System.out.printf("Young GC pause time per GB copied: %.1fms%n", totalMillis / gb);
+        }
+    }
+}
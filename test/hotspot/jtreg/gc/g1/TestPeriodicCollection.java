@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPeriodicCollection
+ * @key gc
+ * @requires vm.gc.G1
+ * @summary Test that G1 runs periodic GCs while the application is idle and
+ *          that they return unused heap memory to the OS.
+ * @modules java.management
+ * @run main/othervm -XX:+UseG1GC -Xms16m -Xmx256m
+ *                   -XX:MinHeapFreeRatio=10 -XX:MaxHeapFreeRatio=30
+ *                   -XX:G1PeriodicGCInterval=500
+ *                   -Xlog:gc,gc+periodic=debug
+ *                   TestPeriodicCollection
+ * @run main/othervm -XX:+UseG1GC -Xms16m -Xmx256m
+ *                   -XX:MinHeapFreeRatio=10 -XX:MaxHeapFreeRatio=30
+ *                   -XX:G1PeriodicGCInterval=500 -XX:-G1PeriodicGCInvokesConcurrent
+ *                   -Xlog:gc,gc+periodic=debug
+ *                   TestPeriodicCollection
+ */
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryMXBean;
+
+public class TestPeriodicCollection {
+    // Much longer than G1PeriodicGCInterval, to allow for slow machines.
+    private static final long MAX_WAIT_MS = 30_000;
+
+    private static Object[] garbage;
+
+    private static long collectionCount() {
+        long count = 0;
+        for (GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans()) {
+            count += bean.getCollectionCount();
+        }
+        return count;
+    }
+
+    public static void main(String[] args) throws Exception {
+        MemoryMXBean memory = ManagementFactory.getMemoryMXBean();
+
+        // Grow the heap, then drop everything so that most of it is unused.
+        garbage = new Object[160];
+        for (int i = 0; i < garbage.length; i++) {
+            garbage[i] = new byte[1024 * 1024];
+        }
+        long committedBefore = memory.getHeapMemoryUsage().getCommitted();
+        garbage = null;
+        System.out.println("Committed after allocation: " + committedBefore / 1024 + "K");
+
+        // Stay idle; only periodic GCs can run now.
+        long countBefore = collectionCount();
+        long committed = committedBefore;
+        long start = System.currentTimeMillis();
+        while (System.currentTimeMillis() - start < MAX_WAIT_MS) {
+            Thread.sleep(250);
+            committed = memory.getHeapMemoryUsage().getCommitted();
+            if (collectionCount() > countBefore && committed < committedBefore / 2) {
+                break;
+            }
+        }
+        System.out.println("Committed after idling: " + committed / 1024 + "K");
+
+        if (collectionCount() == countBefore) {
+            throw new RuntimeException("No periodic GC while idle for " + MAX_WAIT_MS + "ms");
+        }
+        if (committed >= committedBefore / 2) {
+            throw new RuntimeException("Periodic GCs did not shrink the heap: committed " +
+                                       committed / 1024 + "K, was " + committedBefore / 1024 + "K");
+        }
+    }
+}
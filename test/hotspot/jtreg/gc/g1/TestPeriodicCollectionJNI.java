@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPeriodicCollectionJNI
+ * @key gc
+ * @requires vm.gc.G1
+ * @summary Test that periodic GCs do not stall for the GCLocker: the
+ *          requesting thread is not a Java thread.
+ * @run main/othervm/native -XX:+UseG1GC -Xmx64m
+ *                          -XX:G1PeriodicGCInterval=100
+ *                          -Xlog:gc,gc+periodic=debug
+ *                          TestPeriodicCollectionJNI
+ * @run main/othervm/native -XX:+UseG1GC -Xmx64m
+ *                          -XX:G1PeriodicGCInterval=100 -XX:-G1PeriodicGCInvokesConcurrent
+ *                          -Xlog:gc,gc+periodic=debug
+ *                          TestPeriodicCollectionJNI
+ */
+
+// Holds a JNI critical section while another thread allocates until it
+// needs a GC, so that the GCLocker is active and needs a GC.  Periodic GCs
+// are requested in the meantime and must neither crash nor wait.
+public class TestPeriodicCollectionJNI {
+    static {
+        System.loadLibrary("TestPeriodicCollectionJNI");
+    }
+
+    private static final long CRITICAL_MS = 2_000;
+
+    private static native boolean blockInNative(byte[] array);
+    private static native void unblock();
+
+    private static volatile Object sink;
+
+    public static void main(String[] args) throws Exception {
+        Thread allocator = new Thread() {
+            public void run() {
+                long start = System.currentTimeMillis();
+                // Allocating stalls while the critical section is held.
+                while (System.currentTimeMillis() - start < CRITICAL_MS) {
+                    sink = new byte[64 * 1024];
+                }
+            }
+        };
+        Thread unblocker = new Thread() {
+            public void run() {
+                try {
+                    Thread.sleep(CRITICAL_MS);
+                } catch (InterruptedException e) {
+                    throw new RuntimeException(e);
+                }
+                unblock();
+            }
+        };
+
+        allocator.start();
+        unblocker.start();
+        if (!blockInNative(new byte[1])) {
+            throw new RuntimeException("Could not enter the critical section");
+        }
+        unblocker.join();
+        allocator.join();
+
+        // Idle for several intervals to let periodic GCs run again.
+        Thread.sleep(1_000);
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#include <jni.h>
+
+static volatile int release_critical = 0;
+
+JNIEXPORT jboolean JNICALL Java_TestPeriodicCollectionJNI_blockInNative
+  (JNIEnv *env, jclass cls, jbyteArray array)
+{
+    jboolean retval = JNI_TRUE;
+    void *nativeArray = (*env)->GetPrimitiveArrayCritical(env, array, 0);
+
+    if (nativeArray == NULL) {
+        retval = JNI_FALSE;
+    }
+
+    // Stay in the critical section until unblock() is called.
+    while (!release_critical) /* empty */;
+
+    (*env)->ReleasePrimitiveArrayCritical(env, array, nativeArray, 0);
+    return retval;
+}
+
+JNIEXPORT void JNICALL Java_TestPeriodicCollectionJNI_unblock
+  (JNIEnv *env, jclass cls)
+{
+    release_critical = 1;
+}
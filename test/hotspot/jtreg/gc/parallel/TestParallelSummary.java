@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestParallelSummary
+ * @key gc
+ * @requires vm.gc.Parallel & vm.debug
+ * @summary Test that the parallel summary of ParallelOldGC produces the same
+ *          region data as a serial summary and a heap that verifies.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver TestParallelSummary
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestParallelSummary {
+    public static void main(String[] args) throws Exception {
+        // Lower the chunk threshold so that even a small old generation is
+        // summarized in parallel; debug builds then check the result against
+        // a serial summary.
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC", "-XX:+UseParallelOldGC",
+            "-XX:ParallelGCThreads=4", "-XX:-UseDynamicNumberOfGCThreads",
+            "-XX:ParallelOldSummaryMinChunkRegions=1",
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+VerifyAfterGC",
+            "-Xms64m", "-Xmx64m",
+            "-Xlog:gc+phases=debug",
+            GCTest.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Compaction Workers (ms):");
+    }
+
+    static class GCTest {
+        private static List<Object> live = new ArrayList<>();
+
+        public static void main(String[] args) {
+            // Keep every other array so that the old generation has live
+            // data to compact around the garbage.
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 2000; j++) {
+                    byte[] b = new byte[1024 + j % 512];
+                    if (j % 2 == 0) {
+                        live.add(b);
+                    }
+                }
+                System.gc();
+                live.subList(0, live.size() / 2).clear();
+            }
+            System.gc();
+        }
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestStringDeduplicationYoungGC
+ * @key gc
+ * @requires vm.gc.Parallel
+ * @summary Test that the Parallel collector deduplicates strings that reach
+ *          the deduplication age threshold in a survivor space.
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main/othervm -XX:+UseParallelGC -XX:-UseAdaptiveSizePolicy
+ *                   -Xms128m -Xmx128m -Xmn64m -XX:SurvivorRatio=2
+ *                   -XX:MaxTenuringThreshold=15
+ *                   -XX:+UseStringDeduplication
+ *                   -XX:StringDeduplicationAgeThreshold=3
+ *                   -Xlog:gc,gc+stringdedup=debug
+ *                   TestStringDeduplicationYoungGC
+ */
+
+/*
+ * @test TestStringDeduplicationYoungGCSerial
+ * @key gc
+ * @requires vm.gc.Serial
+ * @summary Test that the Serial collector deduplicates strings that reach
+ *          the deduplication age threshold in a survivor space.
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main/othervm -XX:+UseSerialGC
+ *                   -Xms128m -Xmx128m -Xmn64m -XX:SurvivorRatio=2
+ *                   -XX:MaxTenuringThreshold=15
+ *                   -XX:+UseStringDeduplication
+ *                   -XX:StringDeduplicationAgeThreshold=3
+ *                   -Xlog:gc,gc+stringdedup=debug
+ *                   TestStringDeduplicationYoungGC
+ */
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.lang.reflect.Field;
+import java.util.IdentityHashMap;
+
+import jdk.internal.misc.Unsafe;
+
+// Keeps groups of equal but distinct strings alive in the young generation
+// and runs fewer young GCs than the tenuring threshold, so the strings only
+// become deduplication candidates by reaching the age threshold in a
+// survivor space.  Then checks that the strings in each group share their
+// value array, and that they survive a full GC intact.
+public class TestStringDeduplicationYoungGC {
+    private static final Unsafe UNSAFE = Unsafe.getUnsafe();
+    private static final long VALUE_OFFSET;
+
+    private static final int GROUPS = 16;
+    private static final int STRINGS_PER_GROUP = 64;
+    // Stays below MaxTenuringThreshold, so no string is promoted.
+    private static final int MAX_YOUNG_GCS = 10;
+
+    static {
+        try {
+            Field field = String.class.getDeclaredField("value");
+            VALUE_OFFSET = UNSAFE.objectFieldOffset(field);
+        } catch (NoSuchFieldException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+    }
+
+    private static volatile Object sink;
+
+    private static Object getValue(String s) {
+        return UNSAFE.getObject(s, VALUE_OFFSET);
+    }
+
+    private static String groupContent(int group) {
+        return "TestStringDeduplicationYoungGC-" + group + "-" + Long.toHexString(group * 0x9E3779B97F4A7C15L);
+    }
+
+    private static GarbageCollectorMXBean youngCollector() {
+        for (GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans()) {
+            String name = bean.getName();
+            if (name.equals("PS Scavenge") || name.equals("Copy")) {
+                return bean;
+            }
+        }
+        throw new RuntimeException("No young collector found");
+    }
+
+    // Allocates garbage until at least one more young GC has happened.
+    private static void youngGC(GarbageCollectorMXBean young) {
+        long count = young.getCollectionCount();
+        while (young.getCollectionCount() == count) {
+            for (int i = 0; i < 1024; i++) {
+                sink = new byte[1024];
+            }
+        }
+        sink = null;
+    }
+
+    private static int distinctValues(String[][] strings) {
+        int distinct = 0;
+        for (String[] group : strings) {
+            IdentityHashMap<Object, Object> values = new IdentityHashMap<>();
+            for (String s : group) {
+                values.put(getValue(s), s);
+            }
+            distinct += values.size();
+        }
+        return distinct;
+    }
+
+    private static void verifyContents(String[][] strings) {
+        for (int g = 0; g < strings.length; g++) {
+            String expected = groupContent(g);
+            for (String s : strings[g]) {
+                if (!s.equals(expected)) {
+                    throw new RuntimeException("String changed: \"" + s + "\", expected \"" + expected + "\"");
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        String[][] strings = new String[GROUPS][STRINGS_PER_GROUP];
+        for (int g = 0; g < GROUPS; g++) {
+            char[] chars = groupContent(g).toCharArray();
+            for (int i = 0; i < STRINGS_PER_GROUP; i++) {
+                strings[g][i] = new String(chars);
+            }
+        }
+
+        int before = distinctValues(strings);
+        System.out.println("Distinct values before: " + before);
+        if (before != GROUPS * STRINGS_PER_GROUP) {
+            throw new RuntimeException("Strings should not share values yet: " + before);
+        }
+
+        GarbageCollectorMXBean young = youngCollector();
+        int distinct = before;
+        for (int i = 0; i < MAX_YOUNG_GCS && distinct != GROUPS; i++) {
+            youngGC(young);
+            // Give the deduplication thread time to process the queue.
+            for (int wait = 0; wait < 20 && distinct != GROUPS; wait++) {
+                Thread.sleep(50);
+                distinct = distinctValues(strings);
+            }
+            System.out.println("Distinct values after young GC " + (i + 1) + ": " + distinct);
+        }
+
+        if (distinct != GROUPS) {
+            throw new RuntimeException("Strings in the survivor spaces were not deduplicated: " +
+                                       distinct + " distinct values, expected " + GROUPS);
+        }
+        verifyContents(strings);
+
+        // The deduplicated strings and the table entries must survive a full GC.
+        System.gc();
+        verifyContents(strings);
+        if (distinctValues(strings) != GROUPS) {
+            throw new RuntimeException("Deduplicated strings lost their shared values");
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, Google and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check stack traces of exceptions thrown from deep and shallow
+ *          stacks and time the throw path.
+ * @run main/othervm ThrowPathBenchmark
+ * @run main/othervm -XX:MaxJavaStackTraceDepth=10 ThrowPathBenchmark 10
+ */
+
+/*
+ * The throw path is dominated by java_lang_Throwable::fill_in_stack_trace.
+ * Run with a larger iteration count to use this as a benchmark:
+ *
+ *   java ThrowPathBenchmark 0 2000000
+ */
+public class ThrowPathBenchmark {
+
+    static class ParseException extends Exception {
+        ParseException(String msg) {
+            super(msg);
+        }
+    }
+
+    static volatile Object sink;
+
+    static void recurse(int depth) throws ParseException {
+        if (depth == 0) {
+            throw new ParseException("at bottom");
+        }
+        recurse(depth - 1);
+    }
+
+    static ParseException throwAt(int depth) {
+        try {
+            recurse(depth);
+        } catch (ParseException e) {
+            return e;
+        }
+        throw new RuntimeException("no exception thrown");
+    }
+
+    static void check(int depth, int maxDepth) {
+        ParseException e = throwAt(depth);
+        StackTraceElement[] trace = e.getStackTrace();
+
+        // recurse() frames, throwAt(), check(), main() and possibly more
+        int expected = depth + 4;
+        if (maxDepth > 0 && expected > maxDepth) {
+            if (trace.length != maxDepth) {
+                throw new RuntimeException("Expected " + maxDepth + " frames, got " + trace.length);
+            }
+        } else if (trace.length < expected) {
+            throw new RuntimeException("Expected at least " + expected + " frames, got " + trace.length);
+        }
+
+        int recursions = Math.min(depth + 1, trace.length);
+        for (int i = 0; i < recursions; i++) {
+            if (!trace[i].getMethodName().equals("recurse")) {
+                throw new RuntimeException("Frame " + i + " is " + trace[i] + " at depth " + depth);
+            }
+        }
+        if (recursions < trace.length && !trace[recursions].getMethodName().equals("throwAt")) {
+            throw new RuntimeException("Frame " + recursions + " is " + trace[recursions]);
+        }
+    }
+
+    static long time(int depth, int iterations) {
+        long start = System.nanoTime();
+        for (int i = 0; i < iterations; i++) {
+            sink = throwAt(depth);
+        }
+        return System.nanoTime() - start;
+    }
+
+    public static void main(String[] args) {
+        int maxDepth = args.length > 0 ? Integer.parseInt(args[0]) : 1024;
+        int iterations = args.length > 1 ? Integer.parseInt(args[1]) : 20000;
+
+        // Cross the old 32-frame chunk boundaries on both sides
+        int[] depths = { 0, 1, 27, 28, 29, 31, 32, 33, 63, 64, 65, 100, 500 };
+        for (int depth : depths) {
+            check(depth, maxDepth);
+        }
+
+        for (int depth : new int[] { 1, 10, 50, 200 }) {
+            time(depth, iterations);  // warm up
+            long ns = time(depth, iterations);
+            System.out.printf("depth %4d: %8.1f ns/throw%n", depth, (double) ns / iterations);
+        }
+    }
+}